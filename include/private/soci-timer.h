@@ -0,0 +1,26 @@
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef SOCI_PRIVATE_SOCI_TIMER_H_INCLUDED
+#define SOCI_PRIVATE_SOCI_TIMER_H_INCLUDED
+
+#include "soci/soci-platform.h"
+
+namespace soci
+{
+
+namespace details
+{
+
+// Return the current value of a monotonic clock in microseconds. This value
+// is only meaningful for computing the time elapsed between two calls.
+SOCI_DECL long long get_monotonic_microseconds();
+
+} // namespace details
+
+} // namespace soci
+
+#endif // SOCI_PRIVATE_SOCI_TIMER_H_INCLUDED
@@ -10,6 +10,7 @@
 
 #include "soci/soci-platform.h"
 
+#include <cstddef>
 #include <map>
 #include <string>
 
@@ -54,6 +55,12 @@ public:
         return true;
     }
 
+    // Return true if the option with the given name was found and fill the
+    // provided parameter with its value, which must be a non-negative integer
+    // not greater than maxValue. Throws soci_error if this is not the case.
+    bool get_size_option(const char * name, std::size_t & value,
+        std::size_t maxValue = static_cast<std::size_t>(-1)) const;
+
 private:
     // The backend and connection string specified in our ctor.
     backend_factory const * factory_;
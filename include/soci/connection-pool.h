@@ -15,12 +15,20 @@
 namespace soci
 {
 
+class connection_parameters;
 class session;
 
 class SOCI_DECL connection_pool
 {
 public:
     explicit connection_pool(std::size_t size);
+
+    // Create an elastic pool opening its sessions using the given parameters:
+    // minSize of them are opened immediately, in parallel, and more, up to
+    // maxSize, only when all the open ones are in use.
+    connection_pool(connection_parameters const & parameters,
+        std::size_t minSize, std::size_t maxSize);
+
     ~connection_pool();
 
     session & at(std::size_t pos);
@@ -29,6 +37,27 @@ public:
     bool try_lease(std::size_t & pos, int timeout);
     void give_back(std::size_t pos);
 
+    // Close the sessions of an elastic pool not used for longer than the
+    // given number of seconds, keeping at least its minimal number of them
+    // open. This is done by a background thread started by the first call to
+    // this function. 0, which is the default, disables closing the idle
+    // sessions.
+    void set_idle_timeout(int seconds);
+
+    // Close the free sessions of an elastic pool not used for at least the
+    // given number of seconds right now, keeping at least its minimal number
+    // of them open, and return the number of the closed sessions. In
+    // particular, 0 closes all the sessions not in use above this minimum.
+    std::size_t close_idle_sessions(int seconds);
+
+    // Check that the session is still connected before leasing it and try to
+    // reconnect it if it's not. This is disabled by default.
+    void set_validate_on_lease(bool validate);
+
+    // Return the number of sessions in the pool, i.e. the number of the
+    // currently open ones for an elastic pool.
+    std::size_t get_size() const;
+
 private:
     struct connection_pool_impl;
     connection_pool_impl * pimpl_;
@@ -222,6 +222,10 @@ struct SOCI_DB2_DECL db2_statement_backend : details::statement_backend
     bool hasVectorUseElements;
     SQLUINTEGER numRowsFetched;
     details::db2::binding_method use_binding_method_;
+
+    // Number of rows fetched at once as set in the statement attributes, or 0
+    // if the fetch attributes were not set yet.
+    int fetchArraySize;
 };
 
 struct db2_rowid_backend : details::rowid_backend
@@ -11,10 +11,41 @@
 #include "soci/soci-platform.h"
 
 #include <ostream>
+#include <string>
 
 namespace soci
 {
 
+// Phases of the query execution reported to logger_impl::end_query_phase().
+enum query_phase
+{
+    qp_prepare,     // preparing the statement
+    qp_execute,     // executing it, including fetching the first rows
+    qp_fetch        // fetching more rows
+};
+
+// Information about a finished phase of the query execution.
+struct query_phase_info
+{
+    query_phase_info()
+        : phase_(qp_execute), duration_(0), rows_(-1), failed_(false)
+    {
+    }
+
+    query_phase phase_;
+
+    // Duration of the phase in microseconds.
+    long long duration_;
+
+    // Number of rows fetched by the statements with into elements or affected
+    // by the other ones, -1 if unknown (always the case for qp_prepare).
+    long long rows_;
+
+    // True if the phase failed, the error message is given by error_ then.
+    bool failed_;
+    std::string error_;
+};
+
 // Allows to customize the logging of database operations performed by SOCI.
 //
 // To do it, derive your own class from logger_impl and override its pure
@@ -30,6 +61,16 @@ public:
     // Called to indicate that a new query is about to be executed.
     virtual void start_query(std::string const & query) = 0;
 
+    // Override to return true to get end_query_phase() called. As measuring
+    // the duration of the query phases has a small cost, it is not done at
+    // all by default.
+    virtual bool wants_query_phases() const { return false; }
+
+    // Called after each phase of the execution of the given query if
+    // wants_query_phases() returns true, even if the phase failed.
+    virtual void end_query_phase(std::string const & query,
+        query_phase_info const & info);
+
     logger_impl * clone() const;
 
     // These methods are for compatibility only as they're used to implement
@@ -68,6 +109,13 @@ public:
 
     void start_query(std::string const & query) { m_impl->start_query(query); }
 
+    bool wants_query_phases() const { return m_impl->wants_query_phases(); }
+    void end_query_phase(std::string const & query,
+        query_phase_info const & info)
+    {
+        m_impl->end_query_phase(query, info);
+    }
+
     // Methods used for the implementation of session basic logging support.
     void set_stream(std::ostream * s) { m_impl->set_stream(s); }
     std::ostream * get_stream() const { return m_impl->get_stream(); }
@@ -87,6 +87,9 @@ struct mysql_vector_into_type_backend : details::vector_into_type_backend
     void *data_;
     details::exchange_type type_;
     int position_;
+
+private:
+    void post_fetch_prepared(indicator *ind);
 };
 
 struct mysql_standard_use_type_backend : details::standard_use_type_backend
@@ -111,6 +114,10 @@ struct mysql_standard_use_type_backend : details::standard_use_type_backend
     int position_;
     std::string name_;
     char *buf_;
+
+    // used instead of buf_ with server-side prepared statements
+    MYSQL_BIND bind_;
+    MYSQL_TIME time_;
 };
 
 struct mysql_vector_use_type_backend : details::vector_use_type_backend
@@ -136,12 +143,17 @@ struct mysql_vector_use_type_backend : details::vector_use_type_backend
     int position_;
     std::string name_;
     std::vector<char *> buffers_;
+
+    // used instead of buffers_ with server-side prepared statements
+    std::vector<MYSQL_BIND> binds_;
+    std::vector<MYSQL_TIME> times_;
 };
 
 struct mysql_session_backend;
 struct mysql_statement_backend : details::statement_backend
 {
     mysql_statement_backend(mysql_session_backend &session);
+    ~mysql_statement_backend() SOCI_OVERRIDE;
 
     void alloc() SOCI_OVERRIDE;
     void clean_up() SOCI_OVERRIDE;
@@ -161,15 +173,32 @@ struct mysql_statement_backend : details::statement_backend
     void describe_column(int colNum, data_type &dtype,
         std::string &columnName) SOCI_OVERRIDE;
 
+    bool supports_reuse() const SOCI_OVERRIDE { return true; }
+    void reset_for_reuse() SOCI_OVERRIDE;
+
     mysql_standard_into_type_backend * make_into_type_backend() SOCI_OVERRIDE;
     mysql_standard_use_type_backend * make_use_type_backend() SOCI_OVERRIDE;
     mysql_vector_into_type_backend * make_vector_into_type_backend() SOCI_OVERRIDE;
     mysql_vector_use_type_backend * make_vector_use_type_backend() SOCI_OVERRIDE;
 
+    // Used with server-side prepared statements only: make the given row of
+    // the stored result current, so that its columns can be retrieved with
+    // mysql_stmt_fetch_column().
+    void fetch_prepared_row(int row);
+
+    // Used without server-side prepared statements only: return the given
+    // row of the current fetch batch and fill in the lengths of its columns.
+    MYSQL_ROW get_row(int row, unsigned long *& lengths);
+
     mysql_session_backend &session_;
 
     MYSQL_RES *result_;
 
+    // Server-side prepared statement handle, NULL unless the session was
+    // opened with "prepared_statements=1" and the server could prepare
+    // the query. When it is NULL, use values are spliced into the query text.
+    MYSQL_STMT *stmt_;
+
     // The query is split into chunks, separated by the named parameters;
     // e.g. for "SELECT id FROM ttt WHERE name = :foo AND gender = :bar"
     // we will have query chunks "SELECT id FROM ttt WHERE name = ",
@@ -190,6 +219,19 @@ struct mysql_statement_backend : details::statement_backend
     // random access to rows, since mysql_data_seek() is expensive.
     std::vector<MYSQL_ROW_OFFSET> resultRowOffsets_;
 
+    // True if result_ was obtained with mysql_use_result(): the rows are then
+    // read from the server by fetch(), one batch at a time, and kept in
+    // streamedRows_ and streamedLengths_ (numberOfRows_ is the size of the
+    // current batch and currentRow_ is always 0 in this case). The values
+    // point directly to the row returned by mysql_fetch_row() for single row
+    // batches and are copied to streamedData_ for the bigger ones, as each
+    // call to mysql_fetch_row() invalidates the previously returned row.
+    bool streamed_;
+    std::vector<char *> streamedRows_;
+    std::vector<unsigned long> streamedLengths_;
+    std::vector<std::size_t> streamedOffsets_;
+    std::vector<char> streamedData_;
+
     bool hasIntoElements_;
     bool hasVectorIntoElements_;
     bool hasUseElements_;
@@ -203,6 +245,64 @@ struct mysql_statement_backend : details::statement_backend
 
     typedef std::map<std::string, char **> UseByNameBuffersMap;
     UseByNameBuffersMap useByNameBuffers_;
+
+    // the same as above, but for the server-side prepared statements
+
+    typedef std::map<int, MYSQL_BIND *> UseByPosBindsMap;
+    UseByPosBindsMap useByPosBinds_;
+
+    typedef std::map<std::string, MYSQL_BIND *> UseByNameBindsMap;
+    UseByNameBindsMap useByNameBinds_;
+
+    std::vector<MYSQL_BIND> paramBinds_;
+
+    // Result binds only used to retrieve the null flags and the lengths of
+    // the columns, the values are fetched by the into elements themselves
+    // directly into their own buffers using mysql_stmt_fetch_column().
+    std::vector<MYSQL_BIND> resultBinds_;
+
+    union result_value
+    {
+        long long ll;
+        double d;
+        MYSQL_TIME t;
+    };
+    std::vector<result_value> resultValues_;
+
+    int fetchedRow_;         // row currently fetched into resultBinds_
+    int batchRow_;           // first row of the current fetch batch and
+    MYSQL_ROW_OFFSET batchOffset_; // its offset, to rewind to it cheaply
+
+    // For "INSERT ... VALUES (...)" queries, the position of the opening
+    // parenthesis of the values tuple in the first query chunk and of the
+    // closing one in the last chunk, allowing bulk operations to insert many
+    // rows at once. Both are npos for all the other queries.
+    std::string::size_type valuesBegin_;
+    std::string::size_type valuesEnd_;
+
+    // Prepared statement inserting multiRowStmtRows_ rows at once, used for
+    // the bulk operations with server-side prepared statements.
+    MYSQL_STMT *multiRowStmt_;
+    int multiRowStmtRows_;
+    std::vector<MYSQL_BIND> multiRowBinds_;
+
+private:
+    exec_fetch_result execute_prepared(int number);
+    exec_fetch_result fetch_streamed(int number);
+
+    void get_param_values(int row, std::vector<char *> & paramValues);
+    void get_param_binds(int row, std::vector<MYSQL_BIND> & paramBinds);
+    void append_values_tuple(std::string & query,
+        std::vector<char *> const & paramValues) const;
+
+    void execute_bulk_query(std::string const & query,
+        long long & rowsAffected);
+    void execute_multi_row(int numberOfRows);
+
+    MYSQL_STMT * prepare_multi_row(int numberOfRows);
+    void execute_multi_row_stmt(MYSQL_STMT *stmt, int firstRow,
+        int numberOfRows, long long & rowsAffected);
+    int execute_prepared_multi_row(int numberOfRows, long long & rowsAffected);
 };
 
 struct mysql_rowid_backend : details::rowid_backend
@@ -239,6 +339,8 @@ struct mysql_session_backend : details::session_backend
     void commit() SOCI_OVERRIDE;
     void rollback() SOCI_OVERRIDE;
 
+    bool is_connected() SOCI_OVERRIDE;
+
     bool get_last_insert_id(session&, std::string const&, long long&) SOCI_OVERRIDE;
 
     // Note that MySQL supports both "SELECT 2+2" and "SELECT 2+2 FROM DUAL"
@@ -253,7 +355,21 @@ struct mysql_session_backend : details::session_backend
     mysql_rowid_backend * make_rowid_backend() SOCI_OVERRIDE;
     mysql_blob_backend * make_blob_backend() SOCI_OVERRIDE;
 
+    // Return the max_allowed_packet server variable, retrieving it on the
+    // first call.
+    std::size_t get_max_allowed_packet();
+
     MYSQL *conn_;
+
+    // Use the mysql_stmt_* API ("prepared_statements=1" in the connect string)
+    bool prepared_statements_;
+
+    // Stream the results of the queries from the server using
+    // mysql_use_result() instead of storing them entirely on the client
+    // ("use_result=1" in the connect string)
+    bool use_result_;
+
+    std::size_t max_allowed_packet_; // 0 if not retrieved yet
 };
 
 
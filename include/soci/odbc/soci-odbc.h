@@ -59,6 +59,18 @@ namespace details
 // string form as all options are strings currently).
 extern SOCI_ODBC_DECL char const * odbc_option_driver_complete;
 
+// Option specifying the size of the buffer used for each value of the string
+// columns longer than it, or of unknown length, when fetching them into
+// vectors. The values not fitting into this buffer are retrieved separately
+// using SQLGetData(), if the driver supports it. Set this option to "0" to
+// always use the buffers big enough for the maximal length of the column.
+extern SOCI_ODBC_DECL char const * odbc_option_long_column_buffer_size;
+
+// Option specifying the maximal total size, in bytes, of the buffers used for
+// fetching string columns into vectors, which limits the number of rows
+// fetched at once. Unlimited by default, or if "0".
+extern SOCI_ODBC_DECL char const * odbc_option_fetch_buffer_limit;
+
 struct odbc_statement_backend;
 
 // Helper of into and use backends.
@@ -123,7 +135,8 @@ struct odbc_vector_into_type_backend : details::vector_into_type_backend,
 {
     odbc_vector_into_type_backend(odbc_statement_backend &st)
         : odbc_standard_type_backend_base(st), indHolders_(NULL),
-          data_(NULL), buf_(NULL) {}
+          data_(NULL), buf_(NULL), bufRows_(0), colSize_(0), position_(0),
+          longColumn_(false) {}
 
     void define_by_pos(int &position,
         void *data, details::exchange_type type) SOCI_OVERRIDE;
@@ -143,14 +156,29 @@ struct odbc_vector_into_type_backend : details::vector_into_type_backend,
     // IBM DB2 driver is not compliant to ODBC spec for indicators in 64bit
     // SQLLEN is still defined 32bit (int) but spec requires 64bit (long)
     inline SQLLEN get_sqllen_from_vector_at(std::size_t idx) const;
+    inline void set_sqllen_from_vector_at(const std::size_t idx, const SQLLEN val);
+
+    // Allocate the buffer for the given number of rows, if not done yet, and
+    // bind it. Only used for strings, whose buffers are allocated when
+    // fetching as their size depends on the number of rows fetched at once.
+    void bind_buffer(std::size_t rows);
+
+    // Retrieve the entire value of a long column in the given row.
+    void get_long_column_data(std::size_t row, std::string &value);
 
     SQLLEN *indHolders_;
     std::vector<SQLLEN> indHolderVec_;
     void *data_;
     char *buf_;              // generic buffer
+    std::size_t bufRows_;    // number of rows buf_ was allocated for
     details::exchange_type type_;
     std::size_t colSize_;    // size of the string column (used for strings)
     SQLSMALLINT odbcType_;
+    int position_;
+
+    // True if the buffer is smaller than the column size and the longer
+    // values must be retrieved using get_long_column_data().
+    bool longColumn_;
 };
 
 struct odbc_standard_use_type_backend : details::standard_use_type_backend,
@@ -261,6 +289,11 @@ struct odbc_statement_backend : details::statement_backend
     // helper for defining into vector<string>
     std::size_t column_size(int position);
 
+    // Register a vector into element whose buffer must be bound before
+    // fetching, see odbc_vector_into_type_backend::bind_buffer().
+    void add_buffered_into(odbc_vector_into_type_backend *into);
+    void remove_buffered_into(odbc_vector_into_type_backend *into);
+
     odbc_standard_into_type_backend * make_into_type_backend() SOCI_OVERRIDE;
     odbc_standard_use_type_backend * make_use_type_backend() SOCI_OVERRIDE;
     odbc_vector_into_type_backend * make_vector_into_type_backend() SOCI_OVERRIDE;
@@ -275,9 +308,20 @@ struct odbc_statement_backend : details::statement_backend
 
     long long rowsAffected_; // number of rows affected by the last operation
 
+    // Number of rows fetched at once as set in the statement attributes, or 0
+    // if the fetch attributes were not set yet.
+    SQLULEN rowArraySize_;
+
     std::string query_;
     std::vector<std::string> names_; // list of names for named binds
 
+    std::vector<odbc_vector_into_type_backend *> bufferedIntos_;
+
+private:
+    // Bind the buffers of the buffered into elements and return the number
+    // of rows to fetch at once, which can be less than the requested number
+    // to respect the fetch buffer limit.
+    int bind_buffered_intos(int number);
 };
 
 struct odbc_rowid_backend : details::rowid_backend
@@ -314,6 +358,8 @@ struct odbc_session_backend : details::session_backend
     void commit() SOCI_OVERRIDE;
     void rollback() SOCI_OVERRIDE;
 
+    bool is_connected() SOCI_OVERRIDE;
+
     bool get_next_sequence_value(session & s,
         std::string const & sequence, long long & value) SOCI_OVERRIDE;
     bool get_last_insert_id(session & s,
@@ -351,13 +397,26 @@ struct odbc_session_backend : details::session_backend
     // Return full ODBC connection string.
     std::string get_connection_string() const { return connection_string_; }
 
+    // Check if SQLGetData() can be used for the bound columns, optionally
+    // also when fetching more than one row at once.
+    bool can_get_data_for_bound_columns(bool blockCursor) const;
+
     SQLHENV henv_;
     SQLHDBC hdbc_;
 
     std::string connection_string_;
 
+    // Values of odbc_option_long_column_buffer_size and
+    // odbc_option_fetch_buffer_limit options.
+    std::size_t longColumnBufferSize_;
+    std::size_t fetchBufferLimit_;
+
 private:
     mutable database_product product_;
+
+    // SQL_GETDATA_EXTENSIONS value, retrieved on demand.
+    mutable SQLUINTEGER getDataExtensions_;
+    mutable bool getDataExtensionsKnown_;
 };
 
 class SOCI_ODBC_DECL odbc_soci_error : public soci_error
@@ -531,6 +590,30 @@ inline SQLLEN odbc_vector_into_type_backend::get_sqllen_from_vector_at(std::size
     return indHolderVec_[idx];
 }
 
+inline void odbc_vector_into_type_backend::set_sqllen_from_vector_at(const std::size_t idx, const SQLLEN val)
+{
+    if (requires_noncompliant_32bit_sqllen())
+    {
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#elif defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wstrict-aliasing"
+#endif
+        reinterpret_cast<int*>(&indHolderVec_[0])[idx] = *reinterpret_cast<const int*>(&val);
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#elif defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+    }
+    else
+    {
+        indHolderVec_[idx] = val;
+    }
+}
+
 inline void odbc_vector_use_type_backend::set_sqllen_from_vector_at(const std::size_t idx, const SQLLEN val)
 {
     if (requires_noncompliant_32bit_sqllen())
@@ -36,6 +36,16 @@
 namespace soci
 {
 
+// Options which can be passed to the Oracle backend via connection_parameters
+// to configure prefetching for all statements of the session: the number of
+// rows and the amount of memory, in bytes, used for prefetching the rows, see
+// OCI_ATTR_PREFETCH_ROWS and OCI_ATTR_PREFETCH_MEMORY, and the amount of LOB
+// data prefetched together with the LOB locators, see
+// OCI_ATTR_DEFAULT_LOBPREFETCH_SIZE. OCI defaults are used if not specified.
+extern SOCI_ORACLE_DECL char const * oracle_option_prefetch_rows;
+extern SOCI_ORACLE_DECL char const * oracle_option_prefetch_memory;
+extern SOCI_ORACLE_DECL char const * oracle_option_lob_prefetch_size;
+
 class SOCI_ORACLE_DECL oracle_soci_error : public soci_error
 {
 public:
@@ -247,6 +257,16 @@ struct oracle_statement_backend : details::statement_backend
     // helper for defining into vector<string>
     std::size_t column_size(int position);
 
+    // Set the number of rows and the amount of memory used for prefetching
+    // the rows when executing and fetching this statement, overriding the
+    // session defaults.
+    void set_prefetch_rows(ub4 rows);
+    void set_prefetch_memory(ub4 bytes);
+
+    // Set the amount of LOB data prefetched together with the LOB locators
+    // selected by this statement, overriding the session default.
+    void set_lob_prefetch_size(ub4 size);
+
     oracle_standard_into_type_backend * make_into_type_backend() SOCI_OVERRIDE;
     oracle_standard_use_type_backend * make_use_type_backend() SOCI_OVERRIDE;
     oracle_vector_into_type_backend * make_vector_into_type_backend() SOCI_OVERRIDE;
@@ -259,6 +279,10 @@ struct oracle_statement_backend : details::statement_backend
     bool boundByName_;
     bool boundByPos_;
     bool noData_;
+
+    // LOB prefetch size for the LOB columns of this statement, or -1 to use
+    // the session default.
+    long lobPrefetchSize_;
 };
 
 struct oracle_rowid_backend : details::rowid_backend
@@ -445,6 +469,10 @@ struct oracle_session_backend : details::session_backend
 
     bool get_option_decimals_as_strings() { return decimals_as_strings_; }
 
+    // Set the default LOB prefetch size for all LOB locators fetched using
+    // this session. Requires Oracle 11.1 or later.
+    void set_default_lob_prefetch_size(ub4 size);
+
     // Return either SQLT_FLT or SQLT_BDOUBLE as the type to use when binding
     // values of C type "double" (the latter is preferable but might not be
     // always available).
@@ -456,6 +484,11 @@ struct oracle_session_backend : details::session_backend
     OCISvcCtx *svchp_;
     OCISession *usrhp_;
     bool decimals_as_strings_;
+
+    // Prefetch settings used for all new statements, or -1 to use the OCI
+    // defaults.
+    long prefetchRows_;
+    long prefetchMemory_;
 };
 
 struct oracle_backend_factory : backend_factory
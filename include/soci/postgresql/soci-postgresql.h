@@ -144,6 +144,13 @@ struct postgresql_standard_into_type_backend : details::standard_into_type_backe
     void * data_;
     details::exchange_type type_;
     int position_;
+
+private:
+    // Decode the value retrieved in binary format.
+    void post_fetch_binary(PGresult const * res, int row, int pos);
+
+    void set_rowid(unsigned long value);
+    void set_blob(unsigned long oid);
 };
 
 struct postgresql_vector_into_type_backend : details::vector_into_type_backend
@@ -180,12 +187,16 @@ struct postgresql_vector_into_type_backend : details::vector_into_type_backend
     std::size_t end_var_;
     bool user_ranges_;
     int position_;
+
+private:
+    // Decode the value retrieved in binary format into the i-th element.
+    void post_fetch_binary(PGresult const * res, int row, int pos, int i);
 };
 
 struct postgresql_standard_use_type_backend : details::standard_use_type_backend
 {
     postgresql_standard_use_type_backend(postgresql_statement_backend & st)
-        : statement_(st), position_(0), buf_(NULL) {}
+        : statement_(st), position_(0), buf_(NULL), length_(-1) {}
 
     void bind_by_pos(int & position,
         void * data, details::exchange_type type, bool readOnly) SOCI_OVERRIDE;
@@ -204,6 +215,7 @@ struct postgresql_standard_use_type_backend : details::standard_use_type_backend
     int position_;
     std::string name_;
     char * buf_;
+    int length_; // length of the value in binary format or -1 if it's text
 
 private:
     // Allocate buf_ of appropriate size and copy string data into it.
@@ -252,6 +264,7 @@ struct postgresql_vector_use_type_backend : details::vector_use_type_backend
     int position_;
     std::string name_;
     std::vector<char *> buffers_;
+    std::vector<int> lengths_; // same as postgresql_standard_use_type_backend::length_
 };
 
 struct postgresql_statement_backend : details::statement_backend
@@ -283,6 +296,11 @@ struct postgresql_statement_backend : details::statement_backend
     postgresql_vector_into_type_backend * make_vector_into_type_backend() SOCI_OVERRIDE;
     postgresql_vector_use_type_backend * make_vector_use_type_backend() SOCI_OVERRIDE;
 
+    bool supports_reuse() const SOCI_OVERRIDE { return true; }
+    void reset_for_reuse() SOCI_OVERRIDE;
+    void set_pipelined(bool pipelined) SOCI_OVERRIDE { pipelined_ = pipelined; }
+    bool can_reuse_described_columns() const SOCI_OVERRIDE;
+
     postgresql_session_backend & session_;
 
     bool single_row_mode_;
@@ -302,6 +320,10 @@ struct postgresql_statement_backend : details::statement_backend
     bool justDescribed_; // to optimize row description with immediately
                          // following actual statement execution
 
+    bool describing_; // true while executing the statement to describe it
+
+    bool pipelined_; // queue the executions even outside of session pipeline
+
     bool hasIntoElements_;
     bool hasVectorIntoElements_;
     bool hasUseElements_;
@@ -315,6 +337,45 @@ struct postgresql_statement_backend : details::statement_backend
 
     typedef std::map<std::string, char **> UseByNameBuffersMap;
     UseByNameBuffersMap useByNameBuffers_;
+
+    // lengths of the values in the buffers above, -1 for the text ones
+
+    typedef std::map<int, int *> UseByPosLengthsMap;
+    UseByPosLengthsMap useByPosLengths_;
+
+    typedef std::map<std::string, int *> UseByNameLengthsMap;
+    UseByNameLengthsMap useByNameLengths_;
+
+    // Types of the parameters of the prepared statement as determined by the
+    // server, only filled when using binary parameters.
+    std::vector<Oid> paramTypes_;
+
+    // Return the type of the parameter at the given position or with the
+    // given name if its values can be sent in binary format or 0 otherwise.
+    Oid get_binary_param_type(int position, std::string const & name) const;
+
+    // "COPY ... FROM STDIN" query used instead of the statement query for
+    // the bulk operations if it's a simple INSERT and bulk_copy_ option of
+    // the session is on, empty otherwise.
+    std::string copyQuery_;
+
+private:
+    // Get the values of all the parameters for the given row and their
+    // lengths, which are negative for the values in text format.
+    void get_param_values(int row, std::vector<char *> & paramValues,
+        std::vector<int> & paramLengths);
+
+    // Load all the rows using copyQuery_, return false if it couldn't be
+    // done and the statement must be executed for each row instead.
+    bool execute_copy(int numberOfRows);
+
+    // Return true if the executions of this statement should be queued in
+    // the session pipeline instead of waiting for their results.
+    bool use_pipeline(int numberOfExecutions) const;
+
+    // Queue a single execution of the statement in the session pipeline.
+    void send_pipelined(int nParams, char const * const * paramValues,
+        int const * paramLengths, int const * paramFormats);
 };
 
 struct postgresql_rowid_backend : details::rowid_backend
@@ -356,16 +417,44 @@ struct postgresql_blob_backend : details::blob_backend
 
     void trim(std::size_t newLen) SOCI_OVERRIDE;
 
+    // Open the large object with the given oid, closing the previously opened
+    // one, if any.
+    void open(unsigned long oid);
+
+    // Close the large object, if it's open.
+    void close();
+
+    // Create a new large object with the contents of the given client-side
+    // file and open it, returning its oid. The blob can then be used to store
+    // this oid in the database.
+    unsigned long import_file(std::string const & filename);
+
+    // Write the entire contents of the large object to the given client-side
+    // file.
+    void export_file(std::string const & filename);
+
     postgresql_session_backend & session_;
 
     unsigned long oid_; // oid of the large object
     int fd_;            // descriptor of the large object
+
+private:
+    // Move the current position to the given offset unless it's already there.
+    void seek(std::size_t offset);
+
+    // The current position of the descriptor and the length of the large
+    // object, as known on the client side to avoid round trips to the server,
+    // or -1 if unknown.
+    long long pos_;
+    long long len_;
 };
 
 struct postgresql_session_backend : details::session_backend
 {
     postgresql_session_backend(connection_parameters const & parameters,
-        bool single_row_mode);
+        bool single_row_mode, bool binary_results = false,
+        bool binary_params = false, bool bulk_copy = false,
+        bool pipeline_bulk = false);
 
     ~postgresql_session_backend() SOCI_OVERRIDE;
 
@@ -375,6 +464,8 @@ struct postgresql_session_backend : details::session_backend
     void commit() SOCI_OVERRIDE;
     void rollback() SOCI_OVERRIDE;
 
+    bool is_connected() SOCI_OVERRIDE;
+
     void deallocate_prepared_statement(const std::string & statementName);
 
     bool get_next_sequence_value(session & s,
@@ -392,8 +483,56 @@ struct postgresql_session_backend : details::session_backend
 
     std::string get_next_statement_name();
 
+    // Start queuing the executions of the statements without into elements
+    // instead of waiting for their results, see "Pipeline Mode" in the
+    // documentation. Requires libpq 14 or later.
+    void begin_pipeline() SOCI_OVERRIDE;
+
+    // Wait for the results of all the queued executions and stop queuing new
+    // ones. Returns the total number of rows affected by the queued
+    // statements and throws if any of them failed.
+    long long end_pipeline() SOCI_OVERRIDE;
+
+    // Wait for the results of all the queued executions, if any, without
+    // leaving the pipeline mode. This is done automatically before any
+    // operation which needs its result immediately.
+    long long sync_pipeline() SOCI_OVERRIDE;
+
+    // Used by the statements to account for a command queued in pipeline mode.
+    void pipeline_command_sent();
+
+    void consume_pipeline_results();
+
     int statementCount_;
     bool single_row_mode_;
+
+    // Request the results in binary format ("binaryresults=true" in the
+    // connect string) to avoid parsing them.
+    bool binary_results_;
+
+    // Send the parameters of the prepared statements in binary format
+    // ("binaryparams=true" in the connect string) to avoid formatting them.
+    bool binary_params_;
+
+    // Use COPY for the bulk inserts ("bulkcopy=true" in the connect string).
+    bool bulk_copy_;
+
+    // Pipeline the executions of the bulk operations ("pipeline=true" in the
+    // connect string).
+    bool pipeline_bulk_;
+
+    // True between begin_pipeline() and end_pipeline().
+    bool pipeline_;
+
+    // The number of commands queued and not consumed yet.
+    int pipelinePending_;
+
+    // The total number of rows affected by the consumed commands.
+    long long pipelineRowsAffected_;
+
+    // The first error which occurred in the pipeline, if any.
+    PGresult * pipelineError_;
+
     PGconn * conn_;
 };
 
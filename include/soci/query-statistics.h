@@ -0,0 +1,118 @@
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef SOCI_QUERY_STATISTICS_H_INCLUDED
+#define SOCI_QUERY_STATISTICS_H_INCLUDED
+
+#include "soci/soci-platform.h"
+#include "soci/logger.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace soci
+{
+
+// Statistics accumulated for all the queries with the same normalized text.
+struct query_statistics_entry
+{
+    query_statistics_entry()
+        : calls_(0), errors_(0), rows_(0), totalDuration_(0), maxDuration_(0)
+    {
+    }
+
+    // Normalized query text, see query_statistics::normalize_query().
+    std::string query_;
+
+    // Number of executions of the query.
+    unsigned long long calls_;
+
+    // Number of failed phases (preparations, executions or fetches).
+    unsigned long long errors_;
+
+    // Total number of rows fetched or affected by all executions.
+    long long rows_;
+
+    // Total time spent in all phases and the longest single phase, both in
+    // microseconds.
+    long long totalDuration_;
+    long long maxDuration_;
+};
+
+// Collects the statistics about the queries executed by one or more sessions.
+//
+// The statistics are gathered by query_statistics_logger objects, which can
+// be used with any number of sessions, including all sessions of a connection
+// pool, as long as this object outlives all of them. All methods of this
+// class can be called concurrently from multiple threads.
+class SOCI_DECL query_statistics
+{
+public:
+    query_statistics();
+    ~query_statistics();
+
+    // Account for the given finished query phase.
+    void add_query_phase(std::string const & query,
+        query_phase_info const & info);
+
+    // Return a copy of the statistics for all queries, sorted by their text.
+    std::vector<query_statistics_entry> get_snapshot() const;
+
+    // Return the number of distinct queries.
+    std::size_t get_size() const;
+
+    // Forget all the statistics collected so far.
+    void reset();
+
+    // Return the query with all literals replaced by "?" and all runs of
+    // whitespace replaced by a single space, so that the queries differing
+    // only in the values embedded into them are accounted together.
+    static std::string normalize_query(std::string const & query);
+
+private:
+    struct query_statistics_impl;
+    query_statistics_impl * pimpl_;
+
+    // Non-copyable
+    query_statistics(query_statistics const &);
+    query_statistics & operator=(query_statistics const &);
+};
+
+// Logger implementation updating the given statistics object.
+//
+// Notice that it doesn't log the queries anywhere, so it replaces the simple
+// logging done using session::set_log_stream().
+class SOCI_DECL query_statistics_logger : public logger_impl
+{
+public:
+    explicit query_statistics_logger(query_statistics & stats)
+        : stats_(stats)
+    {
+    }
+
+    void start_query(std::string const &) SOCI_OVERRIDE {}
+
+    bool wants_query_phases() const SOCI_OVERRIDE { return true; }
+
+    void end_query_phase(std::string const & query,
+        query_phase_info const & info) SOCI_OVERRIDE
+    {
+        stats_.add_query_phase(query, info);
+    }
+
+private:
+    logger_impl * do_clone() const SOCI_OVERRIDE
+    {
+        return new query_statistics_logger(stats_);
+    }
+
+    query_statistics & stats_;
+};
+
+} // namespace soci
+
+#endif // SOCI_QUERY_STATISTICS_H_INCLUDED
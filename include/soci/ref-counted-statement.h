@@ -54,8 +54,33 @@ public:
         }
     }
 
+    // strings are appended to the query as is and numbers are formatted
+    // directly into it, only the values of the other types use the stream
     template <typename T>
-    void accumulate(T const & t) { get_query_stream() << t; }
+    void accumulate(T const & t)
+    {
+        std::ostringstream & os = get_query_stream();
+        os.str(std::string());
+        os << t;
+        append_to_query(os.str());
+    }
+
+    void accumulate(std::string const & s) { append_to_query(s); }
+    void accumulate(char const * s) { append_to_query(s); }
+
+    void accumulate(short n) { append_to_query(static_cast<long long>(n)); }
+    void accumulate(unsigned short n)
+    { append_to_query(static_cast<unsigned long long>(n)); }
+    void accumulate(int n) { append_to_query(static_cast<long long>(n)); }
+    void accumulate(unsigned int n)
+    { append_to_query(static_cast<unsigned long long>(n)); }
+    void accumulate(long n) { append_to_query(static_cast<long long>(n)); }
+    void accumulate(unsigned long n)
+    { append_to_query(static_cast<unsigned long long>(n)); }
+    void accumulate(long long n) { append_to_query(n); }
+    void accumulate(unsigned long long n) { append_to_query(n); }
+    void accumulate(float d) { append_to_query(static_cast<double>(d)); }
+    void accumulate(double d) { append_to_query(d); }
 
     void set_tail(const std::string & tail) { tail_ = tail; }
     void set_need_comma(bool need_comma) { need_comma_ = need_comma; }
@@ -65,6 +90,11 @@ protected:
     // this function allows to break the circular dependenc
     // between session and this class
     std::ostringstream & get_query_stream();
+    void append_to_query(std::string const & s);
+    void append_to_query(char const * s);
+    void append_to_query(long long n);
+    void append_to_query(unsigned long long n);
+    void append_to_query(double d);
 
     int refCount_;
 
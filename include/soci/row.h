@@ -13,7 +13,6 @@
 #include "soci/type-conversion.h"
 // std
 #include <cstddef>
-#include <map>
 #include <string>
 #include <vector>
 
@@ -26,7 +25,7 @@ class SOCI_DECL column_properties
     // of the getters lazy in the future
 public:
 
-    std::string get_name() const { return name_; }
+    std::string const& get_name() const { return name_; }
     data_type get_data_type() const { return dataType_; }
 
     void set_name(std::string const& name) { name_ = name; }
@@ -51,11 +50,74 @@ public:
     indicator get_indicator(std::size_t pos) const;
     indicator get_indicator(std::string const& name) const;
 
+    // Reserve the storage for the given number of columns, this must be done
+    // before adding their values as the into elements refer to them.
+    void reserve(std::size_t columns);
+
+    // Add the value of the next column, of type T, and return the pointers to
+    // its storage and to the indicator, which remain valid until clean_up().
+    template <typename T>
+    void alloc_holder(T*& t, indicator*& ind)
+    {
+        if (holders_.size() == holders_.capacity() ||
+            strings_.size() == strings_.capacity())
+        {
+            throw soci_error("Row storage must be reserved before adding values.");
+        }
+
+        holders_.push_back(details::holder());
+        details::type_holder<T>::init(holders_.back(), strings_);
+
+        t = &details::type_holder<T>::value(holders_.back(), strings_);
+
+        indicators_.push_back(i_ok);
+        ind = &indicators_.back();
+    }
+
+    // Return the pointers to the storage of the existing value of the column
+    // at the given position, which must be of type T, and to its indicator.
+    // This is used to fill the values of a row which already has the right
+    // columns, see has_columns(), instead of adding them again.
     template <typename T>
-    inline void add_holder(T* t, indicator* ind)
+    void get_holder(std::size_t pos, T*& t, indicator*& ind)
     {
-        holders_.push_back(new details::type_holder<T>(t));
-        indicators_.push_back(ind);
+        details::holder& h = holders_.at(pos);
+        if (details::type_holder<T>::matches(h) == false)
+        {
+            throw std::bad_cast();
+        }
+
+        t = &details::type_holder<T>::value(h, strings_);
+        ind = &indicators_[pos];
+    }
+
+    // Return true if the row has exactly the given columns, with the same
+    // names and types and in the same order.
+    bool has_columns(std::vector<details::column_description> const& columns) const;
+
+    // Add the value of the next column taking ownership of the given
+    // pointers. The value and the indicator are copied into the row storage,
+    // so, unlike with alloc_holder(), they must be set before calling this
+    // function. The storage doesn't need to be reserved, but adding a value
+    // in this way invalidates the pointers returned by alloc_holder().
+    template <typename T>
+    void add_holder(T* t, indicator* ind)
+    {
+        cxx_details::auto_ptr<T> const value(t);
+        cxx_details::auto_ptr<indicator> const valueInd(ind);
+
+        if (holders_.size() == holders_.capacity() ||
+            strings_.size() == strings_.capacity())
+        {
+            reserve(2 * holders_.size() + 1);
+        }
+
+        T * storage = NULL;
+        indicator * storageInd = NULL;
+        alloc_holder(storage, storageInd);
+
+        *storage = *value;
+        *storageInd = *valueInd;
     }
 
     column_properties const& get_properties(std::size_t pos) const;
@@ -65,17 +127,17 @@ public:
     T get(std::size_t pos) const
     {
         typedef typename type_conversion<T>::base_type base_type;
-        base_type const& baseVal = holders_.at(pos)->get<base_type>();
+        base_type const& baseVal = get_value<base_type>(pos);
 
         T ret;
-        type_conversion<T>::from_base(baseVal, *indicators_.at(pos), ret);
+        type_conversion<T>::from_base(baseVal, indicators_.at(pos), ret);
         return ret;
     }
 
     template <typename T>
     T get(std::size_t pos, T const &nullValue) const
     {
-        if (i_null == *indicators_.at(pos))
+        if (i_null == indicators_.at(pos))
         {
             return nullValue;
         }
@@ -95,7 +157,7 @@ public:
     {
         std::size_t const pos = find_column(name);
 
-        if (i_null == *indicators_[pos])
+        if (i_null == indicators_[pos])
         {
             return nullValue;
         }
@@ -125,11 +187,33 @@ private:
     SOCI_NOT_COPYABLE(row)
 
     std::size_t find_column(std::string const& name) const;
+    void add_to_index(std::size_t pos);
 
+    template <typename T>
+    T const& get_value(std::size_t pos) const
+    {
+        details::holder const& h = holders_.at(pos);
+        if (details::type_holder<T>::matches(h) == false)
+        {
+            throw std::bad_cast();
+        }
+
+        // the value is not modified, type_holder just doesn't distinguish
+        // between const and non-const access
+        return details::type_holder<T>::value(
+            const_cast<details::holder&>(h),
+            const_cast<std::vector<std::string>&>(strings_));
+    }
+
+    // values of all columns and their indicators, stored contiguously
     std::vector<column_properties> columns_;
-    std::vector<details::holder*> holders_;
-    std::vector<indicator*> indicators_;
-    std::map<std::string, std::size_t> index_;
+    std::vector<details::holder> holders_;
+    std::vector<std::string> strings_;
+    std::vector<indicator> indicators_;
+
+    // open addressing hash table of column positions (plus 1, so that 0
+    // means an empty slot) indexed by the hash of column names
+    std::vector<std::size_t> index_;
 
     bool uppercaseColumnNames_;
     mutable std::size_t currentPos_;
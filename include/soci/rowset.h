@@ -9,7 +9,12 @@
 #define SOCI_ROWSET_H_INCLUDED
 
 #include "soci/soci-platform.h"
+#include "soci/exchange-traits.h"
+#include "soci/session.h"
 #include "soci/statement.h"
+#ifdef SOCI_HAVE_BOOST
+#include <boost/fusion/support/is_sequence.hpp>
+#endif // SOCI_HAVE_BOOST
 // std
 #include <iterator>
 #include <memory>
@@ -17,6 +22,28 @@
 namespace soci
 {
 
+class row;
+class values;
+
+namespace details
+{
+
+//
+// Rows fetched in bulk by rowset and returned one by one to its iterator.
+//
+template <typename T>
+class rowset_buffer
+{
+public:
+    virtual ~rowset_buffer() {}
+
+    // Return the next row, fetching more of them if necessary, or NULL if
+    // there are no more rows.
+    virtual T * next() = 0;
+};
+
+} // namespace details
+
 //
 // rowset iterator of input category.
 //
@@ -36,16 +63,22 @@ public:
     // Constructors
 
     rowset_iterator()
-        : st_(0), define_(0)
+        : st_(0), define_(0), buffer_(0)
     {}
 
     rowset_iterator(statement & st, T & define)
-        : st_(&st), define_(&define)
+        : st_(&st), define_(&define), buffer_(0)
     {
         // Fetch first row to properly initialize iterator
         ++(*this);
     }
 
+    rowset_iterator(statement & st, details::rowset_buffer<T> & buffer)
+        : st_(&st), define_(0), buffer_(&buffer)
+    {
+        ++(*this);
+    }
+
     // Access operators
 
     reference operator*() const
@@ -64,7 +97,16 @@ public:
     {
         // Fetch next row from dataset
 
-        if (st_->fetch() == false)
+        if (buffer_ != 0)
+        {
+            define_ = buffer_->next();
+            if (define_ == 0)
+            {
+                st_ = 0;
+                buffer_ = 0;
+            }
+        }
+        else if (st_->fetch() == false)
         {
             // Set iterator to non-derefencable state (pass-the-end)
             st_ = 0;
@@ -85,7 +127,7 @@ public:
 
     bool operator==(rowset_iterator const & rhs) const
     {
-        return (st_== rhs.st_ && define_ == rhs.define_);
+        return (st_== rhs.st_ && define_ == rhs.define_ && buffer_ == rhs.buffer_);
     }
 
     bool operator!=(rowset_iterator const & rhs) const
@@ -97,12 +139,237 @@ private:
 
     statement * st_;
     T * define_;
+    details::rowset_buffer<T> * buffer_;
 
 }; // class rowset_iterator
 
 namespace details
 {
 
+//
+// Whether rows of type T can be fetched in bulk, i.e. into std::vector<T>.
+//
+template <typename T, typename TypeFamily>
+struct rowset_bulk_fetch_family_traits;
+
+template <typename T>
+struct rowset_is_sequence
+{
+#ifdef SOCI_HAVE_BOOST
+    enum { value = boost::fusion::traits::is_sequence<T>::value };
+#else
+    enum { value = false };
+#endif // SOCI_HAVE_BOOST
+};
+
+template <typename T, bool IsSequence = rowset_is_sequence<T>::value>
+struct rowset_bulk_fetch_traits
+{
+    enum
+    {
+        value = rowset_bulk_fetch_family_traits<T,
+            typename exchange_traits<T>::type_family>::value
+    };
+};
+
+// fusion sequences are exchanged element by element
+template <typename T>
+struct rowset_bulk_fetch_traits<T, true>
+{
+    enum { value = false };
+};
+
+// dynamic rows are fetched in bulk by the statement itself, see
+// rowset_row_buffer below
+template <>
+struct rowset_bulk_fetch_traits<row, false>
+{
+    enum { value = true };
+};
+
+// values are described anew for each row
+template <>
+struct rowset_bulk_fetch_traits<values, false>
+{
+    enum { value = false };
+};
+
+template <typename T>
+struct rowset_bulk_fetch_family_traits<T, basic_type_tag>
+{
+    enum
+    {
+        value = static_cast<int>(exchange_traits<T>::x_type) == x_char ||
+            static_cast<int>(exchange_traits<T>::x_type) == x_stdstring ||
+            static_cast<int>(exchange_traits<T>::x_type) == x_short ||
+            static_cast<int>(exchange_traits<T>::x_type) == x_integer ||
+            static_cast<int>(exchange_traits<T>::x_type) == x_long_long ||
+            static_cast<int>(exchange_traits<T>::x_type) == x_unsigned_long_long ||
+            static_cast<int>(exchange_traits<T>::x_type) == x_double ||
+            static_cast<int>(exchange_traits<T>::x_type) == x_stdtm
+    };
+};
+
+// user-defined types can be fetched in bulk if their base type can
+template <typename T, typename BaseType>
+struct rowset_bulk_fetch_base_traits
+{
+    enum { value = rowset_bulk_fetch_traits<BaseType>::value };
+};
+
+// types without a conversion of their own are exchanged in some other way
+template <typename T>
+struct rowset_bulk_fetch_base_traits<T, T>
+{
+    enum { value = false };
+};
+
+template <typename T>
+struct rowset_bulk_fetch_family_traits<T, user_type_tag>
+{
+    enum
+    {
+        value = rowset_bulk_fetch_base_traits<T,
+            typename type_conversion<T>::base_type>::value
+    };
+};
+
+template <typename T>
+class rowset_vector_buffer : public rowset_buffer<T>
+{
+public:
+    // the rows are stored in the buffer itself and not in the define object
+    rowset_vector_buffer(statement & st, T &, std::size_t size)
+        : st_(st), size_(size), rows_(size), next_(size)
+    {
+        bind(typename exchange_traits<T>::type_family());
+    }
+
+    T * next() SOCI_OVERRIDE
+    {
+        if (next_ == rows_.size())
+        {
+            // fetch() shrinks the vectors to the number of rows it actually
+            // got, so restore their size before fetching the next batch
+            rows_.resize(size_);
+            if (inds_.empty() == false)
+            {
+                inds_.resize(size_);
+            }
+
+            if (st_.fetch() == false)
+            {
+                return 0;
+            }
+
+            next_ = 0;
+        }
+
+        if (inds_.empty() == false && inds_[next_] == i_null)
+        {
+            throw soci_error("Null value fetched and no indicator defined.");
+        }
+
+        return &rows_[next_++];
+    }
+
+private:
+    void bind(basic_type_tag)
+    {
+        // fetching a null value must only fail when it is reached, not for
+        // the entire batch containing it
+        inds_.resize(size_);
+        st_.exchange_for_rowset(into(rows_, inds_));
+    }
+
+    void bind(user_type_tag)
+    {
+        // user-defined types deal with nulls in their conversion
+        st_.exchange_for_rowset(into(rows_));
+    }
+
+    statement & st_;
+    std::size_t const size_;
+    std::vector<T> rows_;
+    std::vector<indicator> inds_;
+    std::size_t next_;
+
+    SOCI_NOT_COPYABLE(rowset_vector_buffer)
+};
+
+// Row is a template parameter only to avoid depending on row-exchange.h here,
+// this class is only used with soci::row.
+template <typename Row>
+class rowset_row_buffer : public rowset_buffer<Row>
+{
+public:
+    rowset_row_buffer(statement & st, Row & r, std::size_t size)
+        : st_(st), row_(r), count_(0), next_(0)
+    {
+        // the statement binds the vectors for the row columns itself, when
+        // describing them
+        st_.set_row_batch_size(size);
+        st_.exchange_for_rowset(into(row_));
+    }
+
+    Row * next() SOCI_OVERRIDE
+    {
+        if (next_ == count_)
+        {
+            if (st_.fetch() == false)
+            {
+                return 0;
+            }
+
+            count_ = st_.get_row_batch_count();
+            next_ = 0;
+        }
+
+        st_.load_row_from_batch(next_++);
+
+        return &row_;
+    }
+
+private:
+    statement & st_;
+    Row & row_;
+    std::size_t count_;
+    std::size_t next_;
+
+    SOCI_NOT_COPYABLE(rowset_row_buffer)
+};
+
+template <typename T, bool Bulk = rowset_bulk_fetch_traits<T>::value>
+struct rowset_buffer_factory
+{
+    static rowset_buffer<T> * create(statement &, T &, std::size_t)
+    {
+        return 0;
+    }
+};
+
+template <typename T>
+struct rowset_bulk_buffer
+{
+    typedef rowset_vector_buffer<T> type;
+};
+
+template <>
+struct rowset_bulk_buffer<row>
+{
+    typedef rowset_row_buffer<row> type;
+};
+
+template <typename T>
+struct rowset_buffer_factory<T, true>
+{
+    static rowset_buffer<T> * create(statement & st, T & define,
+        std::size_t size)
+    {
+        return new typename rowset_bulk_buffer<T>::type(st, define, size);
+    }
+};
+
 //
 // Implementation of rowset
 //
@@ -113,10 +380,26 @@ public:
 
     typedef rowset_iterator<T> iterator;
 
-    rowset_impl(details::prepare_temp_type const & prep)
+    rowset_impl(details::prepare_temp_type const & prep,
+        std::size_t prefetchSize)
         : refs_(1), st_(new statement(prep)), define_(new T())
     {
-        st_->exchange_for_rowset(into(*define_));
+        if (prefetchSize == 0)
+        {
+            prefetchSize = st_->get_session().get_rowset_prefetch_size();
+        }
+
+        if (prefetchSize > 1)
+        {
+            buffer_.reset(rowset_buffer_factory<T>::create(*st_, *define_,
+                prefetchSize));
+        }
+
+        if (buffer_.get() == 0)
+        {
+            st_->exchange_for_rowset(into(*define_));
+        }
+
         st_->execute();
     }
 
@@ -136,6 +419,11 @@ public:
     iterator begin() const
     {
         // No ownership transfer occurs here
+        if (buffer_.get() != 0)
+        {
+            return iterator(*st_, *buffer_);
+        }
+
         return iterator(*st_, *define_);
     }
 
@@ -150,6 +438,7 @@ private:
 
     const cxx_details::auto_ptr<statement> st_;
     const cxx_details::auto_ptr<T> define_;
+    cxx_details::auto_ptr<rowset_buffer<T> > buffer_;
     SOCI_NOT_COPYABLE(rowset_impl)
 }; // class rowset_impl
 
@@ -172,7 +461,14 @@ public:
 
     // this is a conversion constructor
     rowset(details::prepare_temp_type const& prep)
-        : pimpl_(new details::rowset_impl<T>(prep))
+        : pimpl_(new details::rowset_impl<T>(prep, 0))
+    {
+    }
+
+    // fetch up to prefetchSize rows at once instead of using the session
+    // default, see session::set_rowset_prefetch_size()
+    rowset(details::prepare_temp_type const& prep, std::size_t prefetchSize)
+        : pimpl_(new details::rowset_impl<T>(prep, prefetchSize))
     {
     }
 
@@ -33,6 +33,7 @@ class session_backend;
 class statement_backend;
 class rowid_backend;
 class blob_backend;
+class statement_cache;
 
 } // namespace details
 
@@ -64,10 +65,23 @@ public:
     void close();
     void reconnect();
 
+    // Check if the session is open and the connection can still be used.
+    bool is_connected() const;
+
     void begin();
     void commit();
     void rollback();
 
+    // Queue the executions of the statements without into elements instead
+    // of waiting for their results until end_pipeline(), which returns the
+    // total number of rows affected by them and throws if any of them failed.
+    // sync_pipeline() waits for the results without leaving the pipeline
+    // mode. Backends which don't support pipelining execute the statements
+    // immediately and return -1 from both of these functions.
+    void begin_pipeline();
+    long long sync_pipeline();
+    long long end_pipeline();
+
     // once and prepare are for syntax sugar only
     details::once_type once;
     details::prepare_type prepare;
@@ -76,9 +90,28 @@ public:
     template <typename T>
     details::once_temp_type operator<<(T const & t) { return once << t; }
 
+    // Deprecated: the query stream is only used for formatting the values of
+    // the types other than strings and numbers, e.g. user-defined types with
+    // their own operator<<, when building the query text, and anything
+    // written to it directly is not part of the query.
     std::ostringstream & get_query_stream();
     std::string get_query() const;
 
+    // Used when building the query text with operator<<: start a new query
+    // and append fragments of its text to it. Strings are appended directly
+    // and numbers are formatted as in the "C" locale, without using the
+    // query stream.
+    void reset_query();
+    void append_to_query(std::string const & s);
+    void append_to_query(char const * s);
+    void append_to_query(long long n);
+    void append_to_query(unsigned long long n);
+    void append_to_query(double d);
+
+    // Same as get_query(), but avoids copying the query text. The returned
+    // reference is only valid until the next query is started.
+    std::string const & get_query_text();
+
     template <typename T>
     void set_query_transformation(T callback)
     {
@@ -104,6 +137,12 @@ public:
     void log_query(std::string const & query);
     std::string get_last_query() const;
 
+    // Used by the statements to report the phases of the query execution to
+    // the logger if it wants them.
+    bool wants_query_phases() const;
+    void log_query_phase(std::string const & query,
+        query_phase_info const & info);
+
     void set_got_data(bool gotData);
     bool got_data() const;
 
@@ -111,6 +150,20 @@ public:
 
     bool get_uppercase_column_names() const;
 
+    // Number of rows fetched at once by rowset<T> when T is row or can be
+    // used with vector into elements. The default is 1, i.e. the rows are
+    // fetched one by one unless a bigger prefetch size is set.
+    void set_rowset_prefetch_size(std::size_t prefetchSize);
+    std::size_t get_rowset_prefetch_size() const;
+
+    // Maximal number of prepared statements kept by the session for reuse by
+    // the one-time queries executed with "sql << ...", the least recently
+    // used ones are discarded first. The default is 0, i.e. one-time queries
+    // are prepared anew every time they're executed, as they always are with
+    // the backends not supporting statement reuse.
+    void set_statement_cache_size(std::size_t size);
+    std::size_t get_statement_cache_size() const;
+
     // Functions for dealing with sequence/auto-increment values.
 
     // If true is returned, value is filled with the next value from the given
@@ -184,6 +237,12 @@ public:
     std::string get_backend_name() const;
 
     details::statement_backend * make_statement_backend();
+
+    // Used by one-time queries to get the statement prepared for the given
+    // query from the cache, if any, and to give it back after executing it.
+    details::statement_backend * take_cached_statement(std::string const & query);
+    void cache_statement(std::string const & query,
+        details::statement_backend * st);
     details::rowid_backend * make_rowid_backend();
     details::blob_backend * make_blob_backend();
 
@@ -193,12 +252,21 @@ private:
     std::ostringstream query_stream_;
     details::query_transformation_function* query_transformation_;
 
+    // The text of the query being built and the result of applying the query
+    // transformation to it, reused for all queries to avoid reallocating.
+    std::string query_;
+    std::string transformedQuery_;
+
     logger logger_;
 
     connection_parameters lastConnectParameters_;
 
     bool uppercaseColumnNames_;
 
+    std::size_t rowsetPrefetchSize_;
+
+    details::statement_cache * statementCache_;
+
     details::session_backend * backEnd_;
 
     bool gotData_;
@@ -15,6 +15,7 @@
 #include <map>
 #include <string>
 #include <sstream>
+#include <vector>
 
 namespace soci
 {
@@ -167,6 +168,14 @@ private:
     SOCI_NOT_COPYABLE(vector_use_type_backend)
 };
 
+// description of a single column of the statement result
+
+struct column_description
+{
+    data_type dataType_;
+    std::string name_;
+};
+
 // polymorphic statement backend
 
 class statement_backend
@@ -205,6 +214,47 @@ public:
     virtual vector_into_type_backend* make_vector_into_type_backend() = 0;
     virtual vector_use_type_backend* make_vector_use_type_backend() = 0;
 
+    // Return true if reset_for_reuse() is implemented and so the prepared
+    // statement can be kept for reuse with different into and use elements.
+    virtual bool supports_reuse() const { return false; }
+
+    // Called when a prepared statement is kept for reuse with different
+    // into and use elements: release any pending results and forget
+    // everything about the elements bound to it.
+    virtual void reset_for_reuse() {}
+
+    // Queue the executions of this statement without waiting for their
+    // results, as if it were executed between session::begin_pipeline() and
+    // session::end_pipeline(). Backends without pipeline support ignore it.
+    virtual void set_pipelined(bool) {}
+
+    // Result columns, as returned by describe_column(), remembered by the
+    // core after describing the statement so that it doesn't need to be done
+    // again when the statement is executed once more with a (possibly
+    // different) row. They are cleared when a new query is prepared and when
+    // the statement execution fails.
+    std::vector<column_description> const& get_described_columns() const
+    {
+        return describedColumns_;
+    }
+
+    void set_described_columns(std::vector<column_description>& columns)
+    {
+        describedColumns_.swap(columns);
+    }
+
+    void clear_described_columns() { describedColumns_.clear(); }
+
+    // Return true if the columns described before can be reused instead of
+    // describing the statement again. Only the backends which can guarantee
+    // that the result columns of the prepared statement can't change, even if
+    // the database schema is modified, should return true from here: notably,
+    // re-executing the statement must fail if they have changed.
+    virtual bool can_reuse_described_columns() const { return false; }
+
+protected:
+    std::vector<column_description> describedColumns_;
+
 private:
     SOCI_NOT_COPYABLE(statement_backend)
 };
@@ -265,6 +315,17 @@ public:
     virtual void commit() = 0;
     virtual void rollback() = 0;
 
+    // Check if the connection can still be used. Backends which can't check
+    // it assume that it can.
+    virtual bool is_connected() { return true; }
+
+    // Pipeline mode, see session::begin_pipeline(). Backends which don't
+    // support it execute all statements immediately and so have nothing to
+    // wait for, their sync_pipeline() and end_pipeline() just return -1.
+    virtual void begin_pipeline() {}
+    virtual long long sync_pipeline() { return -1; }
+    virtual long long end_pipeline() { return -1; }
+
     // At least one of these functions is usually not implemented for any given
     // backend as RDBMS support either sequences or auto-generated values, so
     // we don't declare them as pure virtuals to avoid having to define trivial
@@ -87,6 +87,15 @@ SOCI_DECL long long    soci_get_into_long_long_v(statement_handle st, int positi
 SOCI_DECL double       soci_get_into_double_v   (statement_handle st, int position, int index);
 SOCI_DECL char const * soci_get_into_date_v     (statement_handle st, int position, int index);
 
+// positional read of whole vectors into the given arrays, the states array
+// may be NULL, return the number of copied elements
+SOCI_DECL int soci_get_into_int_array(statement_handle st, int position,
+    int * values, int * states, int size);
+SOCI_DECL int soci_get_into_long_long_array(statement_handle st, int position,
+    long long * values, int * states, int size);
+SOCI_DECL int soci_get_into_double_array(statement_handle st, int position,
+    double * values, int * states, int size);
+
 
 // named bind of use elements
 SOCI_DECL void soci_use_string   (statement_handle st, char const * name);
@@ -131,6 +140,15 @@ SOCI_DECL void soci_set_use_double_v(statement_handle st,
 SOCI_DECL void soci_set_use_date_v(statement_handle st,
     char const * name, int index, char const * val);
 
+// named write of whole use vectors from the given arrays, the states array
+// may be NULL if all values are non-null
+SOCI_DECL void soci_set_use_int_array(statement_handle st,
+    char const * name, int const * values, int const * states, int size);
+SOCI_DECL void soci_set_use_long_long_array(statement_handle st,
+    char const * name, long long const * values, int const * states, int size);
+SOCI_DECL void soci_set_use_double_array(statement_handle st,
+    char const * name, double const * values, int const * states, int size);
+
 
 // named read of use elements (for modifiable use values)
 SOCI_DECL int          soci_get_use_state    (statement_handle st, char const * name);
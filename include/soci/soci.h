@@ -22,6 +22,7 @@
 #include "soci/once-temp-type.h"
 #include "soci/prepare-temp-type.h"
 #include "soci/procedure.h"
+#include "soci/query-statistics.h"
 #include "soci/ref-counted-prepare-info.h"
 #include "soci/ref-counted-statement.h"
 #include "soci/row.h"
@@ -24,6 +24,7 @@
 #endif
 
 #include <cstdarg>
+#include <cstddef>
 #include <vector>
 #include <soci/soci-backend.h>
 
@@ -135,6 +136,7 @@ struct sqlite3_standard_use_type_backend : details::standard_use_type_backend
     details::exchange_type type_;   // type of data_
     int position_;                  // binding position
     std::string name_;              // binding name
+    char dateBuffer_[20];           // text representation of x_stdtm data
 };
 
 struct sqlite3_vector_use_type_backend : details::vector_use_type_backend
@@ -161,6 +163,9 @@ struct sqlite3_vector_use_type_backend : details::vector_use_type_backend
     details::exchange_type type_;
     int position_;
     std::string name_;
+
+    // text representations of x_stdtm data, reused for all executions
+    std::vector<char> dateBuffers_;
 };
 
 struct sqlite3_column_buffer
@@ -187,14 +192,56 @@ struct sqlite3_column
     };
 };
 
-typedef std::vector<sqlite3_column> sqlite3_row;
-typedef std::vector<sqlite3_row> sqlite3_recordset;
+// Rectangular block of values used by the bulk operations.
+//
+// The values are stored column by column in a single buffer and the variable
+// length data they point to, if any, in another one. Both buffers are only
+// ever grown, so reusing the same recordset for the successive batches
+// doesn't allocate any memory once they are big enough.
+class sqlite3_recordset
+{
+public:
+    sqlite3_recordset() : rows_(0), columns_(0), stride_(0) {}
+
+    // Number of rows.
+    std::size_t size() const { return rows_; }
+    bool empty() const { return rows_ == 0; }
+
+    std::size_t columns() const { return columns_; }
+
+    // Change the number of rows and columns, preserving the existing values.
+    void resize(std::size_t rows, std::size_t columns);
+
+    sqlite3_column & operator()(std::size_t row, std::size_t column)
+    {
+        return cells_[column * stride_ + row];
+    }
+
+    // Forget all the variable length data.
+    void clear_data() { data_.clear(); }
+
+    // Append the given buffer, followed by NUL, to the variable length data.
+    void append_data(char const * buf, std::size_t size);
+
+    // Return the pointer to the variable length data at the given offset:
+    // it remains valid only until the next call to append_data().
+    char const * get_data(std::size_t offset) const { return &data_[offset]; }
+
+private:
+    std::size_t rows_;
+    std::size_t columns_;
+    std::size_t stride_; // number of rows allocated for each column
+
+    std::vector<sqlite3_column> cells_;
+    std::vector<char> data_;
+};
 
 
 struct sqlite3_column_info
 {
     data_type type_;
     std::string name_;
+    std::string declType_;
 };
 typedef std::vector<sqlite3_column_info> sqlite3_column_info_list;
 
@@ -228,19 +275,36 @@ struct sqlite3_statement_backend : details::statement_backend
     sqlite3_vector_into_type_backend * make_vector_into_type_backend() SOCI_OVERRIDE;
     sqlite3_vector_use_type_backend * make_vector_use_type_backend() SOCI_OVERRIDE;
 
+    bool supports_reuse() const SOCI_OVERRIDE { return true; }
+    void reset_for_reuse() SOCI_OVERRIDE;
+    bool can_reuse_described_columns() const SOCI_OVERRIDE { return true; }
+
     sqlite3_session_backend &session_;
     sqlite_api::sqlite3_stmt *stmt_;
     sqlite3_recordset dataCache_;
     sqlite3_recordset useData_;
     bool databaseReady_;
+    bool checkColumns_; // true until the first step of the execution
+    int reprepareCount_; // times stmt_ was recompiled when last checked
     bool boundByName_;
     bool boundByPos_;
     sqlite3_column_info_list columns_;
 
+    // Vectors of strings used as into elements indexed by column position
+    // (or NULL for the columns without them): string values are stored in
+    // them directly instead of being copied into dataCache_ first.
+    std::vector<std::vector<std::string> *> directStringIntos_;
 
     long long rowsAffectedBulk_; // number of rows affected by the last bulk operation
 
 private:
+    // Compile the given query, replacing the current statement, if any.
+    void compile(std::string const & query);
+
+    // Called after the first step of the statement execution to check that
+    // its result columns are still the described ones.
+    void check_columns();
+
     exec_fetch_result load_rowset(int totalRows);
     exec_fetch_result load_one();
     exec_fetch_result bind_and_execute(int number);
@@ -269,14 +333,41 @@ struct sqlite3_blob_backend : details::blob_backend
     std::size_t append(char const *buf, std::size_t toWrite) SOCI_OVERRIDE;
     void trim(std::size_t newLen) SOCI_OVERRIDE;
 
+    // Attach this blob to the value of the given column of the row with the
+    // given rowid, the data is then read and written directly from and to
+    // the database using SQLite incremental BLOB I/O without loading it into
+    // memory. Notice that the size of the value can't be changed in this
+    // case, so append() and trim() can't be used and write() can only
+    // overwrite the existing data.
+    void open(std::string const & table, std::string const & column,
+        sqlite_api::sqlite3_int64 rowid, bool readWrite = true,
+        std::string const & database = "main");
+
+    // Move an attached blob to another row of the same table.
+    void reopen(sqlite_api::sqlite3_int64 rowid);
+
+    // Detach the blob from the database value, if it was attached.
+    void close();
+
+    bool is_open() const { return blob_ != NULL; }
+
     sqlite3_session_backend &session_;
 
     std::size_t set_data(char const *buf, std::size_t toWrite);
-    const char *get_buffer() const { return buf_; }
+    const char *get_buffer() const;
 
 private:
+    // Make the in-memory buffer big enough for at least the given size.
+    void ensure_capacity(std::size_t size);
+
+    // Throw if the blob is attached to a database value.
+    void check_not_open(char const * operation) const;
+
     char *buf_;
     size_t len_;
+    size_t capacity_;
+
+    sqlite_api::sqlite3_blob *blob_;
 };
 
 struct sqlite3_session_backend : details::session_backend
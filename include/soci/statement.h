@@ -11,6 +11,7 @@
 #include "soci/bind-values.h"
 #include "soci/into-type.h"
 #include "soci/into.h"
+#include "soci/logger.h"
 #include "soci/noreturn.h"
 #include "soci/use-type.h"
 #include "soci/use.h"
@@ -34,6 +35,43 @@ class into_type_base;
 class use_type_base;
 class prepare_temp_type;
 
+// Values of one column of the rows fetched in batches into a row, see
+// statement_impl::set_row_batch_size().
+class row_batch_column_base
+{
+public:
+    virtual ~row_batch_column_base() {}
+
+    // Copy the value of the row at the given position in the batch into the
+    // row storage.
+    virtual void load(std::size_t pos) = 0;
+};
+
+template <typename T>
+class row_batch_column : public row_batch_column_base
+{
+public:
+    row_batch_column(T & value, indicator & ind, std::size_t size)
+        : values_(size), inds_(size), value_(value), ind_(ind)
+    {
+    }
+
+    void load(std::size_t pos) SOCI_OVERRIDE
+    {
+        value_ = values_[pos];
+        ind_ = inds_[pos];
+    }
+
+    std::vector<T> values_;
+    std::vector<indicator> inds_;
+
+private:
+    T & value_;
+    indicator & ind_;
+
+    SOCI_NOT_COPYABLE(row_batch_column)
+};
+
 class SOCI_DECL statement_impl
 {
 public:
@@ -60,6 +98,16 @@ public:
 
     void prepare(std::string const & query,
                     statement_type eType = st_repeatable_query);
+
+    // Use the given backend, already prepared for the same query, instead of
+    // allocating and preparing the statement again.
+    void use_prepared_backend(statement_backend * backEnd,
+        std::string const & query);
+
+    // Clean up all the bound elements and give up the ownership of the
+    // backend, which remains prepared and can be reused later.
+    statement_backend * release_prepared_backend();
+
     void define_and_bind();
     void undefine_and_bind();
     bool execute(bool withDataExchange = false);
@@ -67,11 +115,26 @@ public:
     bool fetch();
     void describe();
     void set_row(row * r);
+
+    // Fetch the values of the row columns in batches of the given size
+    // instead of one by one, must be called before executing the statement.
+    // After each fetch, get_row_batch_count() returns the number of rows in
+    // the batch and load_row_from_batch() puts one of them into the row.
+    void set_row_batch_size(std::size_t size) { rowBatchSize_ = size; }
+
+    // Queue the executions of this statement without waiting for their
+    // results even outside of session::begin_pipeline(), if supported.
+    void set_pipelined(bool pipelined) { pipelined_ = pipelined; }
+    std::size_t get_row_batch_count();
+    void load_row_from_batch(std::size_t pos);
+
     void exchange_for_rowset(into_type_ptr const & i) { exchange_for_rowset_(i); }
     template<typename T, typename Indicator>
     void exchange_for_rowset(into_container<T, Indicator> const &ic)
     { exchange_for_rowset_(ic); }
 
+    std::string const & get_query() const { return query_; }
+
     // for diagnostics and advanced users
     // (downcast it to expected back-end statement class)
     statement_backend * get_backend() { return backEnd_; }
@@ -100,6 +163,15 @@ private:
     // applicable, its parameters.
     SOCI_NORETURN rethrow_current_exception_with_context(char const* operation);
 
+    // Report the end of the given phase of the query execution, which started
+    // at the given time, to the logger. The second function must be called
+    // from a catch clause only and reports the current exception.
+    void end_query_phase(query_phase phase, long long start, long long rows);
+    void end_query_phase_with_error(query_phase phase, long long start);
+
+    // Return the number of rows fetched or affected by the last execution.
+    long long get_rows_for_query_phase(bool gotData, bool fetched);
+
     int refCount_;
 
     row * row_;
@@ -110,6 +182,11 @@ private:
     into_type_vector intosForRow_;
     int definePositionForRow_;
 
+    // if the row batch size is greater than 1, the intosForRow_ elements
+    // are vectors filling these columns, in the same order
+    std::size_t rowBatchSize_;
+    std::vector<row_batch_column_base *> rowBatch_;
+
     template <typename Into>
     void exchange_for_rowset_(Into const &i)
     {
@@ -135,19 +212,48 @@ private:
     void exchange_for_row(into_type_ptr const & i) { intosForRow_.exchange(i); }
     void define_for_row();
 
+    // Describe the columns for the row, if it hasn't been done yet or the
+    // description was invalidated, and return true if new into elements were
+    // created for them and must be defined.
+    bool describe_row();
+
+    // Destroy the into elements created for the row columns.
+    void clean_up_row_intos();
+
+    // Create the into element for the value of the row column at the given
+    // position, either adding it to the row or using the existing one.
     template<typename T>
-    void into_row()
+    void into_row(std::size_t pos, bool reuseHolder)
     {
-        T * t = new T();
-        indicator * ind = new indicator(i_ok);
-        row_->add_holder(t, ind);
-        exchange_for_row(into(*t, *ind));
+        T * t = NULL;
+        indicator * ind = NULL;
+        if (reuseHolder)
+        {
+            row_->get_holder(pos, t, ind);
+        }
+        else
+        {
+            row_->alloc_holder(t, ind);
+        }
+
+        if (rowBatchSize_ > 1)
+        {
+            row_batch_column<T> * const column
+                = new row_batch_column<T>(*t, *ind, rowBatchSize_);
+            rowBatch_.push_back(column);
+            exchange_for_row(into(column->values_, column->inds_));
+        }
+        else
+        {
+            exchange_for_row(into(*t, *ind));
+        }
     }
 
     template<data_type>
-    void bind_into();
+    void bind_into(std::size_t pos, bool reuseHolder);
 
     bool alreadyDescribed_;
+    bool pipelined_;
 
     std::size_t intos_size();
     std::size_t uses_size();
@@ -209,6 +315,17 @@ public:
         impl_->prepare(query, eType);
     }
 
+    void use_prepared_backend(details::statement_backend * backEnd,
+        std::string const & query)
+    {
+        impl_->use_prepared_backend(backEnd, query);
+    }
+
+    details::statement_backend * release_prepared_backend()
+    {
+        return impl_->release_prepared_backend();
+    }
+
     void define_and_bind() { impl_->define_and_bind(); }
     void undefine_and_bind()  { impl_->undefine_and_bind(); }
     bool execute(bool withDataExchange = false)
@@ -230,9 +347,24 @@ public:
 
     bool got_data() const { return gotData_; }
 
+    std::string const & get_query() const { return impl_->get_query(); }
+
+    session & get_session() const { return impl_->session_; }
+
     void describe()       { impl_->describe(); }
     void set_row(row * r) { impl_->set_row(r); }
 
+    void set_row_batch_size(std::size_t size)
+    {
+        impl_->set_row_batch_size(size);
+    }
+    void set_pipelined(bool pipelined) { impl_->set_pipelined(pipelined); }
+    std::size_t get_row_batch_count() { return impl_->get_row_batch_count(); }
+    void load_row_from_batch(std::size_t pos)
+    {
+        impl_->load_row_from_batch(pos);
+    }
+
     template <typename T, typename Indicator>
     void exchange_for_rowset(details::into_container<T, Indicator> const & ic)
     {
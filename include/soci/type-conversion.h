@@ -22,6 +22,53 @@ namespace soci
 namespace details
 {
 
+// Detects whether type_conversion<T> defines the optional move_from_base()
+// function with the same parameters as from_base(), except that the base
+// value is passed by non-const reference and so can be moved, or swapped,
+// into the user object instead of being copied.
+template <typename T>
+class has_move_from_base
+{
+    typedef typename type_conversion<T>::base_type base_type;
+
+    typedef char yes;
+    typedef char (&no)[2];
+
+    template <typename U, void (*)(base_type &, indicator, T &)>
+    struct check;
+
+    template <typename U>
+    static yes test(check<U, &U::move_from_base> *);
+
+    template <typename U>
+    static no test(...);
+
+public:
+    static bool const value = sizeof(test<type_conversion<T> >(0)) == sizeof(yes);
+};
+
+// Converts the base value, which is not used any more after this, to the
+// user type using move_from_base() if it's available or from_base() if not.
+template <typename T, bool CanMove = has_move_from_base<T>::value>
+struct base_value_converter
+{
+    static void from_base(typename type_conversion<T>::base_type & in,
+        indicator ind, T & out)
+    {
+        type_conversion<T>::from_base(in, ind, out);
+    }
+};
+
+template <typename T>
+struct base_value_converter<T, true>
+{
+    static void from_base(typename type_conversion<T>::base_type & in,
+        indicator ind, T & out)
+    {
+        type_conversion<T>::move_from_base(in, ind, out);
+    }
+};
+
 // this class is used to ensure correct order of construction
 // of into_type and use_type elements that use type_conversion
 
@@ -64,7 +111,7 @@ public:
 private:
     void convert_from_base() SOCI_OVERRIDE
     {
-        type_conversion<T>::from_base(
+        base_value_converter<T>::from_base(
             base_value_holder<T>::val_, ind_, value_);
     }
 
@@ -217,10 +264,15 @@ public:
     std::size_t size() const SOCI_OVERRIDE
     {
         // the user might have resized his vector in the meantime
-        // -> synchronize the base-value mirror to have the same size
+        // -> synchronize the base-value mirror to have the same size, notice
+        // that it's reused for all fetches and so only needs to be resized
+        // if the user vector size really changed
 
         std::size_t const userSize = value_.size();
-        base_vector_holder<T>::vec_.resize(userSize);
+        if (base_vector_holder<T>::vec_.size() != userSize)
+        {
+            base_vector_holder<T>::vec_.resize(userSize);
+        }
 
         return into_type<base_type>::size();
     }
@@ -241,7 +293,7 @@ private:
         {
             for (std::size_t i = begin_; i != *end_; ++i)
             {
-                type_conversion<T>::from_base(
+                base_value_converter<T>::from_base(
                     base_vector_holder<T>::vec_[i], ind_[i], value_[i]);
             }
         }
@@ -251,7 +303,7 @@ private:
 
             for (std::size_t i = 0; i != sz; ++i)
             {
-                type_conversion<T>::from_base(
+                base_value_converter<T>::from_base(
                     base_vector_holder<T>::vec_[i], ind_[i], value_[i]);
             }
         }
@@ -346,30 +398,6 @@ public:
     }
 
 private:
-    void convert_from_base()
-    {
-        std::size_t const sz = base_vector_holder<T>::vec_.size();
-        value_.resize(sz);
-        ind_.resize(sz);
-
-        if (user_ranges_)
-        {
-            for (std::size_t i = begin_; i != *end_; ++i)
-            {
-                type_conversion<T>::from_base(
-                    base_vector_holder<T>::vec_[i], value_[i], ind_[i]);
-            }
-        }
-        else
-        {
-            for (std::size_t i = 0; i != sz; ++i)
-            {
-                type_conversion<T>::from_base(
-                    base_vector_holder<T>::vec_[i], value_[i], ind_[i]);
-            }
-        }
-    }
-
     void convert_to_base() SOCI_OVERRIDE
     {
         std::size_t const sz = value_.size();
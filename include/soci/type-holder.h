@@ -9,8 +9,13 @@
 #define SOCI_TYPE_HOLDER_H_INCLUDED
 
 #include "soci/soci-platform.h"
+#include "soci/soci-backend.h"
 // std
+#include <cstddef>
+#include <ctime>
+#include <string>
 #include <typeinfo>
+#include <vector>
 
 namespace soci
 {
@@ -18,49 +23,138 @@ namespace soci
 namespace details
 {
 
-// Base class holder + derived class type_holder for storing type data
-// instances in a container of holder objects
+// Holder of a single value of a dynamic row, tagged with its type, which is
+// checked instead of using RTTI when the value is retrieved. Strings can't be
+// stored in the union, so they're kept separately and only their index is
+// stored in the holder.
+struct holder
+{
+    data_type type_;
+
+    union
+    {
+        double d_;
+        int i_;
+        long long ll_;
+        unsigned long long ull_;
+        std::tm tm_;
+        std::size_t stringIndex_;
+    };
+};
+
+// Access to the value of type T stored in a holder. Only the specializations
+// below correspond to the types which can be stored in it and can be used to
+// initialize it, the values of all the other types are never matched.
 template <typename T>
-class type_holder;
+struct type_holder
+{
+    static bool matches(holder const &) { return false; }
+
+    static T & value(holder &, std::vector<std::string> &)
+    {
+        throw std::bad_cast();
+    }
+};
 
-class holder
+template <>
+struct type_holder<std::string>
 {
-public:
-    holder() {}
-    virtual ~holder() {}
+    static void init(holder & h, std::vector<std::string> & strings)
+    {
+        h.type_ = dt_string;
+        h.stringIndex_ = strings.size();
+        strings.push_back(std::string());
+    }
+
+    static bool matches(holder const & h) { return h.type_ == dt_string; }
 
-    template<typename T>
-    T get()
+    static std::string & value(holder & h, std::vector<std::string> & strings)
     {
-        type_holder<T>* p = dynamic_cast<type_holder<T> *>(this);
-        if (p)
-        {
-            return p->template value<T>();
-        }
-        else
-        {
-            throw std::bad_cast();
-        }
+        return strings[h.stringIndex_];
     }
+};
 
-private:
+template <>
+struct type_holder<std::tm>
+{
+    static void init(holder & h, std::vector<std::string> &)
+    {
+        h.type_ = dt_date;
+    }
+
+    static bool matches(holder const & h) { return h.type_ == dt_date; }
 
-    template<typename T>
-    T value();
+    static std::tm & value(holder & h, std::vector<std::string> &)
+    {
+        return h.tm_;
+    }
 };
 
-template <typename T>
-class type_holder : public holder
+template <>
+struct type_holder<double>
+{
+    static void init(holder & h, std::vector<std::string> &)
+    {
+        h.type_ = dt_double;
+    }
+
+    static bool matches(holder const & h) { return h.type_ == dt_double; }
+
+    static double & value(holder & h, std::vector<std::string> &)
+    {
+        return h.d_;
+    }
+};
+
+template <>
+struct type_holder<int>
+{
+    static void init(holder & h, std::vector<std::string> &)
+    {
+        h.type_ = dt_integer;
+    }
+
+    static bool matches(holder const & h) { return h.type_ == dt_integer; }
+
+    static int & value(holder & h, std::vector<std::string> &)
+    {
+        return h.i_;
+    }
+};
+
+template <>
+struct type_holder<long long>
 {
-public:
-    type_holder(T * t) : t_(t) {}
-    ~type_holder() SOCI_OVERRIDE { delete t_; }
+    static void init(holder & h, std::vector<std::string> &)
+    {
+        h.type_ = dt_long_long;
+    }
 
-    template<typename TypeValue>
-    TypeValue value() const { return *t_; }
+    static bool matches(holder const & h) { return h.type_ == dt_long_long; }
 
-private:
-    T * t_;
+    static long long & value(holder & h, std::vector<std::string> &)
+    {
+        return h.ll_;
+    }
+};
+
+template <>
+struct type_holder<unsigned long long>
+{
+    static void init(holder & h, std::vector<std::string> &)
+    {
+        h.type_ = dt_unsigned_long_long;
+    }
+
+    static bool matches(holder const & h)
+    {
+        return h.type_ == dt_unsigned_long_long;
+    }
+
+    static unsigned long long & value(holder & h, std::vector<std::string> &)
+    {
+        return h.ull_;
+    }
 };
 
 } // namespace details
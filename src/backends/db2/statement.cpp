@@ -14,7 +14,8 @@ using namespace soci;
 using namespace soci::details;
 
 db2_statement_backend::db2_statement_backend(db2_session_backend &session)
-    : session_(session),hasVectorUseElements(false),use_binding_method_(details::db2::BOUND_BY_NONE)
+    : session_(session),hasVectorUseElements(false),use_binding_method_(details::db2::BOUND_BY_NONE),
+      fetchArraySize(0)
 {
 }
 
@@ -26,6 +27,9 @@ void db2_statement_backend::alloc()
     if (cliRC != SQL_SUCCESS) {
         throw db2_soci_error("Error while allocation statement handle",cliRC);
     }
+
+    // the new handle has the default attributes
+    fetchArraySize = 0;
 }
 
 void db2_statement_backend::clean_up()
@@ -165,9 +169,20 @@ db2_statement_backend::fetch(int  number )
 {
     numRowsFetched = 0;
 
-    SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_BIND_TYPE, SQL_BIND_BY_COLUMN, 0);
-    SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, db2::int_as_ptr(number), 0);
-    SQLSetStmtAttr(hStmt, SQL_ATTR_ROWS_FETCHED_PTR, &numRowsFetched, 0);
+    // The attributes are preserved between fetches, so only set them when
+    // fetching for the first time or when the number of rows changes.
+    if (fetchArraySize == 0)
+    {
+        SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_BIND_TYPE, SQL_BIND_BY_COLUMN, 0);
+        SQLSetStmtAttr(hStmt, SQL_ATTR_ROWS_FETCHED_PTR, &numRowsFetched, 0);
+    }
+
+    if (number != fetchArraySize)
+    {
+        SQLRETURN const rc = SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE,
+                                            db2::int_as_ptr(number), 0);
+        fetchArraySize = (rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO) ? number : 0;
+    }
 
     SQLRETURN cliRC = SQLFetch(hStmt);
 
@@ -6,10 +6,13 @@
 //
 
 #include "common.h"
+#include "soci-exchange-cast.h"
+#include "soci-mktime.h"
 #include <ciso646>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <string>
 
 char * soci::details::mysql::quote(MYSQL * conn, const char *s, size_t len)
 {
@@ -21,3 +24,217 @@ char * soci::details::mysql::quote(MYSQL * conn, const char *s, size_t len)
 
     return retv;
 }
+
+void soci::details::mysql::bind_param(MYSQL_BIND & bind, MYSQL_TIME & time,
+    exchange_type type, void *data, bool isNull)
+{
+    std::memset(&bind, 0, sizeof(bind));
+
+    if (isNull)
+    {
+        bind.buffer_type = MYSQL_TYPE_NULL;
+        return;
+    }
+
+    switch (type)
+    {
+    case x_char:
+        bind.buffer_type = MYSQL_TYPE_STRING;
+        bind.buffer = data;
+        bind.buffer_length = 1;
+        break;
+    case x_stdstring:
+        {
+            std::string & s = exchange_type_cast<x_stdstring>(data);
+            bind.buffer_type = MYSQL_TYPE_STRING;
+            bind.buffer = const_cast<char *>(s.data());
+            bind.buffer_length = static_cast<unsigned long>(s.size());
+        }
+        break;
+    case x_short:
+        bind.buffer_type = MYSQL_TYPE_SHORT;
+        bind.buffer = data;
+        break;
+    case x_integer:
+        bind.buffer_type = MYSQL_TYPE_LONG;
+        bind.buffer = data;
+        break;
+    case x_long_long:
+        bind.buffer_type = MYSQL_TYPE_LONGLONG;
+        bind.buffer = data;
+        break;
+    case x_unsigned_long_long:
+        bind.buffer_type = MYSQL_TYPE_LONGLONG;
+        bind.buffer = data;
+        bind.is_unsigned = 1;
+        break;
+    case x_double:
+        if (is_infinity_or_nan(exchange_type_cast<x_double>(data)))
+        {
+            throw soci_error(
+                "Use element used with infinity or NaN, which are "
+                "not supported by the MySQL server.");
+        }
+        bind.buffer_type = MYSQL_TYPE_DOUBLE;
+        bind.buffer = data;
+        break;
+    case x_stdtm:
+        {
+            std::tm const & t = exchange_type_cast<x_stdtm>(data);
+            std::memset(&time, 0, sizeof(time));
+            time.year = t.tm_year + 1900;
+            time.month = t.tm_mon + 1;
+            time.day = t.tm_mday;
+            time.hour = t.tm_hour;
+            time.minute = t.tm_min;
+            time.second = t.tm_sec;
+            time.time_type = MYSQL_TIMESTAMP_DATETIME;
+
+            bind.buffer_type = MYSQL_TYPE_DATETIME;
+            bind.buffer = &time;
+        }
+        break;
+    default:
+        throw soci_error("Use element used with non-supported type.");
+    }
+
+    // The length is only used for strings, but it doesn't hurt to set it.
+    bind.length = &bind.buffer_length;
+}
+
+void soci::details::mysql::fetch_column(mysql_statement_backend & statement,
+    int pos, exchange_type type, void *data)
+{
+    MYSQL_BIND bind;
+    std::memset(&bind, 0, sizeof(bind));
+    bind.length = &bind.length_value;
+    bind.is_null = &bind.is_null_value;
+    bind.error = &bind.error_value;
+
+    MYSQL_TIME time;
+    std::memset(&time, 0, sizeof(time));
+
+    switch (type)
+    {
+    case x_char:
+        // Don't leave garbage in the output if the value is empty.
+        exchange_type_cast<x_char>(data) = '\0';
+        bind.buffer_type = MYSQL_TYPE_STRING;
+        bind.buffer = data;
+        bind.buffer_length = 1;
+        break;
+    case x_stdstring:
+        {
+            // The length of string columns is known after fetching the row,
+            // for the other ones the textual representation is always short.
+            MYSQL_BIND const & column = statement.resultBinds_[pos];
+            unsigned long const len = column.buffer_type == MYSQL_TYPE_STRING
+                ? *column.length : 64;
+
+            std::string & dest = exchange_type_cast<x_stdstring>(data);
+            if (len == 0)
+            {
+                dest.clear();
+                return;
+            }
+
+            dest.resize(len);
+            bind.buffer_type = MYSQL_TYPE_STRING;
+            bind.buffer = &dest[0];
+            bind.buffer_length = len;
+        }
+        break;
+    case x_short:
+        bind.buffer_type = MYSQL_TYPE_SHORT;
+        bind.buffer = data;
+        break;
+    case x_integer:
+        bind.buffer_type = MYSQL_TYPE_LONG;
+        bind.buffer = data;
+        break;
+    case x_long_long:
+        bind.buffer_type = MYSQL_TYPE_LONGLONG;
+        bind.buffer = data;
+        break;
+    case x_unsigned_long_long:
+        bind.buffer_type = MYSQL_TYPE_LONGLONG;
+        bind.buffer = data;
+        bind.is_unsigned = 1;
+        break;
+    case x_double:
+        bind.buffer_type = MYSQL_TYPE_DOUBLE;
+        bind.buffer = data;
+        break;
+    case x_stdtm:
+        {
+            MYSQL_FIELD *field =
+                mysql_fetch_field_direct(statement.result_, pos);
+            switch (field->type)
+            {
+            case MYSQL_TYPE_TIMESTAMP:
+            case MYSQL_TYPE_DATE:
+            case MYSQL_TYPE_TIME:
+            case MYSQL_TYPE_DATETIME:
+            case MYSQL_TYPE_NEWDATE:
+                bind.buffer_type = field->type;
+                bind.buffer = &time;
+                break;
+            default:
+                {
+                    // parse the textual value, as in the non-prepared case
+                    std::string s;
+                    fetch_column(statement, pos, x_stdstring, &s);
+                    parse_std_tm(s.c_str(), exchange_type_cast<x_stdtm>(data));
+                }
+                return;
+            }
+        }
+        break;
+    default:
+        throw soci_error("Into element used with non-supported type.");
+    }
+
+    if (mysql_stmt_fetch_column(statement.stmt_, &bind,
+            static_cast<unsigned int>(pos), 0) != 0)
+    {
+        throw mysql_soci_error(mysql_stmt_error(statement.stmt_),
+            mysql_stmt_errno(statement.stmt_));
+    }
+
+    if (type == x_char)
+    {
+        // Truncation is expected here, only the first character is used.
+        return;
+    }
+
+    if (type == x_stdstring)
+    {
+        std::string & dest = exchange_type_cast<x_stdstring>(data);
+        if (bind.length_value < dest.size())
+        {
+            dest.resize(bind.length_value);
+        }
+        return;
+    }
+
+    if (bind.error_value)
+    {
+        throw soci_error("Cannot convert data.");
+    }
+
+    if (type == x_stdtm)
+    {
+        if (time.time_type == MYSQL_TIMESTAMP_TIME)
+        {
+            // leave the date part as 1900-01-01, as parse_std_tm() does
+            time.year = 1900;
+            time.month = 1;
+            time.day = 1;
+        }
+
+        mktime_from_ymdhms(exchange_type_cast<x_stdtm>(data),
+            static_cast<int>(time.year), static_cast<int>(time.month),
+            static_cast<int>(time.day), static_cast<int>(time.hour),
+            static_cast<int>(time.minute), static_cast<int>(time.second));
+    }
+}
@@ -73,6 +73,19 @@ void parse_num(char const *buf, double &x)
 // helper for escaping strings
 char * quote(MYSQL * conn, const char *s, size_t len);
 
+// helpers for server-side prepared statements
+
+// Fill the parameter bind to refer to the value of the given type stored at
+// data, without copying it unless it's a std::tm, which is converted to the
+// provided MYSQL_TIME, so both data and time must outlive the execution.
+void bind_param(MYSQL_BIND & bind, MYSQL_TIME & time,
+    exchange_type type, void *data, bool isNull);
+
+// Retrieve the value of the column at the given (0-based) position of the
+// currently fetched row and store it in the object of the given type.
+void fetch_column(mysql_statement_backend & statement, int pos,
+    exchange_type type, void *data);
+
 // helper for vector operations
 template <typename T>
 std::size_t get_vector_size(void *p)
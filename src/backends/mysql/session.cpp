@@ -173,7 +173,9 @@ void parse_connect_string(const string & connectString,
     string *charset, bool *charset_p,
     unsigned int *connect_timeout, bool *connect_timeout_p,
     unsigned int *read_timeout, bool *read_timeout_p,
-    unsigned int *write_timeout, bool *write_timeout_p)
+    unsigned int *write_timeout, bool *write_timeout_p,
+    int *prepared_statements, bool *prepared_statements_p,
+    int *use_result, bool *use_result_p)
 {
     *host_p = false;
     *user_p = false;
@@ -189,6 +191,8 @@ void parse_connect_string(const string & connectString,
     *connect_timeout_p = false;
     *read_timeout_p = false;
     *write_timeout_p = false;
+    *prepared_statements_p = false;
+    *use_result_p = false;
     string err = "Malformed connection string.";
     string::const_iterator i = connectString.begin(),
         end = connectString.end();
@@ -301,6 +305,31 @@ void parse_connect_string(const string & connectString,
             char *end;
             *write_timeout = std::strtoul(val.c_str(), &end, 10);
             *write_timeout_p = true;
+        } else if (par == "prepared_statements" && !*prepared_statements_p)
+        {
+            if (!valid_int(val))
+            {
+                throw soci_error(err);
+            }
+            *prepared_statements = std::atoi(val.c_str());
+            if (*prepared_statements != 0 && *prepared_statements != 1)
+            {
+                throw soci_error(err);
+            }
+            *prepared_statements_p = true;
+        }
+        else if (par == "use_result" && !*use_result_p)
+        {
+            if (!valid_int(val))
+            {
+                throw soci_error(err);
+            }
+            *use_result = std::atoi(val.c_str());
+            if (*use_result != 0 && *use_result != 1)
+            {
+                throw soci_error(err);
+            }
+            *use_result_p = true;
         }
         else
         {
@@ -325,14 +354,16 @@ void parse_connect_string(const string & connectString,
 
 mysql_session_backend::mysql_session_backend(
     connection_parameters const & parameters)
+    : prepared_statements_(false), use_result_(false), max_allowed_packet_(0)
 {
     string host, user, password, db, unix_socket, ssl_ca, ssl_cert, ssl_key,
         charset;
-    int port, local_infile;
+    int port, local_infile, prepared_statements, use_result;
     unsigned int connect_timeout, read_timeout, write_timeout;
     bool host_p, user_p, password_p, db_p, unix_socket_p, port_p,
         ssl_ca_p, ssl_cert_p, ssl_key_p, local_infile_p, charset_p,
-        connect_timeout_p, read_timeout_p, write_timeout_p;
+        connect_timeout_p, read_timeout_p, write_timeout_p,
+        prepared_statements_p, use_result_p;
     parse_connect_string(parameters.get_connect_string(), &host, &host_p, &user, &user_p,
         &password, &password_p, &db, &db_p,
         &unix_socket, &unix_socket_p, &port, &port_p,
@@ -340,7 +371,17 @@ mysql_session_backend::mysql_session_backend(
         &local_infile, &local_infile_p, &charset, &charset_p,
         &connect_timeout, &connect_timeout_p,
         &read_timeout, &read_timeout_p,
-        &write_timeout, &write_timeout_p);
+        &write_timeout, &write_timeout_p,
+        &prepared_statements, &prepared_statements_p,
+        &use_result, &use_result_p);
+    if (prepared_statements_p && prepared_statements == 1)
+    {
+        prepared_statements_ = true;
+    }
+    if (use_result_p && use_result == 1)
+    {
+        use_result_ = true;
+    }
     conn_ = mysql_init(NULL);
     if (conn_ == NULL)
     {
@@ -462,6 +503,11 @@ void mysql_session_backend::rollback()
     hard_exec(conn_, "ROLLBACK");
 }
 
+bool mysql_session_backend::is_connected()
+{
+    return mysql_ping(conn_) == 0;
+}
+
 bool mysql_session_backend::get_last_insert_id(
     session & /* s */, std::string const & /* table */, long long & value)
 {
@@ -470,6 +516,35 @@ bool mysql_session_backend::get_last_insert_id(
     return true;
 }
 
+std::size_t mysql_session_backend::get_max_allowed_packet()
+{
+    if (max_allowed_packet_ == 0)
+    {
+        hard_exec(conn_, "SELECT @@max_allowed_packet");
+
+        MYSQL_RES *result = mysql_store_result(conn_);
+        if (result == NULL)
+        {
+            throw mysql_soci_error(mysql_error(conn_), mysql_errno(conn_));
+        }
+
+        MYSQL_ROW row = mysql_fetch_row(result);
+        if (row != NULL && row[0] != NULL)
+        {
+            max_allowed_packet_ = std::strtoul(row[0], NULL, 10);
+        }
+        mysql_free_result(result);
+
+        if (max_allowed_packet_ < 1024)
+        {
+            // this is the minimal allowed value
+            max_allowed_packet_ = 1024;
+        }
+    }
+
+    return max_allowed_packet_;
+}
+
 void mysql_session_backend::clean_up()
 {
     if (conn_ != NULL)
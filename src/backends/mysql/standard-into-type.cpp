@@ -54,11 +54,20 @@ void mysql_standard_into_type_backend::post_fetch(
     if (gotData)
     {
         int pos = position_ - 1;
-        //mysql_data_seek(statement_.result_, statement_.currentRow_);
-        mysql_row_seek(statement_.result_,
-            statement_.resultRowOffsets_[statement_.currentRow_]);
-        MYSQL_ROW row = mysql_fetch_row(statement_.result_);
-        if (row[pos] == NULL)
+        MYSQL_ROW row = NULL;
+        unsigned long *lengths = NULL;
+        bool isNull;
+        if (statement_.stmt_ != NULL)
+        {
+            statement_.fetch_prepared_row(statement_.currentRow_);
+            isNull = *statement_.resultBinds_[pos].is_null != 0;
+        }
+        else
+        {
+            row = statement_.get_row(statement_.currentRow_, lengths);
+            isNull = row[pos] == NULL;
+        }
+        if (isNull)
         {
             if (ind == NULL)
             {
@@ -75,6 +84,12 @@ void mysql_standard_into_type_backend::post_fetch(
                 *ind = i_ok;
             }
         }
+        if (statement_.stmt_ != NULL)
+        {
+            // the value is retrieved in binary form, without parsing it
+            fetch_column(statement_, pos, type_, data_);
+            return;
+        }
         const char *buf = row[pos] != NULL ? row[pos] : "";
         switch (type_)
         {
@@ -84,8 +99,6 @@ void mysql_standard_into_type_backend::post_fetch(
         case x_stdstring:
             {
                 std::string& dest = exchange_type_cast<x_stdstring>(data_);
-                unsigned long * lengths =
-                    mysql_fetch_lengths(statement_.result_);
                 dest.assign(buf, lengths[pos]);
             }
             break;
@@ -41,6 +41,23 @@ void mysql_standard_use_type_backend::bind_by_name(
 
 void mysql_standard_use_type_backend::pre_use(indicator const *ind)
 {
+    if (statement_.stmt_ != NULL)
+    {
+        // the value is sent in binary form, without copying it
+        bind_param(bind_, time_, type_, data_, ind != NULL && *ind == i_null);
+
+        if (position_ > 0)
+        {
+            statement_.useByPosBinds_[position_] = &bind_;
+        }
+        else
+        {
+            statement_.useByNameBinds_[name_] = &bind_;
+        }
+
+        return;
+    }
+
     if (ind != NULL && *ind == i_null)
     {
         buf_ = new char[5];
@@ -10,21 +10,174 @@
 #include "soci/mysql/soci-mysql.h"
 #include <cctype>
 #include <ciso646>
+#include <cstring>
 
 using namespace soci;
 using namespace soci::details;
 using std::string;
 
 
+namespace // anonymous
+{
+
+bool is_identifier_char(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// Check whether the given keyword starts at the given position of the string
+// (case-insensitively) and is not just a part of a longer identifier.
+bool is_keyword_at(std::string const & s, std::string::size_type pos,
+    char const * keyword)
+{
+    std::string::size_type const len = std::strlen(keyword);
+    if (pos + len > s.size())
+    {
+        return false;
+    }
+    for (std::string::size_type i = 0; i != len; ++i)
+    {
+        if (std::tolower(static_cast<unsigned char>(s[pos + i])) != keyword[i])
+        {
+            return false;
+        }
+    }
+    if (pos != 0 && is_identifier_char(s[pos - 1]))
+    {
+        return false;
+    }
+    return pos + len == s.size() || !is_identifier_char(s[pos + len]);
+}
+
+// Check whether the query split into the given chunks is of the form
+// "INSERT ... VALUES (...) [ON DUPLICATE KEY UPDATE ...]", with all its
+// parameters inside the single values tuple, and return the position of the
+// opening parenthesis of this tuple in the first chunk and of the closing one
+// in the last chunk if it is.
+bool find_values_tuple(std::vector<std::string> const & chunks,
+    std::string::size_type & begin, std::string::size_type & end)
+{
+    std::string const & first = chunks.front();
+    std::string::size_type const start = first.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos ||
+        (!is_keyword_at(first, start, "insert") &&
+         !is_keyword_at(first, start, "replace")))
+    {
+        return false;
+    }
+
+    // Notice that the chunks always start and end outside of quotes.
+    begin = std::string::npos;
+    bool inQuotes = false;
+    bool escaped = false;
+    for (std::string::size_type i = start; i != first.size(); ++i)
+    {
+        if (inQuotes)
+        {
+            if (first[i] == '\'' && !escaped)
+            {
+                inQuotes = false;
+            }
+            escaped = first[i] == '\\' && !escaped;
+        }
+        else if (first[i] == '\'')
+        {
+            inQuotes = true;
+        }
+        else if (is_keyword_at(first, i, "values"))
+        {
+            std::string::size_type const paren =
+                first.find_first_not_of(" \t\r\n", i + 6);
+            if (paren != std::string::npos && first[paren] == '(')
+            {
+                begin = paren;
+                break;
+            }
+        }
+    }
+
+    if (begin == std::string::npos)
+    {
+        return false;
+    }
+
+    int depth = 0;
+    for (std::size_t n = 0; n != chunks.size(); ++n)
+    {
+        std::string const & chunk = chunks[n];
+        inQuotes = false;
+        escaped = false;
+        for (std::string::size_type i = n == 0 ? begin : 0;
+             i != chunk.size(); ++i)
+        {
+            if (inQuotes)
+            {
+                if (chunk[i] == '\'' && !escaped)
+                {
+                    inQuotes = false;
+                }
+                escaped = chunk[i] == '\\' && !escaped;
+            }
+            else if (chunk[i] == '\'')
+            {
+                inQuotes = true;
+            }
+            else if (chunk[i] == '(')
+            {
+                ++depth;
+            }
+            else if (chunk[i] == ')' && --depth == 0)
+            {
+                if (n != chunks.size() - 1)
+                {
+                    // some parameters are outside of the tuple
+                    return false;
+                }
+
+                // Only allow the clauses which apply to all rows after it.
+                std::string::size_type const next =
+                    chunk.find_first_not_of(" \t\r\n;", i + 1);
+                if (next != std::string::npos && !is_keyword_at(chunk, next, "on"))
+                {
+                    return false;
+                }
+
+                end = i;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+} // namespace anonymous
+
+
 mysql_statement_backend::mysql_statement_backend(
     mysql_session_backend &session)
-    : session_(session), result_(NULL),
-       rowsAffectedBulk_(-1LL), justDescribed_(false),
+    : session_(session), result_(NULL), stmt_(NULL),
+       rowsAffectedBulk_(-1LL), justDescribed_(false), streamed_(false),
        hasIntoElements_(false), hasVectorIntoElements_(false),
-       hasUseElements_(false), hasVectorUseElements_(false)
+       hasUseElements_(false), hasVectorUseElements_(false),
+       fetchedRow_(-1), batchRow_(-1), batchOffset_(NULL),
+       valuesBegin_(std::string::npos), valuesEnd_(std::string::npos),
+       multiRowStmt_(NULL), multiRowStmtRows_(0)
 {
 }
 
+mysql_statement_backend::~mysql_statement_backend()
+{
+    if (multiRowStmt_ != NULL)
+    {
+        mysql_stmt_close(multiRowStmt_);
+    }
+    if (stmt_ != NULL)
+    {
+        mysql_stmt_close(stmt_);
+    }
+}
+
 void mysql_statement_backend::alloc()
 {
     // nothing to do here.
@@ -38,15 +191,39 @@ void mysql_statement_backend::clean_up()
 
     if (result_ != NULL)
     {
+        // For the streamed results, this also discards the unread rows.
         mysql_free_result(result_);
         result_ = NULL;
+        streamed_ = false;
+    }
+
+    if (stmt_ != NULL)
+    {
+        mysql_stmt_free_result(stmt_);
     }
 }
 
 void mysql_statement_backend::prepare(std::string const & query,
     statement_type /* eType */)
 {
+    // The statement object may be prepared more than once, so release the
+    // results and the server-side statements of the previous query first.
+    clean_up();
+
+    if (multiRowStmt_ != NULL)
+    {
+        mysql_stmt_close(multiRowStmt_);
+        multiRowStmt_ = NULL;
+        multiRowStmtRows_ = 0;
+    }
+    if (stmt_ != NULL)
+    {
+        mysql_stmt_close(stmt_);
+        stmt_ = NULL;
+    }
+
     queryChunks_.clear();
+    names_.clear();
     enum { eNormal, eInQuotes, eInName } state = eNormal;
 
     std::string name;
@@ -117,6 +294,53 @@ void mysql_statement_backend::prepare(std::string const & query,
     {
         names_.push_back(name);
     }
+
+    if (!find_values_tuple(queryChunks_, valuesBegin_, valuesEnd_))
+    {
+        valuesBegin_ = std::string::npos;
+        valuesEnd_ = std::string::npos;
+    }
+
+    if (session_.prepared_statements_)
+    {
+        // Named parameters are replaced with the positional placeholders
+        // understood by the server.
+        std::string psQuery = queryChunks_.front();
+        for (std::size_t i = 1; i < queryChunks_.size(); ++i)
+        {
+            psQuery += '?';
+            psQuery += queryChunks_[i];
+        }
+        if (queryChunks_.size() == names_.size())
+        {
+            // the query ends with a named parameter
+            psQuery += '?';
+        }
+
+        stmt_ = mysql_stmt_init(session_.conn_);
+        if (stmt_ == NULL)
+        {
+            throw mysql_soci_error(mysql_error(session_.conn_),
+                mysql_errno(session_.conn_));
+        }
+
+        if (0 != mysql_stmt_prepare(stmt_, psQuery.c_str(),
+                static_cast<unsigned long>(psQuery.size())))
+        {
+            std::string const errMsg = mysql_stmt_error(stmt_);
+            unsigned int const errNum = mysql_stmt_errno(stmt_);
+
+            mysql_stmt_close(stmt_);
+            stmt_ = NULL;
+
+            // Not all statements can be prepared by the server, just execute
+            // these ones in the usual way.
+            if (errNum != 1295) // ER_UNSUPPORTED_PS
+            {
+                throw mysql_soci_error(errMsg, errNum);
+            }
+        }
+    }
 /*
   cerr << "Chunks: ";
   for (std::vector<std::string>::iterator i = queryChunks_.begin();
@@ -137,6 +361,11 @@ void mysql_statement_backend::prepare(std::string const & query,
 statement_backend::exec_fetch_result
 mysql_statement_backend::execute(int number)
 {
+    if (stmt_ != NULL)
+    {
+        return execute_prepared(number);
+    }
+
     if (justDescribed_ == false)
     {
         clean_up();
@@ -163,49 +392,19 @@ mysql_statement_backend::execute(int number)
                     "Binding for use elements must be either by position "
                     "or by name.");
             }
+            if (numberOfExecutions > 1 && valuesBegin_ != std::string::npos)
+            {
+                // bulk insert, send many rows with each query
+                execute_multi_row(numberOfExecutions);
+                return ef_no_data;
+            }
+
             long long rowsAffectedBulkTemp = -1;
+            std::vector<char *> paramValues;
             for (int i = 0; i != numberOfExecutions; ++i)
             {
-                std::vector<char *> paramValues;
+                get_param_values(i, paramValues);
 
-                if (not useByPosBuffers_.empty())
-                {
-                    // use elements bind by position
-                    // the map of use buffers can be traversed
-                    // in its natural order
-
-                    for (UseByPosBuffersMap::iterator
-                             it = useByPosBuffers_.begin(),
-                             end = useByPosBuffers_.end();
-                         it != end; ++it)
-                    {
-                        char **buffers = it->second;
-                        //cerr<<"i: "<<i<<", buffers[i]: "<<buffers[i]<<endl;
-                        paramValues.push_back(buffers[i]);
-                    }
-                }
-                else
-                {
-                    // use elements bind by name
-
-                    for (std::vector<std::string>::iterator
-                             it = names_.begin(), end = names_.end();
-                         it != end; ++it)
-                    {
-                        UseByNameBuffersMap::iterator b
-                            = useByNameBuffers_.find(*it);
-                        if (b == useByNameBuffers_.end())
-                        {
-                            std::string msg(
-                                "Missing use element for bind by name (");
-                            msg += *it;
-                            msg += ").";
-                            throw soci_error(msg);
-                        }
-                        char **buffers = b->second;
-                        paramValues.push_back(buffers[i]);
-                    }
-                }
                 //cerr << "queryChunks_.size(): "<<queryChunks_.size()<<endl;
                 //cerr << "paramValues.size(): "<<paramValues.size()<<endl;
                 if (queryChunks_.size() != paramValues.size()
@@ -231,27 +430,7 @@ mysql_statement_backend::execute(int number)
                 {
                     // bulk operation
                     //std::cerr << "bulk operation:\n" << query << std::endl;
-                    if (0 != mysql_real_query(session_.conn_, query.c_str(),
-                            static_cast<unsigned long>(query.size())))
-                    {
-                        // preserve the number of rows affected so far.
-                        rowsAffectedBulk_ = rowsAffectedBulkTemp;
-                        throw mysql_soci_error(mysql_error(session_.conn_),
-                            mysql_errno(session_.conn_));
-                    }
-                    else
-                    {
-                        if(rowsAffectedBulkTemp == -1)
-                        {
-                            rowsAffectedBulkTemp = 0;
-                        }
-                        rowsAffectedBulkTemp += static_cast<long long>(mysql_affected_rows(session_.conn_));
-                    }
-                    if (mysql_field_count(session_.conn_) != 0)
-                    {
-                        throw soci_error("The query shouldn't have returned"
-                            " any data but it did.");
-                    }
+                    execute_bulk_query(query, rowsAffectedBulkTemp);
                     query.clear();
                 }
             }
@@ -274,13 +453,16 @@ mysql_statement_backend::execute(int number)
             throw mysql_soci_error(mysql_error(session_.conn_),
                 mysql_errno(session_.conn_));
         }
-        result_ = mysql_store_result(session_.conn_);
+        streamed_ = session_.use_result_;
+        result_ = streamed_
+            ? mysql_use_result(session_.conn_)
+            : mysql_store_result(session_.conn_);
         if (result_ == NULL and mysql_field_count(session_.conn_) != 0)
         {
             throw mysql_soci_error(mysql_error(session_.conn_),
                 mysql_errno(session_.conn_));
         }
-        if (result_ != NULL)
+        if (result_ != NULL and not streamed_)
         {
             // Cache the rows offsets to have random access to the rows later.
             // [mysql_data_seek() is O(n) so we don't want to use it].
@@ -303,6 +485,13 @@ mysql_statement_backend::execute(int number)
         currentRow_ = 0;
         rowsToConsume_ = 0;
 
+        if (streamed_)
+        {
+            // The number of rows is unknown until all of them are read.
+            numberOfRows_ = 0;
+            return number > 0 ? fetch_streamed(number) : ef_success;
+        }
+
         numberOfRows_ = static_cast<int>(mysql_num_rows(result_));
         if (numberOfRows_ == 0)
         {
@@ -329,6 +518,580 @@ mysql_statement_backend::execute(int number)
     }
 }
 
+statement_backend::exec_fetch_result
+mysql_statement_backend::execute_prepared(int number)
+{
+    if (justDescribed_ == false)
+    {
+        clean_up();
+
+        if (number > 1 && hasIntoElements_)
+        {
+             throw soci_error(
+                  "Bulk use with single into elements is not supported.");
+        }
+        // number - size of vectors (into/use)
+        // numberOfExecutions - number of loops to perform
+        int numberOfExecutions = 1;
+        if (number > 0)
+        {
+             numberOfExecutions = hasUseElements_ ? 1 : number;
+        }
+
+        if (not useByPosBinds_.empty() and not useByNameBinds_.empty())
+        {
+            throw soci_error(
+                "Binding for use elements must be either by position "
+                "or by name.");
+        }
+
+        bool const hasParams =
+            not useByPosBinds_.empty() or not useByNameBinds_.empty();
+        if (not hasParams)
+        {
+            numberOfExecutions = 1;
+        }
+
+        long long rowsAffectedBulkTemp = -1;
+        int firstRow = 0;
+        if (numberOfExecutions > 1 && valuesBegin_ != std::string::npos)
+        {
+            // bulk insert, send as many rows as possible with each execution
+            firstRow = execute_prepared_multi_row(numberOfExecutions,
+                rowsAffectedBulkTemp);
+        }
+
+        for (int i = firstRow; i < numberOfExecutions; ++i)
+        {
+            if (hasParams)
+            {
+                get_param_binds(i, paramBinds_);
+
+                if (0 != mysql_stmt_bind_param(stmt_, &paramBinds_[0]))
+                {
+                    throw mysql_soci_error(mysql_stmt_error(stmt_),
+                        mysql_stmt_errno(stmt_));
+                }
+            }
+
+            if (0 != mysql_stmt_execute(stmt_))
+            {
+                // preserve the number of rows affected so far.
+                rowsAffectedBulk_ = rowsAffectedBulkTemp;
+                throw mysql_soci_error(mysql_stmt_error(stmt_),
+                    mysql_stmt_errno(stmt_));
+            }
+
+            if (numberOfExecutions > 1)
+            {
+                // bulk operation
+                if (rowsAffectedBulkTemp == -1)
+                {
+                    rowsAffectedBulkTemp = 0;
+                }
+                rowsAffectedBulkTemp +=
+                    static_cast<long long>(mysql_stmt_affected_rows(stmt_));
+
+                if (mysql_stmt_field_count(stmt_) != 0)
+                {
+                    throw soci_error("The query shouldn't have returned"
+                        " any data but it did.");
+                }
+            }
+        }
+
+        if (numberOfExecutions > 1)
+        {
+            // bulk
+            rowsAffectedBulk_ = rowsAffectedBulkTemp;
+            return ef_no_data;
+        }
+
+        unsigned int const numberOfFields = mysql_stmt_field_count(stmt_);
+        if (numberOfFields != 0)
+        {
+            // Store the entire result on the client to allow accessing its
+            // rows in any order, just as mysql_store_result() does.
+            if (0 != mysql_stmt_store_result(stmt_))
+            {
+                throw mysql_soci_error(mysql_stmt_error(stmt_),
+                    mysql_stmt_errno(stmt_));
+            }
+
+            // The metadata is used for describing the columns.
+            result_ = mysql_stmt_result_metadata(stmt_);
+            if (result_ == NULL)
+            {
+                throw mysql_soci_error(mysql_stmt_error(stmt_),
+                    mysql_stmt_errno(stmt_));
+            }
+
+            // Fixed size values are fetched in their native binary form,
+            // which is cheap, while for all the others we only get their
+            // length, leaving it to the into elements to retrieve them.
+            resultBinds_.resize(numberOfFields);
+            resultValues_.resize(numberOfFields);
+            for (unsigned int i = 0; i != numberOfFields; ++i)
+            {
+                MYSQL_BIND & bind = resultBinds_[i];
+                std::memset(&bind, 0, sizeof(bind));
+                bind.length = &bind.length_value;
+                bind.is_null = &bind.is_null_value;
+                bind.error = &bind.error_value;
+
+                MYSQL_FIELD *field = mysql_fetch_field_direct(result_, i);
+                switch (field->type)
+                {
+                case MYSQL_TYPE_TINY:
+                case MYSQL_TYPE_SHORT:
+                case MYSQL_TYPE_INT24:
+                case MYSQL_TYPE_LONG:
+                case MYSQL_TYPE_LONGLONG:
+                case MYSQL_TYPE_YEAR:
+                    bind.buffer_type = MYSQL_TYPE_LONGLONG;
+                    bind.buffer = &resultValues_[i].ll;
+                    bind.is_unsigned = field->flags & UNSIGNED_FLAG ? 1 : 0;
+                    break;
+                case MYSQL_TYPE_FLOAT:
+                case MYSQL_TYPE_DOUBLE:
+                    bind.buffer_type = MYSQL_TYPE_DOUBLE;
+                    bind.buffer = &resultValues_[i].d;
+                    break;
+                case MYSQL_TYPE_TIMESTAMP:
+                case MYSQL_TYPE_DATE:
+                case MYSQL_TYPE_TIME:
+                case MYSQL_TYPE_DATETIME:
+                case MYSQL_TYPE_NEWDATE:
+                    bind.buffer_type = field->type;
+                    bind.buffer = &resultValues_[i].t;
+                    break;
+                default:
+                    bind.buffer_type = MYSQL_TYPE_STRING;
+                    break;
+                }
+            }
+
+            if (0 != mysql_stmt_bind_result(stmt_, &resultBinds_[0]))
+            {
+                throw mysql_soci_error(mysql_stmt_error(stmt_),
+                    mysql_stmt_errno(stmt_));
+            }
+        }
+    }
+    else
+    {
+        justDescribed_ = false;
+    }
+
+    fetchedRow_ = -1;
+    batchRow_ = -1;
+
+    if (result_ != NULL)
+    {
+        currentRow_ = 0;
+        rowsToConsume_ = 0;
+
+        numberOfRows_ = static_cast<int>(mysql_stmt_num_rows(stmt_));
+        if (numberOfRows_ == 0)
+        {
+            return ef_no_data;
+        }
+        else
+        {
+            if (number > 0)
+            {
+                // prepare for the subsequent data consumption
+                return fetch(number);
+            }
+            else
+            {
+                // execute(0) was meant to only perform the query
+                return ef_success;
+            }
+        }
+    }
+    else
+    {
+        // it was not a SELECT
+        return ef_no_data;
+    }
+}
+
+void mysql_statement_backend::get_param_values(int row,
+    std::vector<char *> & paramValues)
+{
+    paramValues.clear();
+
+    if (not useByPosBuffers_.empty())
+    {
+        // use elements bind by position
+        // the map of use buffers can be traversed
+        // in its natural order
+
+        for (UseByPosBuffersMap::iterator
+                 it = useByPosBuffers_.begin(),
+                 end = useByPosBuffers_.end();
+             it != end; ++it)
+        {
+            char **buffers = it->second;
+            //cerr<<"i: "<<i<<", buffers[i]: "<<buffers[i]<<endl;
+            paramValues.push_back(buffers[row]);
+        }
+    }
+    else
+    {
+        // use elements bind by name
+
+        for (std::vector<std::string>::iterator
+                 it = names_.begin(), end = names_.end();
+             it != end; ++it)
+        {
+            UseByNameBuffersMap::iterator b
+                = useByNameBuffers_.find(*it);
+            if (b == useByNameBuffers_.end())
+            {
+                std::string msg(
+                    "Missing use element for bind by name (");
+                msg += *it;
+                msg += ").";
+                throw soci_error(msg);
+            }
+            char **buffers = b->second;
+            paramValues.push_back(buffers[row]);
+        }
+    }
+}
+
+void mysql_statement_backend::get_param_binds(int row,
+    std::vector<MYSQL_BIND> & paramBinds)
+{
+    paramBinds.clear();
+
+    if (not useByPosBinds_.empty())
+    {
+        // use elements bind by position
+        for (UseByPosBindsMap::iterator
+                 it = useByPosBinds_.begin(),
+                 end = useByPosBinds_.end();
+             it != end; ++it)
+        {
+            paramBinds.push_back(it->second[row]);
+        }
+    }
+    else
+    {
+        // use elements bind by name
+        for (std::vector<std::string>::iterator
+                 it = names_.begin(), end = names_.end();
+             it != end; ++it)
+        {
+            UseByNameBindsMap::iterator b
+                = useByNameBinds_.find(*it);
+            if (b == useByNameBinds_.end())
+            {
+                std::string msg(
+                    "Missing use element for bind by name (");
+                msg += *it;
+                msg += ").";
+                throw soci_error(msg);
+            }
+            paramBinds.push_back(b->second[row]);
+        }
+    }
+
+    if (paramBinds.size() != mysql_stmt_param_count(stmt_))
+    {
+        throw soci_error("Wrong number of parameters.");
+    }
+}
+
+void mysql_statement_backend::append_values_tuple(std::string & query,
+    std::vector<char *> const & paramValues) const
+{
+    std::size_t const numChunks = queryChunks_.size();
+    if (numChunks != paramValues.size() + 1)
+    {
+        throw soci_error("Wrong number of parameters.");
+    }
+
+    for (std::size_t n = 0; n != numChunks; ++n)
+    {
+        std::string const & chunk = queryChunks_[n];
+        std::string::size_type const begin = n == 0 ? valuesBegin_ : 0;
+        std::string::size_type const end =
+            n == numChunks - 1 ? valuesEnd_ + 1 : chunk.size();
+        query.append(chunk, begin, end - begin);
+        if (n != paramValues.size())
+        {
+            query += paramValues[n];
+        }
+    }
+}
+
+void mysql_statement_backend::execute_bulk_query(std::string const & query,
+    long long & rowsAffected)
+{
+    if (0 != mysql_real_query(session_.conn_, query.c_str(),
+            static_cast<unsigned long>(query.size())))
+    {
+        // preserve the number of rows affected so far.
+        rowsAffectedBulk_ = rowsAffected;
+        throw mysql_soci_error(mysql_error(session_.conn_),
+            mysql_errno(session_.conn_));
+    }
+    else
+    {
+        if (rowsAffected == -1)
+        {
+            rowsAffected = 0;
+        }
+        rowsAffected += static_cast<long long>(mysql_affected_rows(session_.conn_));
+    }
+    if (mysql_field_count(session_.conn_) != 0)
+    {
+        throw soci_error("The query shouldn't have returned"
+            " any data but it did.");
+    }
+}
+
+void mysql_statement_backend::execute_multi_row(int numberOfRows)
+{
+    // Rows are accumulated in a single "INSERT ... VALUES (...), (...)"
+    // query for as long as it fits in the maximal packet size accepted by
+    // the server (leaving some room for the packet header).
+    std::string const head = queryChunks_.front().substr(0, valuesBegin_);
+    std::string const tail = queryChunks_.back().substr(valuesEnd_ + 1);
+    std::size_t const maxQuerySize = session_.get_max_allowed_packet() - 64;
+
+    long long rowsAffectedBulkTemp = -1;
+    std::vector<char *> paramValues;
+    std::string query;
+    std::string tuple;
+    int rowsInQuery = 0;
+    for (int i = 0; i != numberOfRows; ++i)
+    {
+        get_param_values(i, paramValues);
+
+        tuple.clear();
+        append_values_tuple(tuple, paramValues);
+
+        if (rowsInQuery != 0 &&
+            query.size() + 1 + tuple.size() + tail.size() > maxQuerySize)
+        {
+            query += tail;
+            execute_bulk_query(query, rowsAffectedBulkTemp);
+            rowsInQuery = 0;
+        }
+
+        if (rowsInQuery == 0)
+        {
+            query = head;
+        }
+        else
+        {
+            query += ',';
+        }
+        query += tuple;
+        ++rowsInQuery;
+    }
+
+    query += tail;
+    execute_bulk_query(query, rowsAffectedBulkTemp);
+
+    rowsAffectedBulk_ = rowsAffectedBulkTemp;
+}
+
+MYSQL_STMT * mysql_statement_backend::prepare_multi_row(int numberOfRows)
+{
+    char placeholder[] = "?";
+    std::vector<char *> const placeholders(names_.size(), placeholder);
+
+    std::string query = queryChunks_.front().substr(0, valuesBegin_);
+    for (int i = 0; i != numberOfRows; ++i)
+    {
+        if (i != 0)
+        {
+            query += ',';
+        }
+        append_values_tuple(query, placeholders);
+    }
+    query += queryChunks_.back().substr(valuesEnd_ + 1);
+
+    MYSQL_STMT *stmt = mysql_stmt_init(session_.conn_);
+    if (stmt == NULL)
+    {
+        throw mysql_soci_error(mysql_error(session_.conn_),
+            mysql_errno(session_.conn_));
+    }
+
+    if (0 != mysql_stmt_prepare(stmt, query.c_str(),
+            static_cast<unsigned long>(query.size())))
+    {
+        std::string const errMsg = mysql_stmt_error(stmt);
+        unsigned int const errNum = mysql_stmt_errno(stmt);
+        mysql_stmt_close(stmt);
+        throw mysql_soci_error(errMsg, errNum);
+    }
+
+    return stmt;
+}
+
+void mysql_statement_backend::execute_multi_row_stmt(MYSQL_STMT *stmt,
+    int firstRow, int numberOfRows, long long & rowsAffected)
+{
+    multiRowBinds_.clear();
+    for (int i = firstRow; i != firstRow + numberOfRows; ++i)
+    {
+        get_param_binds(i, paramBinds_);
+        multiRowBinds_.insert(multiRowBinds_.end(),
+            paramBinds_.begin(), paramBinds_.end());
+    }
+
+    if (0 != mysql_stmt_bind_param(stmt, &multiRowBinds_[0]) ||
+        0 != mysql_stmt_execute(stmt))
+    {
+        // preserve the number of rows affected so far.
+        rowsAffectedBulk_ = rowsAffected;
+        throw mysql_soci_error(mysql_stmt_error(stmt),
+            mysql_stmt_errno(stmt));
+    }
+
+    if (rowsAffected == -1)
+    {
+        rowsAffected = 0;
+    }
+    rowsAffected += static_cast<long long>(mysql_stmt_affected_rows(stmt));
+}
+
+int mysql_statement_backend::execute_prepared_multi_row(int numberOfRows,
+    long long & rowsAffected)
+{
+    unsigned long const paramsPerRow = mysql_stmt_param_count(stmt_);
+    if (paramsPerRow == 0)
+    {
+        return 0;
+    }
+
+    // Estimate the size of the biggest row in the execute packet, which
+    // contains the type and the (length-prefixed) value of each parameter.
+    std::size_t maxRowSize = 1;
+    for (int i = 0; i != numberOfRows; ++i)
+    {
+        get_param_binds(i, paramBinds_);
+
+        std::size_t rowSize = 0;
+        for (std::size_t n = 0; n != paramBinds_.size(); ++n)
+        {
+            rowSize += paramBinds_[n].buffer_type == MYSQL_TYPE_STRING
+                ? paramBinds_[n].buffer_length + 11 : 16;
+        }
+        if (rowSize > maxRowSize)
+        {
+            maxRowSize = rowSize;
+        }
+    }
+
+    // The number of placeholders in a statement is limited to 65535.
+    std::size_t rowsPerQuery =
+        (session_.get_max_allowed_packet() - 64) / maxRowSize;
+    if (rowsPerQuery > 65535 / paramsPerRow)
+    {
+        rowsPerQuery = 65535 / paramsPerRow;
+    }
+    if (rowsPerQuery > static_cast<std::size_t>(numberOfRows))
+    {
+        rowsPerQuery = numberOfRows;
+    }
+    if (rowsPerQuery < 2)
+    {
+        return 0;
+    }
+
+    int const rows = static_cast<int>(rowsPerQuery);
+
+    // Keep the statement used for the full batches of rows prepared, as
+    // repeated bulk operations typically use vectors of the same size.
+    if (multiRowStmt_ == NULL || multiRowStmtRows_ != rows)
+    {
+        if (multiRowStmt_ != NULL)
+        {
+            mysql_stmt_close(multiRowStmt_);
+            multiRowStmt_ = NULL;
+        }
+        multiRowStmt_ = prepare_multi_row(rows);
+        multiRowStmtRows_ = rows;
+    }
+
+    int row = 0;
+    for (; numberOfRows - row >= rows; row += rows)
+    {
+        execute_multi_row_stmt(multiRowStmt_, row, rows, rowsAffected);
+    }
+
+    int const remaining = numberOfRows - row;
+    if (remaining > 1)
+    {
+        MYSQL_STMT *stmt = prepare_multi_row(remaining);
+        try
+        {
+            execute_multi_row_stmt(stmt, row, remaining, rowsAffected);
+        }
+        catch (...)
+        {
+            mysql_stmt_close(stmt);
+            throw;
+        }
+        mysql_stmt_close(stmt);
+        row += remaining;
+    }
+
+    return row;
+}
+
+void mysql_statement_backend::fetch_prepared_row(int row)
+{
+    if (row == fetchedRow_)
+    {
+        return;
+    }
+
+    if (row != fetchedRow_ + 1)
+    {
+        // Several into vectors consume the same rows, so we need to go back
+        // to the beginning of the batch. Notice that mysql_stmt_data_seek()
+        // is O(n), so avoid it if possible.
+        if (row == batchRow_)
+        {
+            mysql_stmt_row_seek(stmt_, batchOffset_);
+        }
+        else
+        {
+            mysql_stmt_data_seek(stmt_, static_cast<unsigned long long>(row));
+        }
+    }
+
+    if (row == currentRow_)
+    {
+        batchRow_ = row;
+        batchOffset_ = mysql_stmt_row_tell(stmt_);
+    }
+
+    // Truncation is expected as we don't provide buffers for the variable
+    // length columns.
+    int const res = mysql_stmt_fetch(stmt_);
+    if (res == 1)
+    {
+        throw mysql_soci_error(mysql_stmt_error(stmt_),
+            mysql_stmt_errno(stmt_));
+    }
+    if (res == MYSQL_NO_DATA)
+    {
+        throw soci_error("No more rows in the result.");
+    }
+
+    fetchedRow_ = row;
+}
+
 statement_backend::exec_fetch_result
 mysql_statement_backend::fetch(int number)
 {
@@ -337,6 +1100,12 @@ mysql_statement_backend::fetch(int number)
     // function, and the actual consumption of this data will take place
     // in the postFetch functions, called for each into element.
     // Here, we only prepare for this to happen (to emulate "the Oracle way").
+    // The streamed results are the exception, see fetch_streamed().
+
+    if (streamed_)
+    {
+        return fetch_streamed(number);
+    }
 
     // forward the "cursor" from the last fetch
     currentRow_ += rowsToConsume_;
@@ -365,12 +1134,112 @@ mysql_statement_backend::fetch(int number)
     }
 }
 
+statement_backend::exec_fetch_result
+mysql_statement_backend::fetch_streamed(int number)
+{
+    // Read the next batch of rows from the server. Unlike the stored results,
+    // the rows can't be accessed again later, so they're kept here until
+    // they're consumed by the into elements in their post_fetch().
+
+    unsigned int const numFields = mysql_num_fields(result_);
+
+    currentRow_ = 0;
+    rowsToConsume_ = 0;
+    streamedRows_.clear();
+    streamedLengths_.clear();
+    streamedOffsets_.clear();
+    streamedData_.clear();
+
+    for (int i = 0; i != number; ++i)
+    {
+        MYSQL_ROW row = mysql_fetch_row(result_);
+        if (row == NULL)
+        {
+            if (mysql_errno(session_.conn_) != 0)
+            {
+                throw mysql_soci_error(mysql_error(session_.conn_),
+                    mysql_errno(session_.conn_));
+            }
+
+            break;
+        }
+
+        unsigned long *lengths = mysql_fetch_lengths(result_);
+        streamedLengths_.insert(streamedLengths_.end(),
+            lengths, lengths + numFields);
+
+        if (number == 1)
+        {
+            // The row remains valid until the next call to mysql_fetch_row(),
+            // i.e. until the next fetch, so there is no need to copy it.
+            streamedRows_.assign(row, row + numFields);
+        }
+        else
+        {
+            for (unsigned int j = 0; j != numFields; ++j)
+            {
+                if (row[j] == NULL)
+                {
+                    streamedOffsets_.push_back(std::string::npos);
+                }
+                else
+                {
+                    streamedOffsets_.push_back(streamedData_.size());
+                    streamedData_.insert(streamedData_.end(),
+                        row[j], row[j] + lengths[j]);
+                    streamedData_.push_back('\0');
+                }
+            }
+        }
+
+        ++rowsToConsume_;
+    }
+
+    if (number != 1)
+    {
+        // Only take the addresses once all the data was copied, as the
+        // buffer could have been reallocated in the meanwhile.
+        streamedRows_.resize(streamedOffsets_.size());
+        for (std::size_t i = 0; i != streamedOffsets_.size(); ++i)
+        {
+            streamedRows_[i] = streamedOffsets_[i] == std::string::npos
+                ? NULL
+                : &streamedData_[streamedOffsets_[i]];
+        }
+    }
+
+    numberOfRows_ = rowsToConsume_;
+
+    // As for the stored results, return ef_no_data when EOF is hit, even if
+    // some rows were fetched.
+    return rowsToConsume_ < number ? ef_no_data : ef_success;
+}
+
+MYSQL_ROW mysql_statement_backend::get_row(int row, unsigned long *& lengths)
+{
+    if (streamed_)
+    {
+        std::size_t const first = row * mysql_num_fields(result_);
+        lengths = &streamedLengths_[first];
+        return &streamedRows_[first];
+    }
+
+    mysql_row_seek(result_, resultRowOffsets_[row]);
+    MYSQL_ROW r = mysql_fetch_row(result_);
+    lengths = mysql_fetch_lengths(result_);
+    return r;
+}
+
 long long mysql_statement_backend::get_affected_rows()
 {
     if (rowsAffectedBulk_ >= 0)
     {
         return rowsAffectedBulk_;
     }
+    if (stmt_ != NULL)
+    {
+        return static_cast<long long>(mysql_stmt_affected_rows(stmt_));
+    }
     return static_cast<long long>(mysql_affected_rows(session_.conn_));
 }
 
@@ -394,10 +1263,15 @@ std::string mysql_statement_backend::rewrite_for_procedure_call(
 
 int mysql_statement_backend::prepare_for_describe()
 {
-    execute(1);
+    // Only perform the query: the rows will be fetched by the execution
+    // immediately following the description, which matters for the streamed
+    // results as they can't be rewound.
+    execute(0);
     justDescribed_ = true;
 
-    int columns = mysql_field_count(session_.conn_);
+    int columns = stmt_ != NULL
+        ? static_cast<int>(mysql_stmt_field_count(stmt_))
+        : static_cast<int>(mysql_field_count(session_.conn_));
     return columns;
 }
 
@@ -455,6 +1329,26 @@ void mysql_statement_backend::describe_column(int colNum,
     columnName = field->name;
 }
 
+void mysql_statement_backend::reset_for_reuse()
+{
+    // Free the result, notably discarding the unread rows of the streamed
+    // results which would otherwise prevent executing any other queries on
+    // this connection, and forget everything about the elements.
+    clean_up();
+    justDescribed_ = false;
+
+    // the buffers belong to the use elements which don't exist any more
+    useByPosBuffers_.clear();
+    useByNameBuffers_.clear();
+    useByPosBinds_.clear();
+    useByNameBinds_.clear();
+
+    hasIntoElements_ = false;
+    hasVectorIntoElements_ = false;
+    hasUseElements_ = false;
+    hasVectorUseElements_ = false;
+}
+
 mysql_standard_into_type_backend *
 mysql_statement_backend::make_into_type_backend()
 {
@@ -50,6 +50,12 @@ void mysql_vector_into_type_backend::post_fetch(bool gotData, indicator *ind)
 {
     if (gotData)
     {
+        if (statement_.stmt_ != NULL)
+        {
+            post_fetch_prepared(ind);
+            return;
+        }
+
         // Here, rowsToConsume_ in the Statement object designates
         // the number of rows that need to be put in the user's buffers.
 
@@ -58,13 +64,11 @@ void mysql_vector_into_type_backend::post_fetch(bool gotData, indicator *ind)
 
         int const endRow = statement_.currentRow_ + statement_.rowsToConsume_;
 
-        //mysql_data_seek(statement_.result_, statement_.currentRow_);
-        mysql_row_seek(statement_.result_,
-            statement_.resultRowOffsets_[statement_.currentRow_]);
         for (int curRow = statement_.currentRow_, i = 0;
              curRow != endRow; ++curRow, ++i)
         {
-            MYSQL_ROW row = mysql_fetch_row(statement_.result_);
+            unsigned long *lengths;
+            MYSQL_ROW row = statement_.get_row(curRow, lengths);
             // first, deal with indicators
             if (row[pos] == NULL)
             {
@@ -97,8 +101,6 @@ void mysql_vector_into_type_backend::post_fetch(bool gotData, indicator *ind)
                 break;
             case x_stdstring:
                 {
-                    unsigned long * lengths =
-                        mysql_fetch_lengths(statement_.result_);
                     // Not sure if it's necessary, but the code below is used
                     // instead of
                     // set_invector_(data_, i, std::string(buf, lengths[pos]);
@@ -167,6 +169,75 @@ void mysql_vector_into_type_backend::post_fetch(bool gotData, indicator *ind)
 namespace // anonymous
 {
 
+template <typename T>
+void *get_invector_(void *p, int indx)
+{
+    std::vector<T> *dest = static_cast<std::vector<T> *>(p);
+    return &(*dest)[indx];
+}
+
+} // namespace anonymous
+
+void mysql_vector_into_type_backend::post_fetch_prepared(indicator *ind)
+{
+    // MySQL column positions start at 0
+    int pos = position_ - 1;
+
+    int const endRow = statement_.currentRow_ + statement_.rowsToConsume_;
+
+    for (int curRow = statement_.currentRow_, i = 0;
+         curRow != endRow; ++curRow, ++i)
+    {
+        statement_.fetch_prepared_row(curRow);
+
+        // first, deal with indicators
+        if (*statement_.resultBinds_[pos].is_null)
+        {
+            if (ind == NULL)
+            {
+                throw soci_error(
+                    "Null value fetched and no indicator defined.");
+            }
+
+            ind[i] = i_null;
+
+            // no need to convert data if it is null, go to next row
+            continue;
+        }
+        else
+        {
+            if (ind != NULL)
+            {
+                ind[i] = i_ok;
+            }
+        }
+
+        // the value is retrieved in binary form directly into the vector
+        void *elem = NULL;
+        switch (type_)
+        {
+        case x_char:      elem = get_invector_<char>(data_, i); break;
+        case x_stdstring: elem = get_invector_<std::string>(data_, i); break;
+        case x_short:     elem = get_invector_<short>(data_, i); break;
+        case x_integer:   elem = get_invector_<int>(data_, i); break;
+        case x_long_long: elem = get_invector_<long long>(data_, i); break;
+        case x_unsigned_long_long:
+            elem = get_invector_<unsigned long long>(data_, i);
+            break;
+        case x_double:    elem = get_invector_<double>(data_, i); break;
+        case x_stdtm:     elem = get_invector_<std::tm>(data_, i); break;
+
+        default:
+            throw soci_error("Into element used with non-supported type.");
+        }
+
+        fetch_column(statement_, pos, type_, elem);
+    }
+}
+
+namespace // anonymous
+{
+
 template <typename T>
 void resizevector_(void *p, std::size_t sz)
 {
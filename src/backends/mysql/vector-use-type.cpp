@@ -43,9 +43,72 @@ void mysql_vector_use_type_backend::bind_by_name(
     name_ = name;
 }
 
+namespace // anonymous
+{
+
+template <typename T>
+void *get_invector_(void *p, std::size_t indx)
+{
+    std::vector<T> *src = static_cast<std::vector<T> *>(p);
+    return &(*src)[indx];
+}
+
+} // namespace anonymous
+
 void mysql_vector_use_type_backend::pre_use(indicator const *ind)
 {
+    // release the buffers from the previous execution, if any
+    clean_up();
+
     std::size_t const vsize = size();
+
+    if (statement_.stmt_ != NULL)
+    {
+        // the values are sent in binary form, without copying them
+        binds_.resize(vsize);
+        if (type_ == x_stdtm)
+        {
+            times_.resize(vsize);
+        }
+
+        for (std::size_t i = 0; i != vsize; ++i)
+        {
+            void *elem = NULL;
+            switch (type_)
+            {
+            case x_char:      elem = get_invector_<char>(data_, i); break;
+            case x_stdstring: elem = get_invector_<std::string>(data_, i); break;
+            case x_short:     elem = get_invector_<short>(data_, i); break;
+            case x_integer:   elem = get_invector_<int>(data_, i); break;
+            case x_long_long: elem = get_invector_<long long>(data_, i); break;
+            case x_unsigned_long_long:
+                elem = get_invector_<unsigned long long>(data_, i);
+                break;
+            case x_double:    elem = get_invector_<double>(data_, i); break;
+            case x_stdtm:     elem = get_invector_<std::tm>(data_, i); break;
+
+            default:
+                throw soci_error(
+                    "Use vector element used with non-supported type.");
+            }
+
+            MYSQL_TIME dummy;
+            bind_param(binds_[i], type_ == x_stdtm ? times_[i] : dummy,
+                type_, elem, ind != NULL && ind[i] == i_null);
+        }
+
+        if (position_ > 0)
+        {
+            statement_.useByPosBinds_[position_] = &binds_[0];
+        }
+        else
+        {
+            statement_.useByNameBinds_[name_] = &binds_[0];
+        }
+
+        return;
+    }
+
     for (size_t i = 0; i != vsize; ++i)
     {
         char *buf;
@@ -214,4 +277,5 @@ void mysql_vector_use_type_backend::clean_up()
     {
         delete [] buffers_[i];
     }
+    buffers_.clear();
 }
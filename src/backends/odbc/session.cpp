@@ -16,11 +16,21 @@ using namespace soci;
 using namespace soci::details;
 
 char const * soci::odbc_option_driver_complete = "odbc.driver_complete";
+char const * soci::odbc_option_long_column_buffer_size = "odbc.long_column_buffer_size";
+char const * soci::odbc_option_fetch_buffer_limit = "odbc.fetch_buffer_limit";
 
 odbc_session_backend::odbc_session_backend(
     connection_parameters const & parameters)
-    : henv_(0), hdbc_(0), product_(prod_uninitialized)
+    : henv_(0), hdbc_(0),
+      longColumnBufferSize_(ODBC_MAX_COL_SIZE), fetchBufferLimit_(0),
+      product_(prod_uninitialized),
+      getDataExtensions_(0), getDataExtensionsKnown_(false)
 {
+    parameters.get_size_option(odbc_option_long_column_buffer_size,
+        longColumnBufferSize_);
+    parameters.get_size_option(odbc_option_fetch_buffer_limit,
+        fetchBufferLimit_);
+
     SQLRETURN rc;
 
     // Allocate environment handle
@@ -199,6 +209,15 @@ void odbc_session_backend::rollback()
     reset_transaction();
 }
 
+bool odbc_session_backend::is_connected()
+{
+    SQLUINTEGER dead = SQL_CD_TRUE;
+    SQLRETURN rc = SQLGetConnectAttr(hdbc_, SQL_ATTR_CONNECTION_DEAD,
+        &dead, 0, NULL);
+
+    return !is_odbc_error(rc) && dead == SQL_CD_FALSE;
+}
+
 bool odbc_session_backend::get_next_sequence_value(
     session & s, std::string const & sequence, long long & value)
 {
@@ -406,3 +425,26 @@ odbc_session_backend::get_database_product() const
 
     return product_;
 }
+
+bool odbc_session_backend::can_get_data_for_bound_columns(bool blockCursor) const
+{
+    if (!getDataExtensionsKnown_)
+    {
+        SQLUINTEGER extensions = 0;
+        SQLRETURN rc = SQLGetInfo(hdbc_, SQL_GETDATA_EXTENSIONS, &extensions,
+                                  sizeof(extensions), NULL);
+
+        // Don't fail if the driver doesn't support this query, just don't
+        // rely on the extensions in this case.
+        getDataExtensions_ = is_odbc_error(rc) ? 0 : extensions;
+        getDataExtensionsKnown_ = true;
+    }
+
+    SQLUINTEGER required = SQL_GD_BOUND;
+    if (blockCursor)
+    {
+        required |= SQL_GD_BLOCK;
+    }
+
+    return (getDataExtensions_ & required) == required;
+}
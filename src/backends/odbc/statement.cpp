@@ -7,6 +7,7 @@
 
 #define SOCI_ODBC_SOURCE
 #include "soci/odbc/soci-odbc.h"
+#include <algorithm>
 #include <cctype>
 #include <sstream>
 #include <cstring>
@@ -18,7 +19,7 @@ using namespace soci::details;
 odbc_statement_backend::odbc_statement_backend(odbc_session_backend &session)
     : session_(session), hstmt_(0), numRowsFetched_(0),
       hasVectorUseElements_(false), boundByName_(false), boundByPos_(false),
-      rowsAffected_(-1LL)
+      rowsAffected_(-1LL), rowArraySize_(0)
 {
 }
 
@@ -33,11 +34,15 @@ void odbc_statement_backend::alloc()
         throw odbc_soci_error(SQL_HANDLE_DBC, session_.hdbc_,
                               "allocating statement");
     }
+
+    // the new handle has the default attributes
+    rowArraySize_ = 0;
 }
 
 void odbc_statement_backend::clean_up()
 {
     rowsAffected_ = -1LL;
+    bufferedIntos_.clear();
 
     SQLFreeHandle(SQL_HANDLE_STMT, hstmt_);
 }
@@ -214,11 +219,23 @@ statement_backend::exec_fetch_result
 odbc_statement_backend::fetch(int number)
 {
     numRowsFetched_ = 0;
-    SQLULEN const row_array_size = static_cast<SQLULEN>(number);
+    SQLULEN const row_array_size
+        = static_cast<SQLULEN>(bind_buffered_intos(number));
+
+    // The attributes are preserved between fetches, so only set them when
+    // fetching for the first time or when the number of rows changes.
+    if (rowArraySize_ == 0)
+    {
+        SQLSetStmtAttr(hstmt_, SQL_ATTR_ROW_BIND_TYPE, SQL_BIND_BY_COLUMN, 0);
+        SQLSetStmtAttr(hstmt_, SQL_ATTR_ROWS_FETCHED_PTR, &numRowsFetched_, 0);
+    }
 
-    SQLSetStmtAttr(hstmt_, SQL_ATTR_ROW_BIND_TYPE, SQL_BIND_BY_COLUMN, 0);
-    SQLSetStmtAttr(hstmt_, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)row_array_size, 0);
-    SQLSetStmtAttr(hstmt_, SQL_ATTR_ROWS_FETCHED_PTR, &numRowsFetched_, 0);
+    if (row_array_size != rowArraySize_)
+    {
+        SQLRETURN const rc = SQLSetStmtAttr(hstmt_, SQL_ATTR_ROW_ARRAY_SIZE,
+                                            (SQLPOINTER)row_array_size, 0);
+        rowArraySize_ = is_odbc_error(rc) ? 0 : row_array_size;
+    }
 
     SQLRETURN rc = SQLFetch(hstmt_);
 
@@ -235,6 +252,40 @@ odbc_statement_backend::fetch(int number)
     return ef_success;
 }
 
+int odbc_statement_backend::bind_buffered_intos(int number)
+{
+    if (bufferedIntos_.empty())
+    {
+        return number;
+    }
+
+    std::size_t rows = static_cast<std::size_t>(number);
+
+    std::size_t const limit = session_.fetchBufferLimit_;
+    if (limit != 0)
+    {
+        std::size_t rowSize = 0;
+        for (std::size_t i = 0; i != bufferedIntos_.size(); ++i)
+        {
+            rowSize += bufferedIntos_[i]->colSize_;
+        }
+
+        // always fetch at least one row, even if it exceeds the limit
+        std::size_t const maxRows = (std::max)(limit / rowSize, std::size_t(1));
+        if (rows > maxRows)
+        {
+            rows = maxRows;
+        }
+    }
+
+    for (std::size_t i = 0; i != bufferedIntos_.size(); ++i)
+    {
+        bufferedIntos_[i]->bind_buffer(rows);
+    }
+
+    return static_cast<int>(rows);
+}
+
 long long odbc_statement_backend::get_affected_rows()
 {
     return rowsAffected_;
@@ -343,6 +394,24 @@ std::size_t odbc_statement_backend::column_size(int colNum)
     return colSize;
 }
 
+void odbc_statement_backend::add_buffered_into(
+    odbc_vector_into_type_backend *into)
+{
+    if (std::find(bufferedIntos_.begin(), bufferedIntos_.end(), into)
+            == bufferedIntos_.end())
+    {
+        bufferedIntos_.push_back(into);
+    }
+}
+
+void odbc_statement_backend::remove_buffered_into(
+    odbc_vector_into_type_backend *into)
+{
+    bufferedIntos_.erase(
+        std::remove(bufferedIntos_.begin(), bufferedIntos_.end(), into),
+        bufferedIntos_.end());
+}
+
 odbc_standard_into_type_backend * odbc_statement_backend::make_into_type_backend()
 {
     return new odbc_standard_into_type_backend(*this);
@@ -15,6 +15,8 @@
 #include <cstring>
 #include <ctime>
 #include <sstream>
+#include <string>
+#include <vector>
 #include <stdio.h>  // sscanf()
 
 using namespace soci;
@@ -145,16 +147,31 @@ void odbc_vector_into_type_backend::define_by_pos(
             odbcType_ = SQL_C_CHAR;
             std::vector<std::string> *v
                 = static_cast<std::vector<std::string> *>(data);
-            colSize_ = get_sqllen_from_value(statement_.column_size(position)) + 1;
-            std::size_t bufSize = colSize_ * v->size();
-            buf_ = new char[bufSize];
+
+            // Don't allocate buffers for the entire column size if it's too
+            // big (or unknown, which is indicated by 0), but only for the
+            // values of reasonable size, if we can retrieve the longer values
+            // separately.
+            SQLLEN const columnSize
+                = get_sqllen_from_value(statement_.column_size(position));
+            std::size_t const maxSize
+                = statement_.session_.longColumnBufferSize_;
+
+            longColumn_ = maxSize != 0
+                && (columnSize <= 0 || static_cast<std::size_t>(columnSize) > maxSize)
+                && statement_.session_.can_get_data_for_bound_columns(v->size() > 1);
+
+            colSize_ = longColumn_ ? maxSize + 1
+                                   : static_cast<std::size_t>(columnSize) + 1;
 
             prepare_indicators(v->size());
 
-            size = static_cast<SQLINTEGER>(colSize_);
-            data = buf_;
+            // The buffer is allocated and bound only when fetching, see
+            // bind_buffer().
+            position_ = position++;
+            statement_.add_buffered_into(this);
         }
-        break;
+        return;
     case x_stdtm:
         {
             odbcType_ = SQL_C_TYPE_TIMESTAMP;
@@ -188,6 +205,98 @@ void odbc_vector_into_type_backend::define_by_pos(
     }
 }
 
+void odbc_vector_into_type_backend::bind_buffer(std::size_t rows)
+{
+    if (buf_ != NULL && rows <= bufRows_)
+    {
+        // the existing buffer is big enough and is already bound
+        return;
+    }
+
+    delete [] buf_;
+    buf_ = NULL;
+    bufRows_ = 0;
+
+    buf_ = new char[colSize_ * rows];
+    bufRows_ = rows;
+
+    SQLRETURN rc
+        = SQLBindCol(statement_.hstmt_, static_cast<SQLUSMALLINT>(position_),
+                odbcType_, static_cast<SQLPOINTER>(buf_),
+                static_cast<SQLLEN>(colSize_), indHolders_);
+    if (is_odbc_error(rc))
+    {
+        std::ostringstream ss;
+        ss << "binding output vector column #" << position_;
+        throw odbc_soci_error(SQL_HANDLE_STMT, statement_.hstmt_, ss.str());
+    }
+}
+
+void odbc_vector_into_type_backend::get_long_column_data(
+    std::size_t row, std::string &value)
+{
+    // SQLGetData() works with the current row, so select it if we fetched
+    // more than one row.
+    if (statement_.numRowsFetched_ > 1)
+    {
+        SQLRETURN rc = SQLSetPos(statement_.hstmt_,
+            static_cast<SQLSETPOSIROW>(row + 1), SQL_POSITION, SQL_LOCK_NO_CHANGE);
+        if (is_odbc_error(rc))
+        {
+            std::ostringstream ss;
+            ss << "positioning on row #" << row + 1
+               << " to get data of long column #" << position_;
+            throw odbc_soci_error(SQL_HANDLE_STMT, statement_.hstmt_, ss.str());
+        }
+    }
+
+    value.clear();
+
+    std::vector<char> buf(colSize_);
+    for (;;)
+    {
+        SQLLEN len = 0;
+        SQLRETURN rc = SQLGetData(statement_.hstmt_,
+            static_cast<SQLUSMALLINT>(position_), SQL_C_CHAR,
+            &buf[0], static_cast<SQLLEN>(buf.size()), &len);
+        if (rc == SQL_NO_DATA)
+        {
+            break;
+        }
+
+        if (is_odbc_error(rc))
+        {
+            std::ostringstream ss;
+            ss << "getting data of long column #" << position_;
+            throw odbc_soci_error(SQL_HANDLE_STMT, statement_.hstmt_, ss.str());
+        }
+
+        len = get_sqllen_from_value(len);
+        if (len == SQL_NULL_DATA)
+        {
+            break;
+        }
+
+        // The buffer always contains the trailing NUL.
+        std::size_t const chunkLen = buf.size() - 1;
+        if (rc == SQL_SUCCESS ||
+                (len != SQL_NO_TOTAL && static_cast<std::size_t>(len) <= chunkLen))
+        {
+            value.append(&buf[0], static_cast<std::size_t>(len));
+            break;
+        }
+
+        value.append(&buf[0], chunkLen);
+
+        // If we know the total length of the remaining data, retrieve all of
+        // it at once.
+        if (len != SQL_NO_TOTAL)
+        {
+            buf.resize(static_cast<std::size_t>(len) - chunkLen + 1);
+        }
+    }
+}
+
 void odbc_vector_into_type_backend::pre_fetch()
 {
     // nothing to do for the supported types
@@ -234,6 +343,17 @@ void odbc_vector_into_type_backend::post_fetch(bool gotData, indicator *ind)
                     continue;
                 }
 
+                if (longColumn_ &&
+                        (len == SQL_NO_TOTAL || static_cast<std::size_t>(len) >= colSize_))
+                {
+                    // Value didn't fit into the buffer, get all of it now.
+                    get_long_column_data(i, v[i]);
+
+                    // Update the indicator which could be SQL_NO_TOTAL.
+                    set_sqllen_from_vector_at(i, static_cast<SQLLEN>(v[i].size()));
+                    continue;
+                }
+
                 // Find the actual length of the string: for a VARCHAR(N)
                 // column, it may be right-padded with spaces up to the length
                 // of the longest string in the result set. This happens with
@@ -490,4 +610,7 @@ void odbc_vector_into_type_backend::clean_up()
         delete [] buf_;
         buf_ = NULL;
     }
+    bufRows_ = 0;
+
+    statement_.remove_buffered_into(this);
 }
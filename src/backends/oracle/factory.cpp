@@ -13,6 +13,7 @@
 #include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <limits>
 #include <sstream>
 
 #ifdef _MSC_VER
@@ -171,6 +172,26 @@ void chop_connect_string(std::string const & connectString,
     }
 }
 
+// retrieves the value of the given numeric option, returns -1 if not specified
+long get_prefetch_option(connection_parameters const & parameters,
+    char const * name)
+{
+    // the value must fit into both ub4 used by OCI and long used by us
+    std::size_t maxValue = std::numeric_limits<ub4>::max();
+    if (maxValue > static_cast<std::size_t>(std::numeric_limits<long>::max()))
+    {
+        maxValue = static_cast<std::size_t>(std::numeric_limits<long>::max());
+    }
+
+    std::size_t size = 0;
+    if (!parameters.get_size_option(name, size, maxValue))
+    {
+        return -1;
+    }
+
+    return static_cast<long>(size);
+}
+
 // concrete factory for Empty concrete strategies
 oracle_session_backend * oracle_backend_factory::make_session(
      connection_parameters const & parameters) const
@@ -184,8 +205,35 @@ oracle_session_backend * oracle_backend_factory::make_session(
     chop_connect_string(parameters.get_connect_string(), serviceName, userName, password,
         mode, decimals_as_strings, charset, ncharset);
 
-    return new oracle_session_backend(serviceName, userName, password,
+    long const prefetchRows
+        = get_prefetch_option(parameters, oracle_option_prefetch_rows);
+    long const prefetchMemory
+        = get_prefetch_option(parameters, oracle_option_prefetch_memory);
+    long const lobPrefetchSize
+        = get_prefetch_option(parameters, oracle_option_lob_prefetch_size);
+
+    oracle_session_backend * const backend = new oracle_session_backend(
+        serviceName, userName, password,
         mode, decimals_as_strings, charset, ncharset);
+
+    backend->prefetchRows_ = prefetchRows;
+    backend->prefetchMemory_ = prefetchMemory;
+
+    if (lobPrefetchSize != -1)
+    {
+        try
+        {
+            backend->set_default_lob_prefetch_size(
+                static_cast<ub4>(lobPrefetchSize));
+        }
+        catch (...)
+        {
+            delete backend;
+            throw;
+        }
+    }
+
+    return backend;
 }
 
 oracle_backend_factory const soci::oracle;
@@ -23,6 +23,10 @@ using namespace soci;
 using namespace soci::details;
 using namespace soci::details::oracle;
 
+char const * soci::oracle_option_prefetch_rows = "oracle.prefetch_rows";
+char const * soci::oracle_option_prefetch_memory = "oracle.prefetch_memory";
+char const * soci::oracle_option_lob_prefetch_size = "oracle.lob_prefetch_size";
+
 namespace // unnamed
 {
 
@@ -125,7 +129,8 @@ oracle_session_backend::oracle_session_backend(std::string const & serviceName,
     std::string const & userName, std::string const & password, int mode,
     bool decimals_as_strings, int charset, int ncharset)
     : envhp_(NULL), srvhp_(NULL), errhp_(NULL), svchp_(NULL), usrhp_(NULL),
-      decimals_as_strings_(decimals_as_strings)
+      decimals_as_strings_(decimals_as_strings),
+      prefetchRows_(-1), prefetchMemory_(-1)
 {
     // assume service/user/password are utf8-compatible already
     const int defaultSourceCharSetId = 871;
@@ -362,6 +367,21 @@ oracle_session_backend::~oracle_session_backend()
     clean_up();
 }
 
+void oracle_session_backend::set_default_lob_prefetch_size(ub4 size)
+{
+#ifdef OCI_ATTR_DEFAULT_LOBPREFETCH_SIZE
+    sword res = OCIAttrSet(usrhp_, OCI_HTYPE_SESSION, &size, 0,
+        OCI_ATTR_DEFAULT_LOBPREFETCH_SIZE, errhp_);
+    if (res != OCI_SUCCESS)
+    {
+        throw_oracle_soci_error(res, errhp_);
+    }
+#else
+    (void)size;
+    throw soci_error("LOB prefetching requires Oracle 11.1 or later.");
+#endif
+}
+
 void oracle_session_backend::begin()
 {
     // This code is commented out because it causes one of the transaction
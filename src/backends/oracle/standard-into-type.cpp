@@ -175,6 +175,29 @@ void oracle_standard_into_type_backend::define_by_pos(
 
 void oracle_standard_into_type_backend::pre_exec(int /* num */)
 {
+#ifdef OCI_ATTR_LOBPREFETCH_SIZE
+    if (statement_.lobPrefetchSize_ != -1 &&
+        (type_ == x_blob || type_ == x_xmltype || type_ == x_longstring))
+    {
+        ub4 size = static_cast<ub4>(statement_.lobPrefetchSize_);
+        sword res = OCIAttrSet(defnp_, OCI_HTYPE_DEFINE, &size, 0,
+            OCI_ATTR_LOBPREFETCH_SIZE, statement_.session_.errhp_);
+        if (res != OCI_SUCCESS)
+        {
+            throw_oracle_soci_error(res, statement_.session_.errhp_);
+        }
+
+        // also prefetch the length, as we always need it to read the LOB
+        boolean prefetchLength = TRUE;
+        res = OCIAttrSet(defnp_, OCI_HTYPE_DEFINE, &prefetchLength, 0,
+            OCI_ATTR_LOBPREFETCH_LENGTH, statement_.session_.errhp_);
+        if (res != OCI_SUCCESS)
+        {
+            throw_oracle_soci_error(res, statement_.session_.errhp_);
+        }
+    }
+#endif // OCI_ATTR_LOBPREFETCH_SIZE
+
     if (type_ == x_xmltype || type_ == x_longstring)
     {
         // lazy initialization of the temporary LOB object
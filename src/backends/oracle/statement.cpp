@@ -27,7 +27,7 @@ using namespace soci::details::oracle;
 
 oracle_statement_backend::oracle_statement_backend(oracle_session_backend &session)
     : session_(session), stmtp_(NULL), boundByName_(false), boundByPos_(false),
-      noData_(false)
+      noData_(false), lobPrefetchSize_(-1)
 {
 }
 
@@ -40,6 +40,16 @@ void oracle_statement_backend::alloc()
     {
         throw soci_error("Cannot allocate statement handle");
     }
+
+    // apply the session defaults, if any
+    if (session_.prefetchRows_ != -1)
+    {
+        set_prefetch_rows(static_cast<ub4>(session_.prefetchRows_));
+    }
+    if (session_.prefetchMemory_ != -1)
+    {
+        set_prefetch_memory(static_cast<ub4>(session_.prefetchMemory_));
+    }
 }
 
 void oracle_statement_backend::clean_up()
@@ -147,6 +157,38 @@ int oracle_statement_backend::get_number_of_rows()
     return rows;
 }
 
+void oracle_statement_backend::set_prefetch_rows(ub4 rows)
+{
+    sword res = OCIAttrSet(stmtp_, OCI_HTYPE_STMT, &rows, 0,
+        OCI_ATTR_PREFETCH_ROWS, session_.errhp_);
+    if (res != OCI_SUCCESS)
+    {
+        throw_oracle_soci_error(res, session_.errhp_);
+    }
+}
+
+void oracle_statement_backend::set_prefetch_memory(ub4 bytes)
+{
+    sword res = OCIAttrSet(stmtp_, OCI_HTYPE_STMT, &bytes, 0,
+        OCI_ATTR_PREFETCH_MEMORY, session_.errhp_);
+    if (res != OCI_SUCCESS)
+    {
+        throw_oracle_soci_error(res, session_.errhp_);
+    }
+}
+
+void oracle_statement_backend::set_lob_prefetch_size(ub4 size)
+{
+#ifdef OCI_ATTR_LOBPREFETCH_SIZE
+    // this is applied to the LOB columns defines right before executing the
+    // statement, see oracle_standard_into_type_backend::pre_exec()
+    lobPrefetchSize_ = static_cast<long>(size);
+#else
+    (void)size;
+    throw soci_error("LOB prefetching requires Oracle 11.1 or later.");
+#endif
+}
+
 std::string oracle_statement_backend::get_parameter_name(int /* index */) const
 {
     // TODO: How to get the parameter names from the query we prepared?
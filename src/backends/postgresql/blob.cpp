@@ -8,10 +8,12 @@
 #define SOCI_POSTGRESQL_SOURCE
 #include "soci/postgresql/soci-postgresql.h"
 #include <libpq/libpq-fs.h> // libpq
+#include <algorithm>
 #include <cctype>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <limits>
 #include <sstream>
 
 #ifdef _MSC_VER
@@ -22,9 +24,19 @@ using namespace soci;
 using namespace soci::details;
 
 
+namespace // anonymous
+{
+
+// Each call to lo_read() or lo_write() transfers the data in a single round
+// trip, but they can't transfer more than this at once.
+std::size_t const max_chunk_size
+    = static_cast<std::size_t>(std::numeric_limits<int>::max());
+
+} // namespace anonymous
+
 postgresql_blob_backend::postgresql_blob_backend(
     postgresql_session_backend & session)
-    : session_(session), fd_(-1)
+    : session_(session), oid_(InvalidOid), fd_(-1), pos_(-1), len_(-1)
 {
     // nothing to do here, the descriptor is open in the postFetch
     // method of the Into element
@@ -38,76 +50,182 @@ postgresql_blob_backend::~postgresql_blob_backend()
     }
 }
 
-std::size_t postgresql_blob_backend::get_len()
+void postgresql_blob_backend::open(unsigned long oid)
 {
-    int const pos = lo_lseek(session_.conn_, fd_, 0, SEEK_END);
-    if (pos == -1)
+    int const fd = lo_open(session_.conn_, oid, INV_READ | INV_WRITE);
+    if (fd == -1)
     {
-        throw soci_error("Cannot retrieve the size of BLOB.");
+        throw soci_error("Cannot open the blob object.");
     }
 
-    return static_cast<std::size_t>(pos);
+    close();
+
+    fd_ = fd;
+    oid_ = oid;
+
+    // a newly opened descriptor is positioned at the start of the object,
+    // but its length is only retrieved when it's needed
+    pos_ = 0;
+    len_ = -1;
 }
 
-std::size_t postgresql_blob_backend::read(
-    std::size_t offset, char * buf, std::size_t toRead)
+void postgresql_blob_backend::close()
 {
+    if (fd_ != -1)
+    {
+        lo_close(session_.conn_, fd_);
+        fd_ = -1;
+    }
+
+    pos_ = -1;
+    len_ = -1;
+}
+
+void postgresql_blob_backend::seek(std::size_t offset)
+{
+    if (pos_ != -1 && static_cast<std::size_t>(pos_) == offset)
+    {
+        return;
+    }
+
     int const pos = lo_lseek(session_.conn_, fd_,
         static_cast<int>(offset), SEEK_SET);
     if (pos == -1)
     {
+        pos_ = -1;
         throw soci_error("Cannot seek in BLOB.");
     }
 
-    int const readn = lo_read(session_.conn_, fd_, buf, toRead);
-    if (readn < 0)
+    pos_ = pos;
+}
+
+std::size_t postgresql_blob_backend::get_len()
+{
+    if (len_ == -1)
     {
-        throw soci_error("Cannot read from BLOB.");
+        session_.sync_pipeline();
+
+        int const pos = lo_lseek(session_.conn_, fd_, 0, SEEK_END);
+        if (pos == -1)
+        {
+            pos_ = -1;
+            throw soci_error("Cannot retrieve the size of BLOB.");
+        }
+
+        pos_ = pos;
+        len_ = pos;
     }
 
-    return static_cast<std::size_t>(readn);
+    return static_cast<std::size_t>(len_);
+}
+
+std::size_t postgresql_blob_backend::read(
+    std::size_t offset, char * buf, std::size_t toRead)
+{
+    session_.sync_pipeline();
+
+    seek(offset);
+
+    std::size_t total = 0;
+    while (total < toRead)
+    {
+        std::size_t const chunk = (std::min)(toRead - total, max_chunk_size);
+
+        int const readn = lo_read(session_.conn_, fd_, buf + total, chunk);
+        if (readn < 0)
+        {
+            pos_ = -1;
+            throw soci_error("Cannot read from BLOB.");
+        }
+
+        total += readn;
+        pos_ += readn;
+
+        if (static_cast<std::size_t>(readn) < chunk)
+        {
+            // we've reached the end of the object, so we know its length now
+            // too, unless the offset was already beyond it
+            if (total != 0)
+            {
+                len_ = pos_;
+            }
+            break;
+        }
+    }
+
+    return total;
 }
 
 std::size_t postgresql_blob_backend::write(
     std::size_t offset, char const * buf, std::size_t toWrite)
 {
-    int const pos = lo_lseek(session_.conn_, fd_,
-        static_cast<int>(offset), SEEK_SET);
-    if (pos == -1)
+    session_.sync_pipeline();
+
+    seek(offset);
+
+    std::size_t total = 0;
+    while (total < toWrite)
     {
-        throw soci_error("Cannot seek in BLOB.");
+        std::size_t const chunk = (std::min)(toWrite - total, max_chunk_size);
+
+        int const writen = lo_write(session_.conn_, fd_,
+            const_cast<char *>(buf + total), chunk);
+        if (writen < 0)
+        {
+            pos_ = -1;
+            throw soci_error("Cannot write to BLOB.");
+        }
+
+        total += writen;
+        pos_ += writen;
     }
 
-    int const writen = lo_write(session_.conn_, fd_,
-        const_cast<char *>(buf), toWrite);
-    if (writen < 0)
+    if (len_ != -1 && pos_ > len_)
     {
-        throw soci_error("Cannot write to BLOB.");
+        len_ = pos_;
     }
 
-    return static_cast<std::size_t>(writen);
+    return total;
 }
 
 std::size_t postgresql_blob_backend::append(
     char const * buf, std::size_t toWrite)
 {
-    int const pos = lo_lseek(session_.conn_, fd_, 0, SEEK_END);
-    if (pos == -1)
-    {
-        throw soci_error("Cannot seek in BLOB.");
-    }
+    // when appending repeatedly, the position is already at the end of the
+    // object after the first call, so no seeks are needed at all
+    return write(get_len(), buf, toWrite);
+}
+
+void postgresql_blob_backend::trim(std::size_t /* newLen */)
+{
+    throw soci_error("Trimming BLOBs is not supported.");
+}
 
-    int const writen = lo_write(session_.conn_, fd_,
-        const_cast<char *>(buf), toWrite);
-    if (writen < 0)
+unsigned long postgresql_blob_backend::import_file(std::string const & filename)
+{
+    session_.sync_pipeline();
+
+    Oid const oid = lo_import(session_.conn_, filename.c_str());
+    if (oid == InvalidOid)
     {
-        throw soci_error("Cannot append to BLOB.");
+        std::string msg = "Cannot import BLOB from \"" + filename + "\": ";
+        msg += PQerrorMessage(session_.conn_);
+        throw soci_error(msg);
     }
 
-    return static_cast<std::size_t>(writen);
+    open(oid);
+
+    return oid;
 }
 
-void postgresql_blob_backend::trim(std::size_t /* newLen */)
+void postgresql_blob_backend::export_file(std::string const & filename)
 {
-    throw soci_error("Trimming BLOBs is not supported.");
+    session_.sync_pipeline();
+
+    if (lo_export(session_.conn_, oid_, filename.c_str()) != 1)
+    {
+        std::string msg = "Cannot export BLOB to \"" + filename + "\": ";
+        msg += PQerrorMessage(session_.conn_);
+        throw soci_error(msg);
+    }
 }
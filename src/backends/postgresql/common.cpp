@@ -0,0 +1,759 @@
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#define SOCI_POSTGRESQL_SOURCE
+#include "soci/soci-platform.h"
+#include "soci/postgresql/soci-postgresql.h"
+#include "soci-compiler.h"
+#include "soci-cstrtod.h"
+#include "soci-mktime.h"
+#include "common.h"
+#include "soci/type-wrappers.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <string>
+
+using namespace soci;
+using namespace soci::details;
+
+namespace // anonymous
+{
+
+// OIDs of the types supported in binary format, from pg_type.
+enum
+{
+    oid_bool        = 16,
+    oid_bytea       = 17,
+    oid_char        = 18,
+    oid_name        = 19,
+    oid_int8        = 20,
+    oid_int2        = 21,
+    oid_int4        = 23,
+    oid_text        = 25,
+    oid_oid         = 26,
+    oid_json        = 114,
+    oid_xml         = 142,
+    oid_float4      = 700,
+    oid_float8      = 701,
+    oid_unknown     = 705,
+    oid_bpchar      = 1042,
+    oid_varchar     = 1043,
+    oid_date        = 1082,
+    oid_time        = 1083,
+    oid_timestamp   = 1114,
+    oid_timestamptz = 1184,
+    oid_timetz      = 1266,
+    oid_numeric     = 1700,
+    oid_cstring     = 2275,
+    oid_uuid        = 2950,
+    oid_jsonb       = 3802
+};
+
+// PostgreSQL dates and timestamps are relative to 2000-01-01 while we use
+// the Unix epoch below.
+long long const days_from_unix_epoch_to_pg_epoch = 10957;
+long long const usecs_per_day = 86400LL * 1000000LL;
+
+// Values used for "infinity" and "-infinity" dates and timestamps.
+long long const date_infinity = 0x7FFFFFFFLL;
+long long const date_minus_infinity = -date_infinity - 1;
+long long const timestamp_infinity = 0x7FFFFFFFFFFFFFFFLL;
+long long const timestamp_minus_infinity = -timestamp_infinity - 1;
+
+void throw_cannot_convert()
+{
+    throw soci_error("Cannot convert data.");
+}
+
+// Read a big endian unsigned value of the given size, checking that it's the
+// size of the value in the buffer.
+unsigned long long read_uint(char const * buf, int len, int size)
+{
+    if (len != size)
+    {
+        throw_cannot_convert();
+    }
+
+    unsigned long long val = 0;
+    for (int i = 0; i != size; ++i)
+    {
+        val = (val << 8) | static_cast<unsigned char>(buf[i]);
+    }
+    return val;
+}
+
+long long read_int(char const * buf, int len, int size)
+{
+    unsigned long long const val = read_uint(buf, len, size);
+
+    // Sign-extend the values smaller than 64 bits.
+    unsigned long long const signBit = 1ULL << (8 * size - 1);
+    if (size < 8 && (val & signBit) != 0)
+    {
+        return static_cast<long long>(val | ~((signBit << 1) - 1));
+    }
+    return static_cast<long long>(val);
+}
+
+double read_double(char const * buf, int len, int size)
+{
+    unsigned long long const bits = read_uint(buf, len, size);
+    if (size == 4)
+    {
+        unsigned int const bits32 = static_cast<unsigned int>(bits);
+        float f;
+        std::memcpy(&f, &bits32, sizeof(f));
+        return f;
+    }
+
+    double d;
+    std::memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+// Divide rounding towards negative infinity.
+long long floor_div(long long a, long long b)
+{
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+// Convert the number of days since the Unix epoch to the civil date.
+void civil_from_days(long long z, int & year, int & month, int & day)
+{
+    z += 719468;
+    long long const era = (z >= 0 ? z : z - 146096) / 146097;
+    long long const doe = z - era * 146097;
+    long long const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long long const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long long const mp = (5 * doy + 2) / 153;
+
+    day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    year = static_cast<int>(yoe + era * 400 + (month <= 2 ? 1 : 0));
+}
+
+// Convert the civil date to the number of days since the Unix epoch.
+long long days_from_civil(long long year, int month, int day)
+{
+    year -= month <= 2 ? 1 : 0;
+    long long const era = (year >= 0 ? year : year - 399) / 400;
+    long long const yoe = year - era * 400;
+    long long const doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5
+        + day - 1;
+    long long const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+struct timestamp_parts
+{
+    int year, month, day;
+    int hour, minute, second;
+    int usec;
+};
+
+void split_time_of_day(long long usecs, timestamp_parts & parts)
+{
+    parts.usec = static_cast<int>(usecs % 1000000);
+    long long const secs = usecs / 1000000;
+    parts.second = static_cast<int>(secs % 60);
+    parts.minute = static_cast<int>(secs / 60 % 60);
+    parts.hour = static_cast<int>(secs / 3600);
+}
+
+// Decode a date, time or timestamp column, return false if it's infinite.
+bool get_timestamp_parts(unsigned long oid, char const * buf, int len,
+    timestamp_parts & parts)
+{
+    parts.year = 1900;
+    parts.month = 1;
+    parts.day = 1;
+    parts.hour = parts.minute = parts.second = parts.usec = 0;
+
+    switch (oid)
+    {
+    case oid_date:
+        {
+            long long const days = read_int(buf, len, 4);
+            if (days == date_infinity || days == date_minus_infinity)
+            {
+                return false;
+            }
+            civil_from_days(days + days_from_unix_epoch_to_pg_epoch,
+                parts.year, parts.month, parts.day);
+        }
+        break;
+
+    case oid_time:
+        split_time_of_day(read_int(buf, len, 8), parts);
+        break;
+
+    case oid_timetz:
+        // The time is followed by the zone offset which we ignore, just as
+        // parse_std_tm() does for the text values.
+        if (len != 12)
+        {
+            throw_cannot_convert();
+        }
+        split_time_of_day(read_int(buf, 8, 8), parts);
+        break;
+
+    case oid_timestamp:
+    case oid_timestamptz:
+        {
+            long long const usecs = read_int(buf, len, 8);
+            if (usecs == timestamp_infinity ||
+                usecs == timestamp_minus_infinity)
+            {
+                return false;
+            }
+            long long const days = floor_div(usecs, usecs_per_day);
+            civil_from_days(days + days_from_unix_epoch_to_pg_epoch,
+                parts.year, parts.month, parts.day);
+            split_time_of_day(usecs - days * usecs_per_day, parts);
+        }
+        break;
+
+    default:
+        throw_cannot_convert();
+    }
+
+    return true;
+}
+
+void append_fraction(std::string & s, int usec)
+{
+    if (usec != 0)
+    {
+        char buf[8];
+        std::snprintf(buf, sizeof(buf), ".%06d", usec);
+
+        // Omit the trailing zeros, as PostgreSQL does.
+        std::size_t n = std::strlen(buf);
+        while (buf[n - 1] == '0')
+        {
+            --n;
+        }
+        s.append(buf, n);
+    }
+}
+
+// Format the value of the given type as PostgreSQL would do it in text mode.
+void timestamp_to_string(unsigned long oid, char const * buf, int len,
+    std::string & s)
+{
+    timestamp_parts parts;
+    if (!get_timestamp_parts(oid, buf, len, parts))
+    {
+        s = buf[0] & 0x80 ? "-infinity" : "infinity";
+        return;
+    }
+
+    char tmp[32];
+    s.clear();
+    if (oid != oid_time && oid != oid_timetz)
+    {
+        std::snprintf(tmp, sizeof(tmp), "%04d-%02d-%02d",
+            parts.year, parts.month, parts.day);
+        s += tmp;
+        if (oid == oid_date)
+        {
+            return;
+        }
+        s += ' ';
+    }
+
+    std::snprintf(tmp, sizeof(tmp), "%02d:%02d:%02d",
+        parts.hour, parts.minute, parts.second);
+    s += tmp;
+    append_fraction(s, parts.usec);
+
+    if (oid == oid_timestamptz)
+    {
+        // Binary timestamps with time zone are always in UTC.
+        s += "+00";
+    }
+    else if (oid == oid_timetz)
+    {
+        // The zone is given in seconds west of UTC.
+        int const zone = static_cast<int>(read_int(buf + 8, 4, 4));
+        int const offset = zone > 0 ? zone : -zone;
+        std::snprintf(tmp, sizeof(tmp), "%c%02d",
+            zone > 0 ? '-' : '+', offset / 3600);
+        s += tmp;
+        if (offset % 3600 != 0)
+        {
+            std::snprintf(tmp, sizeof(tmp), ":%02d", offset % 3600 / 60);
+            s += tmp;
+        }
+    }
+}
+
+// Decode the numeric value as a string, this is the only lossless way to do
+// it.
+void numeric_to_string(char const * buf, int len, std::string & s)
+{
+    if (len < 8)
+    {
+        throw_cannot_convert();
+    }
+
+    int const ndigits = static_cast<int>(read_int(buf, 2, 2));
+    int const weight = static_cast<int>(read_int(buf + 2, 2, 2));
+    unsigned const sign = static_cast<unsigned>(read_uint(buf + 4, 2, 2));
+    int const dscale = static_cast<int>(read_int(buf + 6, 2, 2));
+
+    if (ndigits < 0 || len != 8 + 2 * ndigits)
+    {
+        throw_cannot_convert();
+    }
+
+    switch (sign)
+    {
+    case 0xC000:
+        s = "NaN";
+        return;
+    case 0xD000:
+        s = "Infinity";
+        return;
+    case 0xF000:
+        s = "-Infinity";
+        return;
+    }
+
+    char const * const digits = buf + 8;
+    s.clear();
+    if (sign == 0x4000)
+    {
+        s += '-';
+    }
+
+    // Each digit is a base 10000 value, i.e. corresponds to 4 decimal digits.
+    char tmp[8];
+    if (weight < 0)
+    {
+        s += '0';
+    }
+    else
+    {
+        for (int i = 0; i <= weight; ++i)
+        {
+            int const digit = i < ndigits
+                ? static_cast<int>(read_int(digits + 2 * i, 2, 2))
+                : 0;
+            std::snprintf(tmp, sizeof(tmp), i == 0 ? "%d" : "%04d", digit);
+            s += tmp;
+        }
+    }
+
+    if (dscale > 0)
+    {
+        s += '.';
+        std::string::size_type const end = s.size() + dscale;
+        for (int i = weight + 1; s.size() < end; ++i)
+        {
+            int const digit = i >= 0 && i < ndigits
+                ? static_cast<int>(read_int(digits + 2 * i, 2, 2))
+                : 0;
+            std::snprintf(tmp, sizeof(tmp), "%04d", digit);
+            s += tmp;
+        }
+        s.resize(end);
+    }
+}
+
+// Format the floating point number using the shortest representation which
+// round trips, as PostgreSQL does with extra_float_digits=3.
+std::string float_to_string(double d, bool isFloat4)
+{
+    char buf[32];
+    for (int precision = isFloat4 ? 6 : 15; ; ++precision)
+    {
+        std::snprintf(buf, sizeof(buf), "%.*g", precision, d);
+
+        // Replace any comma which can be used as decimal separator.
+        char * const comma = std::strchr(buf, ',');
+        if (comma != NULL)
+        {
+            *comma = '.';
+        }
+
+        if (precision == (isFloat4 ? 9 : 17))
+        {
+            break;
+        }
+
+        double const roundTrip = cstring_to_double(buf);
+
+        // We really need exact floating point comparison here.
+        GCC_WARNING_SUPPRESS(float-equal)
+
+        if (isFloat4 ? static_cast<float>(roundTrip) == static_cast<float>(d)
+                     : roundTrip == d)
+        {
+            break;
+        }
+
+        GCC_WARNING_RESTORE(float-equal)
+    }
+
+    return buf;
+}
+
+void uuid_to_string(char const * buf, int len, std::string & s)
+{
+    if (len != 16)
+    {
+        throw_cannot_convert();
+    }
+
+    static char const hex[] = "0123456789abcdef";
+    s.clear();
+    for (int i = 0; i != 16; ++i)
+    {
+        if (i == 4 || i == 6 || i == 8 || i == 10)
+        {
+            s += '-';
+        }
+        unsigned char const c = static_cast<unsigned char>(buf[i]);
+        s += hex[c >> 4];
+        s += hex[c & 0x0F];
+    }
+}
+
+void write_uint(char * buf, unsigned long long val, int size)
+{
+    for (int i = size - 1; i >= 0; --i)
+    {
+        buf[i] = static_cast<char>(val & 0xFF);
+        val >>= 8;
+    }
+}
+
+char * make_binary_double(unsigned long paramType, double val, int & length)
+{
+    char * buf;
+    switch (paramType)
+    {
+    case oid_float4:
+        {
+            float const f = static_cast<float>(val);
+            unsigned int bits32;
+            std::memcpy(&bits32, &f, sizeof(bits32));
+
+            length = 4;
+            buf = new char[length];
+            write_uint(buf, bits32, length);
+        }
+        break;
+    case oid_float8:
+        {
+            unsigned long long bits;
+            std::memcpy(&bits, &val, sizeof(bits));
+
+            length = 8;
+            buf = new char[length];
+            write_uint(buf, bits, length);
+        }
+        break;
+    default:
+        return NULL;
+    }
+
+    return buf;
+}
+
+char * make_binary_integer(unsigned long paramType, long long val,
+    int & length)
+{
+    long long minVal, maxVal;
+    switch (paramType)
+    {
+    case oid_float4:
+    case oid_float8:
+        return make_binary_double(paramType, static_cast<double>(val), length);
+    case oid_bool:
+        length = 1;
+        val = val != 0 ? 1 : 0;
+        minVal = 0;
+        maxVal = 1;
+        break;
+    case oid_int2:
+        length = 2;
+        minVal = -32768;
+        maxVal = 32767;
+        break;
+    case oid_int4:
+        length = 4;
+        minVal = -2147483647LL - 1;
+        maxVal = 2147483647LL;
+        break;
+    case oid_int8:
+        length = 8;
+        minVal = (std::numeric_limits<long long>::min)();
+        maxVal = (std::numeric_limits<long long>::max)();
+        break;
+    default:
+        return NULL;
+    }
+
+    if (val < minVal || val > maxVal)
+    {
+        throw_cannot_convert();
+    }
+
+    char * buf = new char[length];
+    write_uint(buf, static_cast<unsigned long long>(val), length);
+    return buf;
+}
+
+char * make_binary_std_tm(unsigned long paramType, std::tm const & t,
+    int & length)
+{
+    long long const days = days_from_civil(t.tm_year + 1900LL,
+        t.tm_mon + 1, t.tm_mday) - days_from_unix_epoch_to_pg_epoch;
+
+    long long val;
+    switch (paramType)
+    {
+    case oid_date:
+        length = 4;
+        val = days;
+        break;
+    case oid_timestamp:
+        length = 8;
+        val = days * usecs_per_day +
+            (t.tm_hour * 3600LL + t.tm_min * 60LL + t.tm_sec) * 1000000LL;
+        break;
+    default:
+        // Notably, timestamps with time zone are sent as text to let the
+        // server interpret them in the session time zone.
+        return NULL;
+    }
+
+    char * buf = new char[length];
+    write_uint(buf, static_cast<unsigned long long>(val), length);
+    return buf;
+}
+
+char * make_binary_string(unsigned long paramType, std::string const & s,
+    int & length)
+{
+    // Only bytea values benefit from the binary format, the text format of
+    // the other types is the same as their binary one.
+    if (paramType != oid_bytea)
+    {
+        return NULL;
+    }
+
+    length = static_cast<int>(s.size());
+    char * buf = new char[s.size() + 1];
+    std::memcpy(buf, s.data(), s.size());
+    return buf;
+}
+
+} // namespace anonymous
+
+char * postgresql::make_binary_param(unsigned long paramType,
+    exchange_type type, void const * data, int & length)
+{
+    switch (type)
+    {
+    case x_short:
+        return make_binary_integer(paramType,
+            *static_cast<short const *>(data), length);
+    case x_integer:
+        return make_binary_integer(paramType,
+            *static_cast<int const *>(data), length);
+    case x_long_long:
+        return make_binary_integer(paramType,
+            *static_cast<long long const *>(data), length);
+    case x_unsigned_long_long:
+        {
+            unsigned long long const val =
+                *static_cast<unsigned long long const *>(data);
+            if (val > static_cast<unsigned long long>(
+                    (std::numeric_limits<long long>::max)()))
+            {
+                // Not representable by any integer type, so just let the
+                // server deal with it.
+                return NULL;
+            }
+            return make_binary_integer(paramType,
+                static_cast<long long>(val), length);
+        }
+    case x_double:
+        return make_binary_double(paramType,
+            *static_cast<double const *>(data), length);
+    case x_stdtm:
+        return make_binary_std_tm(paramType,
+            *static_cast<std::tm const *>(data), length);
+    case x_stdstring:
+        return make_binary_string(paramType,
+            *static_cast<std::string const *>(data), length);
+    case x_longstring:
+        return make_binary_string(paramType,
+            static_cast<long_string const *>(data)->value, length);
+    default:
+        return NULL;
+    }
+}
+
+bool postgresql::get_binary_integer(PGresult const * res, int row, int pos,
+    long long & val)
+{
+    char const * const buf = PQgetvalue(res, row, pos);
+    int const len = PQgetlength(res, row, pos);
+
+    switch (PQftype(res, pos))
+    {
+    case oid_bool:
+        val = read_int(buf, len, 1);
+        return true;
+    case oid_int2:
+        val = read_int(buf, len, 2);
+        return true;
+    case oid_int4:
+        val = read_int(buf, len, 4);
+        return true;
+    case oid_int8:
+        val = read_int(buf, len, 8);
+        return true;
+    case oid_oid:
+        val = static_cast<long long>(read_uint(buf, len, 4));
+        return true;
+    }
+
+    return false;
+}
+
+double postgresql::binary_to_double(PGresult const * res, int row, int pos)
+{
+    switch (PQftype(res, pos))
+    {
+    case oid_float4:
+        return read_double(PQgetvalue(res, row, pos),
+            PQgetlength(res, row, pos), 4);
+    case oid_float8:
+        return read_double(PQgetvalue(res, row, pos),
+            PQgetlength(res, row, pos), 8);
+    }
+
+    long long val;
+    if (get_binary_integer(res, row, pos, val))
+    {
+        return static_cast<double>(val);
+    }
+
+    std::string s;
+    binary_to_string(res, row, pos, s);
+    return cstring_to_double(s.c_str());
+}
+
+void postgresql::binary_to_std_tm(PGresult const * res, int row, int pos,
+    std::tm & t)
+{
+    unsigned long const oid = PQftype(res, pos);
+    switch (oid)
+    {
+    case oid_date:
+    case oid_time:
+    case oid_timetz:
+    case oid_timestamp:
+    case oid_timestamptz:
+        {
+            timestamp_parts parts;
+            if (!get_timestamp_parts(oid, PQgetvalue(res, row, pos),
+                    PQgetlength(res, row, pos), parts))
+            {
+                throw_cannot_convert();
+            }
+
+            mktime_from_ymdhms(t, parts.year, parts.month, parts.day,
+                parts.hour, parts.minute, parts.second);
+        }
+        return;
+    }
+
+    std::string s;
+    binary_to_string(res, row, pos, s);
+    parse_std_tm(s.c_str(), t);
+}
+
+void postgresql::binary_to_string(PGresult const * res, int row, int pos,
+    std::string & s)
+{
+    char const * const buf = PQgetvalue(res, row, pos);
+    int const len = PQgetlength(res, row, pos);
+
+    unsigned long const oid = PQftype(res, pos);
+    switch (oid)
+    {
+    case oid_bytea:
+    case oid_char:
+    case oid_name:
+    case oid_text:
+    case oid_json:
+    case oid_xml:
+    case oid_unknown:
+    case oid_bpchar:
+    case oid_varchar:
+    case oid_cstring:
+        // The binary representation of these types is just their contents.
+        s.assign(buf, len);
+        return;
+
+    case oid_jsonb:
+        // Skip the format version.
+        if (len < 1 || buf[0] != 1)
+        {
+            throw_cannot_convert();
+        }
+        s.assign(buf + 1, len - 1);
+        return;
+
+    case oid_bool:
+        s = read_int(buf, len, 1) ? "t" : "f";
+        return;
+
+    case oid_float4:
+    case oid_float8:
+        s = float_to_string(binary_to_double(res, row, pos),
+            oid == oid_float4);
+        return;
+
+    case oid_numeric:
+        numeric_to_string(buf, len, s);
+        return;
+
+    case oid_date:
+    case oid_time:
+    case oid_timetz:
+    case oid_timestamp:
+    case oid_timestamptz:
+        timestamp_to_string(oid, buf, len, s);
+        return;
+
+    case oid_uuid:
+        uuid_to_string(buf, len, s);
+        return;
+    }
+
+    long long val;
+    if (get_binary_integer(res, row, pos, val))
+    {
+        char tmp[32];
+        std::snprintf(tmp, sizeof(tmp), "%" LL_FMT_FLAGS "d", val);
+        s = tmp;
+        return;
+    }
+
+    std::string msg = "Cannot convert value of the column \"";
+    msg += PQfname(res, pos);
+    msg += "\" from binary format.";
+    throw soci_error(msg);
+}
@@ -13,6 +13,7 @@
 #include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <string>
 #include <vector>
 
 namespace soci
@@ -112,6 +113,66 @@ T string_to_unsigned_integer(char const * buf)
     }
 }
 
+// Helpers for decoding the values retrieved in binary format, which is used
+// when "binaryresults=true" is specified in the connect string. They throw
+// if the column type can't be converted to the requested one.
+
+// Returns false if the column is not of a boolean or integer type.
+bool get_binary_integer(PGresult const * res, int row, int pos,
+    long long & val);
+
+double binary_to_double(PGresult const * res, int row, int pos);
+
+void binary_to_std_tm(PGresult const * res, int row, int pos, std::tm & t);
+
+// Produces the same string as would have been retrieved in text format,
+// except for bytea values which are returned as is, without escaping, and
+// timestamps with time zone which are always in UTC.
+void binary_to_string(PGresult const * res, int row, int pos,
+    std::string & s);
+
+template <typename T>
+T binary_to_integer(PGresult const * res, int row, int pos)
+{
+    long long val;
+    if (!get_binary_integer(res, row, pos, val))
+    {
+        // e.g. numeric or text value
+        std::string s;
+        binary_to_string(res, row, pos, s);
+        return std::numeric_limits<T>::is_signed
+            ? string_to_integer<T>(s.c_str())
+            : string_to_unsigned_integer<T>(s.c_str());
+    }
+
+    if (std::numeric_limits<T>::is_signed)
+    {
+        if (val < static_cast<long long>((std::numeric_limits<T>::min)()) ||
+            val > static_cast<long long>((std::numeric_limits<T>::max)()))
+        {
+            throw soci_error("Cannot convert data.");
+        }
+    }
+    else
+    {
+        if (val < 0 || static_cast<unsigned long long>(val) >
+                static_cast<unsigned long long>((std::numeric_limits<T>::max)()))
+        {
+            throw soci_error("Cannot convert data.");
+        }
+    }
+
+    return static_cast<T>(val);
+}
+
+// Helper for sending the parameters in binary format, which is used when
+// "binaryparams=true" is specified in the connect string: returns the
+// buffer, to be freed with delete [], containing the binary representation of
+// the given value for a parameter of the given type or NULL if the value
+// should be sent in text format.
+char * make_binary_param(unsigned long paramType,
+    exchange_type type, void const * data, int & length);
+
 // helper for vector operations
 template <typename T>
 std::size_t get_vector_size(void * p)
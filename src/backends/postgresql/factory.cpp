@@ -71,11 +71,16 @@ std::string::const_iterator get_key_value(std::string::const_iterator & i,
 // retrieves specific parameters from the
 // uniform connect string
 std::string chop_connect_string(std::string const & connectString,
-    bool & single_row_mode)
+    bool & single_row_mode, bool & binary_results, bool & binary_params,
+    bool & bulk_copy, bool & pipeline_bulk)
 {
     std::string pruned_conn_string;
 
     single_row_mode = false;
+    binary_results = false;
+    binary_params = false;
+    bulk_copy = false;
+    pipeline_bulk = false;
 
     std::string key, value;
     std::string::const_iterator i = connectString.begin();
@@ -86,6 +91,22 @@ std::string chop_connect_string(std::string const & connectString,
         {
             single_row_mode = (value == "true" || value == "yes");
         }
+        else if (key == "binaryresults")
+        {
+            binary_results = (value == "true" || value == "yes");
+        }
+        else if (key == "binaryparams")
+        {
+            binary_params = (value == "true" || value == "yes");
+        }
+        else if (key == "bulkcopy")
+        {
+            bulk_copy = (value == "true" || value == "yes");
+        }
+        else if (key == "pipeline")
+        {
+            pipeline_bulk = (value == "true" || value == "yes");
+        }
         else
         {
             if (pruned_conn_string.empty() == false)
@@ -107,14 +128,20 @@ postgresql_session_backend * postgresql_backend_factory::make_session(
      connection_parameters const & parameters) const
 {
     bool single_row_mode;
+    bool binary_results;
+    bool binary_params;
+    bool bulk_copy;
+    bool pipeline_bulk;
 
     const std::string pruned_conn_string =
-        chop_connect_string(parameters.get_connect_string(), single_row_mode);
+        chop_connect_string(parameters.get_connect_string(), single_row_mode,
+            binary_results, binary_params, bulk_copy, pipeline_bulk);
 
     connection_parameters pruned_parameters(parameters);
     pruned_parameters.set_connect_string(pruned_conn_string);
 
-    return new postgresql_session_backend(pruned_parameters, single_row_mode);
+    return new postgresql_session_backend(pruned_parameters, single_row_mode,
+        binary_results, binary_params, bulk_copy, pipeline_bulk);
 }
 
 postgresql_backend_factory const soci::postgresql;
@@ -13,6 +13,7 @@
 #include <libpq/libpq-fs.h> // libpq
 #include <cctype>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <sstream>
@@ -30,13 +31,36 @@ void hard_exec(postgresql_session_backend & session_backend,
     postgresql_result(session_backend, PQexec(conn, query)).check_for_errors(errMsg);
 }
 
+#ifdef LIBPQ_HAS_PIPELINING
+
+// The maximal number of commands queued in pipeline mode before waiting for
+// their results: without this, both the client and the server could block
+// trying to send more data to each other.
+int const maxPipelinePending = 256;
+
+#endif // LIBPQ_HAS_PIPELINING
+
 } // namespace unnamed
 
 postgresql_session_backend::postgresql_session_backend(
-    connection_parameters const& parameters, bool single_row_mode)
-    : statementCount_(0)
+    connection_parameters const& parameters, bool single_row_mode,
+    bool binary_results, bool binary_params, bool bulk_copy,
+    bool pipeline_bulk)
+    : statementCount_(0), pipeline_(false), pipelinePending_(0),
+      pipelineRowsAffected_(0), pipelineError_(NULL)
 {
     single_row_mode_ = single_row_mode;
+    binary_results_ = binary_results;
+    binary_params_ = binary_params;
+    bulk_copy_ = bulk_copy;
+    pipeline_bulk_ = pipeline_bulk;
+
+#ifndef LIBPQ_HAS_PIPELINING
+    if (pipeline_bulk_)
+    {
+        throw soci_error("Pipeline mode requires libpq 14 or later.");
+    }
+#endif // !LIBPQ_HAS_PIPELINING
 
     connect(parameters);
 }
@@ -68,6 +92,21 @@ void postgresql_session_backend::connect(
                          : "SET extra_float_digits = 2",
         "Cannot set extra_float_digits parameter");
 
+    if (binary_results_ || binary_params_)
+    {
+        // Timestamps in binary format are only handled as 64-bit integers,
+        // which is the default since PostgreSQL 8.4.
+        char const * const integerDatetimes =
+            PQparameterStatus(conn, "integer_datetimes");
+        if (integerDatetimes == NULL ||
+            std::strcmp(integerDatetimes, "on") != 0)
+        {
+            PQfinish(conn);
+            throw soci_error("Binary results and parameters require the "
+                "server to use integer datetimes.");
+        }
+    }
+
     conn_ = conn;
 }
 
@@ -78,24 +117,65 @@ postgresql_session_backend::~postgresql_session_backend()
 
 void postgresql_session_backend::begin()
 {
+    sync_pipeline();
     hard_exec(*this, conn_, "BEGIN", "Cannot begin transaction.");
 }
 
 void postgresql_session_backend::commit()
 {
+    sync_pipeline();
     hard_exec(*this, conn_, "COMMIT", "Cannot commit transaction.");
 }
 
 void postgresql_session_backend::rollback()
 {
+    // Don't throw if any of the queued commands failed: this is probably the
+    // reason why the transaction is being rolled back in the first place.
+    try
+    {
+        sync_pipeline();
+    }
+    catch (soci_error const &)
+    {
+    }
+
     hard_exec(*this, conn_, "ROLLBACK", "Cannot rollback transaction.");
 }
 
+bool postgresql_session_backend::is_connected()
+{
+    // The connection status is only updated when communicating with the
+    // server, so send an empty query to it, unless this would interfere with
+    // the commands queued in pipeline mode.
+    if (PQstatus(conn_) == CONNECTION_OK && pipeline_ == false)
+    {
+        postgresql_result(*this, PQexec(conn_, ""));
+    }
+
+    return PQstatus(conn_) == CONNECTION_OK;
+}
+
 void postgresql_session_backend::deallocate_prepared_statement(
     const std::string & statementName)
 {
     const std::string & query = "DEALLOCATE " + statementName;
 
+#ifdef LIBPQ_HAS_PIPELINING
+    if (PQpipelineStatus(conn_) != PQ_PIPELINE_OFF)
+    {
+        // Queue the command after the executions of this statement which
+        // may still be pending instead of waiting for them.
+        if (PQsendQueryParams(conn_, query.c_str(),
+                0, NULL, NULL, NULL, NULL, 0) != 1)
+        {
+            throw soci_error("Cannot deallocate prepared statement.");
+        }
+
+        pipeline_command_sent();
+        return;
+    }
+#endif // LIBPQ_HAS_PIPELINING
+
     hard_exec(*this, conn_, query.c_str(),
         "Cannot deallocate prepared statement.");
 }
@@ -108,8 +188,142 @@ bool postgresql_session_backend::get_next_sequence_value(
     return true;
 }
 
+void postgresql_session_backend::begin_pipeline()
+{
+#ifdef LIBPQ_HAS_PIPELINING
+    if (pipeline_)
+    {
+        throw soci_error("Pipeline mode is already active.");
+    }
+
+    pipeline_ = true;
+#else // !LIBPQ_HAS_PIPELINING
+    throw soci_error("Pipeline mode requires libpq 14 or later.");
+#endif // LIBPQ_HAS_PIPELINING
+}
+
+long long postgresql_session_backend::end_pipeline()
+{
+    if (!pipeline_)
+    {
+        throw soci_error("Pipeline mode is not active.");
+    }
+
+    pipeline_ = false;
+
+    return sync_pipeline();
+}
+
+long long postgresql_session_backend::sync_pipeline()
+{
+#ifdef LIBPQ_HAS_PIPELINING
+    if (PQpipelineStatus(conn_) == PQ_PIPELINE_OFF)
+    {
+        return 0;
+    }
+
+    // Even if sending the synchronization point fails, because the
+    // connection is broken, we still need to consume the pending results.
+    bool const synced = PQpipelineSync(conn_) == 1;
+
+    consume_pipeline_results();
+
+    if (synced)
+    {
+        // Consume the result corresponding to the synchronization point.
+        postgresql_result(*this, PQgetResult(conn_));
+    }
+
+    bool const exited = PQexitPipelineMode(conn_) == 1;
+
+    // Keep accumulating the number of affected rows until the end of the
+    // explicit pipeline, if any.
+    long long const rowsAffected = pipelineRowsAffected_;
+    if (!pipeline_)
+    {
+        pipelineRowsAffected_ = 0;
+    }
+
+    if (pipelineError_ != NULL)
+    {
+        postgresql_result result(*this, pipelineError_);
+        pipelineError_ = NULL;
+
+        result.check_for_errors("Cannot execute pipelined query.");
+    }
+
+    if (!synced || !exited)
+    {
+        std::string msg("Cannot leave pipeline mode.\n");
+        msg += PQerrorMessage(conn_);
+        throw soci_error(msg);
+    }
+
+    return rowsAffected;
+#else // !LIBPQ_HAS_PIPELINING
+    return 0;
+#endif // LIBPQ_HAS_PIPELINING
+}
+
+void postgresql_session_backend::pipeline_command_sent()
+{
+#ifdef LIBPQ_HAS_PIPELINING
+    if (++pipelinePending_ >= maxPipelinePending)
+    {
+        // Ask the server to send the results it has so far and consume them.
+        if (PQsendFlushRequest(conn_) != 1 || PQflush(conn_) != 0)
+        {
+            std::string msg("Cannot flush the pipeline.\n");
+            msg += PQerrorMessage(conn_);
+            throw soci_error(msg);
+        }
+
+        consume_pipeline_results();
+    }
+#endif // LIBPQ_HAS_PIPELINING
+}
+
+void postgresql_session_backend::consume_pipeline_results()
+{
+    for (; pipelinePending_ > 0; --pipelinePending_)
+    {
+        // Each command produces one or more results followed by NULL.
+        while (PGresult * res = PQgetResult(conn_))
+        {
+            switch (PQresultStatus(res))
+            {
+            case PGRES_COMMAND_OK:
+            case PGRES_TUPLES_OK:
+                pipelineRowsAffected_ +=
+                    std::strtoll(PQcmdTuples(res), NULL, 10);
+                PQclear(res);
+                break;
+
+            default:
+                // Keep only the first error: all the commands after it
+                // are aborted by the server anyhow.
+                if (pipelineError_ == NULL)
+                {
+                    pipelineError_ = res;
+                }
+                else
+                {
+                    PQclear(res);
+                }
+                break;
+            }
+        }
+    }
+}
+
 void postgresql_session_backend::clean_up()
 {
+    PQclear(pipelineError_);
+    pipelineError_ = NULL;
+    pipelinePending_ = 0;
+    pipelineRowsAffected_ = 0;
+    pipeline_ = false;
+
     if (0 != conn_)
     {
         PQfinish(conn_);
@@ -15,7 +15,6 @@
 #include "soci/blob.h"
 #include "soci/type-wrappers.h"
 #include "soci-exchange-cast.h"
-#include <libpq/libpq-fs.h> // libpq
 #include <cctype>
 #include <cstdio>
 #include <cstring>
@@ -78,9 +77,18 @@ void postgresql_standard_into_type_backend::post_fetch(
             }
         }
 
+        PGresult const * const res = statement_.result_;
+        int const row = statement_.currentRow_;
+
+        if (PQfformat(res, pos) != 0)
+        {
+            // binary results were requested
+            post_fetch_binary(res, row, pos);
+            return;
+        }
+
         // raw data, in text format
-        char const * buf = PQgetvalue(statement_.result_,
-            statement_.currentRow_, pos);
+        char const * buf = PQgetvalue(res, row, pos);
 
         switch (type_)
         {
@@ -110,41 +118,10 @@ void postgresql_standard_into_type_backend::post_fetch(
             parse_std_tm(buf, exchange_type_cast<x_stdtm>(data_));
             break;
         case x_rowid:
-            {
-                // RowID is internally identical to unsigned long
-
-                rowid * rid = static_cast<rowid *>(data_);
-                postgresql_rowid_backend * rbe
-                    = static_cast<postgresql_rowid_backend *>(
-                        rid->get_backend());
-
-                rbe->value_ = string_to_unsigned_integer<unsigned long>(buf);
-            }
+            set_rowid(string_to_unsigned_integer<unsigned long>(buf));
             break;
         case x_blob:
-            {
-                unsigned long oid =
-                    string_to_unsigned_integer<unsigned long>(buf);
-
-                int fd = lo_open(statement_.session_.conn_, oid,
-                    INV_READ | INV_WRITE);
-                if (fd == -1)
-                {
-                    throw soci_error("Cannot open the blob object.");
-                }
-
-                blob * b = static_cast<blob *>(data_);
-                postgresql_blob_backend * bbe
-                     = static_cast<postgresql_blob_backend *>(b->get_backend());
-
-                if (bbe->fd_ != -1)
-                {
-                    lo_close(statement_.session_.conn_, bbe->fd_);
-                }
-
-                bbe->fd_ = fd;
-                bbe->oid_ = oid;
-            }
+            set_blob(string_to_unsigned_integer<unsigned long>(buf));
             break;
         case x_xmltype:
             exchange_type_cast<x_xmltype>(data_).value.assign(buf);
@@ -159,6 +136,77 @@ void postgresql_standard_into_type_backend::post_fetch(
     }
 }
 
+void postgresql_standard_into_type_backend::post_fetch_binary(
+    PGresult const * res, int row, int pos)
+{
+    switch (type_)
+    {
+    case x_char:
+        {
+            std::string s;
+            binary_to_string(res, row, pos, s);
+            exchange_type_cast<x_char>(data_) = s.empty() ? '\0' : s[0];
+        }
+        break;
+    case x_stdstring:
+        binary_to_string(res, row, pos, exchange_type_cast<x_stdstring>(data_));
+        break;
+    case x_short:
+        exchange_type_cast<x_short>(data_) = binary_to_integer<short>(res, row, pos);
+        break;
+    case x_integer:
+        exchange_type_cast<x_integer>(data_) = binary_to_integer<int>(res, row, pos);
+        break;
+    case x_long_long:
+        exchange_type_cast<x_long_long>(data_) = binary_to_integer<long long>(res, row, pos);
+        break;
+    case x_unsigned_long_long:
+        exchange_type_cast<x_unsigned_long_long>(data_) = binary_to_integer<unsigned long long>(res, row, pos);
+        break;
+    case x_double:
+        exchange_type_cast<x_double>(data_) = binary_to_double(res, row, pos);
+        break;
+    case x_stdtm:
+        binary_to_std_tm(res, row, pos, exchange_type_cast<x_stdtm>(data_));
+        break;
+    case x_rowid:
+        set_rowid(binary_to_integer<unsigned long>(res, row, pos));
+        break;
+    case x_blob:
+        set_blob(binary_to_integer<unsigned long>(res, row, pos));
+        break;
+    case x_xmltype:
+        binary_to_string(res, row, pos, exchange_type_cast<x_xmltype>(data_).value);
+        break;
+    case x_longstring:
+        binary_to_string(res, row, pos, exchange_type_cast<x_longstring>(data_).value);
+        break;
+
+    default:
+        throw soci_error("Into element used with non-supported type.");
+    }
+}
+
+void postgresql_standard_into_type_backend::set_rowid(unsigned long value)
+{
+    // RowID is internally identical to unsigned long
+
+    rowid * rid = static_cast<rowid *>(data_);
+    postgresql_rowid_backend * rbe
+        = static_cast<postgresql_rowid_backend *>(rid->get_backend());
+
+    rbe->value_ = value;
+}
+
+void postgresql_standard_into_type_backend::set_blob(unsigned long oid)
+{
+    blob * b = static_cast<blob *>(data_);
+    postgresql_blob_backend * bbe
+         = static_cast<postgresql_blob_backend *>(b->get_backend());
+
+    bbe->open(oid);
+}
+
 void postgresql_standard_into_type_backend::clean_up()
 {
     // nothing to do here
@@ -13,6 +13,7 @@
 #include "soci/soci-platform.h"
 #include "soci-dtocstr.h"
 #include "soci-exchange-cast.h"
+#include "common.h"
 #include <libpq/libpq-fs.h> // libpq
 #include <cctype>
 #include <cstdio>
@@ -23,6 +24,7 @@
 
 using namespace soci;
 using namespace soci::details;
+using namespace soci::details::postgresql;
 
 void postgresql_standard_use_type_backend::bind_by_pos(
     int & position, void * data, exchange_type type, bool /* readOnly */)
@@ -48,10 +50,18 @@ void postgresql_standard_use_type_backend::bind_by_name(
 
 void postgresql_standard_use_type_backend::pre_use(indicator const * ind)
 {
+    Oid const paramType = statement_.get_binary_param_type(position_, name_);
+
+    length_ = -1;
     if (ind != NULL && *ind == i_null)
     {
         // leave the working buffer as NULL
     }
+    else if (paramType != 0 &&
+        (buf_ = make_binary_param(paramType, type_, data_, length_)) != NULL)
+    {
+        // the value will be sent in binary format
+    }
     else
     {
         // allocate and fill the buffer with text-formatted client data
@@ -161,11 +171,13 @@ void postgresql_standard_use_type_backend::pre_use(indicator const * ind)
     {
         // binding by position
         statement_.useByPosBuffers_[position_] = &buf_;
+        statement_.useByPosLengths_[position_] = &length_;
     }
     else
     {
         // binding by name
         statement_.useByNameBuffers_[name_] = &buf_;
+        statement_.useByNameLengths_[name_] = &length_;
     }
 }
 
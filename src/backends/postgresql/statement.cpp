@@ -9,6 +9,7 @@
 #include "soci/postgresql/soci-postgresql.h"
 #include "soci/soci-platform.h"
 #include <libpq/libpq-fs.h> // libpq
+#include <algorithm>
 #include <cctype>
 #include <cstdio>
 #include <cstdlib>
@@ -41,6 +42,41 @@ void wait_until_operation_complete(postgresql_session_backend & session)
     }
 }
 
+void skip_spaces(std::string::const_iterator & it,
+    std::string::const_iterator const & end)
+{
+    while (it != end && std::isspace(static_cast<unsigned char>(*it)))
+    {
+        ++it;
+    }
+}
+
+// Skip the given (lower case) keyword, preceded by white space, if it's
+// present and return true or return false if it isn't.
+bool skip_keyword(std::string::const_iterator & it,
+    std::string::const_iterator const & end, char const * keyword)
+{
+    skip_spaces(it, end);
+
+    std::string::const_iterator p = it;
+    for (; *keyword != '\0'; ++keyword, ++p)
+    {
+        if (p == end ||
+            std::tolower(static_cast<unsigned char>(*p)) != *keyword)
+        {
+            return false;
+        }
+    }
+
+    if (p != end && (std::isalnum(static_cast<unsigned char>(*p)) || *p == '_'))
+    {
+        return false;
+    }
+
+    it = p;
+    return true;
+}
+
 void throw_soci_error(PGconn * conn, const char * msg)
 {
     std::string description = msg;
@@ -50,13 +86,161 @@ void throw_soci_error(PGconn * conn, const char * msg)
     throw soci_error(description);
 }
 
+bool is_binary_length(int length)
+{
+    return length >= 0;
+}
+
+// Append the value to the COPY data in text format, escaping it as needed.
+void append_copy_value(std::string & data, char const * value)
+{
+    if (value == NULL)
+    {
+        data += "\\N";
+        return;
+    }
+
+    for (char const * p = value; *p != '\0'; ++p)
+    {
+        switch (*p)
+        {
+        case '\\':
+            data += "\\\\";
+            break;
+        case '\t':
+            data += "\\t";
+            break;
+        case '\n':
+            data += "\\n";
+            break;
+        case '\r':
+            data += "\\r";
+            break;
+        default:
+            data += *p;
+        }
+    }
+}
+
+// Return the "COPY ... FROM STDIN" query equivalent to the given query if it
+// is of the form "INSERT INTO table [(columns)] VALUES ($1, ..., $n)" or an
+// empty string otherwise.
+std::string make_copy_query(std::string const & query, int numberOfParams)
+{
+    std::string::const_iterator it = query.begin();
+    std::string::const_iterator const end = query.end();
+
+    if (numberOfParams == 0 ||
+        !skip_keyword(it, end, "insert") ||
+        !skip_keyword(it, end, "into"))
+    {
+        return std::string();
+    }
+
+    // Table name, possibly qualified and/or quoted, and the list of columns,
+    // if any, which are copied as is.
+    skip_spaces(it, end);
+    std::string::const_iterator const tableBegin = it;
+    while (it != end && !std::isspace(static_cast<unsigned char>(*it)) &&
+        *it != '(')
+    {
+        if (*it == '"')
+        {
+            it = std::find(it + 1, end, '"');
+            if (it == end)
+            {
+                return std::string();
+            }
+        }
+        ++it;
+    }
+    std::string const table(tableBegin, it);
+
+    std::string columns;
+    skip_spaces(it, end);
+    if (it != end && *it == '(')
+    {
+        std::string::const_iterator const columnsBegin = it;
+        it = std::find(it, end, ')');
+        if (it == end)
+        {
+            return std::string();
+        }
+        columns.assign(columnsBegin, ++it);
+        if (columns.find('"') != std::string::npos)
+        {
+            // Don't bother parsing quoted column names, which could contain
+            // parentheses.
+            return std::string();
+        }
+    }
+
+    if (table.empty() ||
+        !skip_keyword(it, end, "values"))
+    {
+        return std::string();
+    }
+
+    // The values must be exactly the parameters, in order.
+    skip_spaces(it, end);
+    if (it == end || *it++ != '(')
+    {
+        return std::string();
+    }
+    for (int i = 1; i <= numberOfParams; ++i)
+    {
+        skip_spaces(it, end);
+        if (it == end || *it++ != '$')
+        {
+            return std::string();
+        }
+
+        int n = 0;
+        while (it != end && std::isdigit(static_cast<unsigned char>(*it)))
+        {
+            n = n * 10 + (*it++ - '0');
+        }
+        if (n != i)
+        {
+            return std::string();
+        }
+
+        skip_spaces(it, end);
+        if (it == end || *it++ != (i == numberOfParams ? ')' : ','))
+        {
+            return std::string();
+        }
+    }
+
+    skip_spaces(it, end);
+    if (it != end && *it == ';')
+    {
+        ++it;
+        skip_spaces(it, end);
+    }
+    if (it != end)
+    {
+        return std::string();
+    }
+
+    std::string copyQuery = "COPY " + table;
+    if (columns.empty() == false)
+    {
+        copyQuery += ' ';
+        copyQuery += columns;
+    }
+    copyQuery += " FROM STDIN";
+    return copyQuery;
+}
+
 } // unnamed namespace
 
 postgresql_statement_backend::postgresql_statement_backend(
     postgresql_session_backend &session, bool single_row_mode)
     : session_(session), single_row_mode_(single_row_mode),
       result_(session, NULL),
-      rowsAffectedBulk_(-1LL), justDescribed_(false),
+      rowsAffectedBulk_(-1LL), justDescribed_(false), describing_(false),
+      pipelined_(false),
       hasIntoElements_(false), hasVectorIntoElements_(false),
       hasUseElements_(false), hasVectorUseElements_(false)
 {
@@ -201,6 +385,11 @@ void postgresql_statement_backend::prepare(std::string const & query,
         query_ += ss.str();
     }
 
+    if (session_.bulk_copy_)
+    {
+        copyQuery_ = make_copy_query(query_, static_cast<int>(names_.size()));
+    }
+
     if (stType == st_repeatable_query)
     {
         if (!statementName_.empty())
@@ -208,6 +397,9 @@ void postgresql_statement_backend::prepare(std::string const & query,
             throw soci_error("Shouldn't already have a prepared statement.");
         }
 
+        // Preparing the statement can't be done in pipeline mode.
+        session_.sync_pipeline();
+
         // Holding the name temporarily in this var because
         // if it fails to prepare it we can't DEALLOCATE it.
         std::string statementName = session_.get_next_statement_name();
@@ -240,6 +432,22 @@ void postgresql_statement_backend::prepare(std::string const & query,
 
         // Now it's safe to save this info.
         statementName_ = statementName;
+
+        if (session_.binary_params_ && !names_.empty())
+        {
+            // Find out the types of the parameters inferred by the server to
+            // know which of them can be sent in binary format.
+            postgresql_result result(session_,
+                PQdescribePrepared(session_.conn_, statementName_.c_str()));
+            result.check_for_errors("Cannot describe prepared statement.");
+
+            int const nParams = PQnparams(result);
+            paramTypes_.resize(nParams);
+            for (int i = 0; i != nParams; ++i)
+            {
+                paramTypes_[i] = PQparamtype(result, i);
+            }
+        }
     }
 
     stType_ = stType;
@@ -270,6 +478,9 @@ postgresql_statement_backend::execute(int number)
         // This object could have been already filled with data before.
         clean_up();
 
+        // text (0) or binary (1) format for the results
+        int const resultFormat = session_.binary_results_ ? 1 : 0;
+
         if ((number > 1) && hasIntoElements_)
         {
              throw soci_error(
@@ -291,6 +502,17 @@ postgresql_statement_backend::execute(int number)
              numberOfExecutions = hasUseElements_ ? 1 : number;
         }
 
+        // Unless this execution is queued too, wait for the results of the
+        // previously queued ones first. This is also needed for the bulk
+        // operations which are only pipelined until their end, so that the
+        // number of affected rows counts only their own rows.
+        bool const pipelined = use_pipeline(numberOfExecutions);
+        bool const queued = session_.pipeline_ || pipelined_;
+        if (!pipelined || !queued)
+        {
+            session_.sync_pipeline();
+        }
+
         if ((useByPosBuffers_.empty() == false) ||
             (useByNameBuffers_.empty() == false))
         {
@@ -301,47 +523,44 @@ postgresql_statement_backend::execute(int number)
                     "Binding for use elements must be either by position "
                     "or by name.");
             }
+            if (numberOfExecutions > 1 && copyQuery_.empty() == false)
+            {
+                // there are only bulk use elements, which can be loaded
+                // all at once
+                if (execute_copy(numberOfExecutions))
+                {
+                    return ef_no_data;
+                }
+            }
+
             long long rowsAffectedBulkTemp = 0;
             for (int i = 0; i != numberOfExecutions; ++i)
             {
                 std::vector<char *> paramValues;
+                std::vector<int> paramLengths;
+                get_param_values(i, paramValues, paramLengths);
 
-                if (useByPosBuffers_.empty() == false)
+                // Only the binary values have non-negative lengths.
+                std::vector<int> paramFormats(paramLengths.size());
+                bool hasBinaryParams = false;
+                for (std::size_t j = 0; j != paramLengths.size(); ++j)
                 {
-                    // use elements bind by position
-                    // the map of use buffers can be traversed
-                    // in its natural order
-
-                    for (UseByPosBuffersMap::iterator
-                             it = useByPosBuffers_.begin(),
-                             end = useByPosBuffers_.end();
-                         it != end; ++it)
+                    if (paramLengths[j] >= 0)
                     {
-                        char ** buffers = it->second;
-                        paramValues.push_back(buffers[i]);
+                        paramFormats[j] = 1;
+                        hasBinaryParams = true;
                     }
                 }
-                else
-                {
-                    // use elements bind by name
+                int const * const lengths =
+                    hasBinaryParams ? &paramLengths[0] : NULL;
+                int const * const formats =
+                    hasBinaryParams ? &paramFormats[0] : NULL;
 
-                    for (std::vector<std::string>::iterator
-                             it = names_.begin(), end = names_.end();
-                         it != end; ++it)
-                    {
-                        UseByNameBuffersMap::iterator b
-                            = useByNameBuffers_.find(*it);
-                        if (b == useByNameBuffers_.end())
-                        {
-                            std::string msg(
-                                "Missing use element for bind by name (");
-                            msg += *it;
-                            msg += ").";
-                            throw soci_error(msg);
-                        }
-                        char ** buffers = b->second;
-                        paramValues.push_back(buffers[i]);
-                    }
+                if (pipelined)
+                {
+                    send_pipelined(static_cast<int>(paramValues.size()),
+                        &paramValues[0], lengths, formats);
+                    continue;
                 }
 
                 if (stType_ == st_repeatable_query)
@@ -354,7 +573,7 @@ postgresql_statement_backend::execute(int number)
                         int result = PQsendQueryPrepared(session_.conn_,
                             statementName_.c_str(),
                             static_cast<int>(paramValues.size()),
-                            &paramValues[0], NULL, NULL, 0);
+                            &paramValues[0], lengths, formats, resultFormat);
                         if (result != 1)
                         {
                             throw_soci_error(session_.conn_,
@@ -376,7 +595,8 @@ postgresql_statement_backend::execute(int number)
                         result_.reset(PQexecPrepared(session_.conn_,
                                 statementName_.c_str(),
                                 static_cast<int>(paramValues.size()),
-                                &paramValues[0], NULL, NULL, 0));
+                                &paramValues[0], lengths, formats,
+                                resultFormat));
                     }
                 }
                 else // stType_ == st_one_time_query
@@ -389,7 +609,8 @@ postgresql_statement_backend::execute(int number)
                     {
                         int result = PQsendQueryParams(session_.conn_, query_.c_str(),
                             static_cast<int>(paramValues.size()),
-                            NULL, &paramValues[0], NULL, NULL, 0);
+                            NULL, &paramValues[0], lengths, formats,
+                            resultFormat);
                         if (result != 1)
                         {
                             throw_soci_error(session_.conn_,
@@ -410,7 +631,8 @@ postgresql_statement_backend::execute(int number)
 
                         result_.reset(PQexecParams(session_.conn_, query_.c_str(),
                                 static_cast<int>(paramValues.size()),
-                                NULL, &paramValues[0], NULL, NULL, 0));
+                                NULL, &paramValues[0], lengths, formats,
+                                resultFormat));
                     }
                 }
 
@@ -428,6 +650,15 @@ postgresql_statement_backend::execute(int number)
             }
             rowsAffectedBulk_ = rowsAffectedBulkTemp;
 
+            if (pipelined)
+            {
+                // The number of affected rows is only known once the results
+                // are received, which is done immediately for the bulk
+                // operations unless they're explicitly pipelined.
+                rowsAffectedBulk_ = queued ? -1 : session_.sync_pipeline();
+                return ef_no_data;
+            }
+
             if (numberOfExecutions > 1)
             {
                 // it was a bulk operation
@@ -441,6 +672,14 @@ postgresql_statement_backend::execute(int number)
         {
             // there are no use elements
             // - execute the query without parameter information
+            if (pipelined)
+            {
+                send_pipelined(0, NULL, NULL, NULL);
+
+                rowsAffectedBulk_ = queued ? -1 : session_.sync_pipeline();
+                return ef_no_data;
+            }
+
             if (stType_ == st_repeatable_query)
             {
                 // this query was separately prepared
@@ -449,7 +688,7 @@ postgresql_statement_backend::execute(int number)
                 if (single_row_mode_)
                 {
                     int result = PQsendQueryPrepared(session_.conn_,
-                        statementName_.c_str(), 0, NULL, NULL, NULL, 0);
+                        statementName_.c_str(), 0, NULL, NULL, NULL, resultFormat);
                     if (result != 1)
                     {
                         throw_soci_error(session_.conn_,
@@ -469,7 +708,7 @@ postgresql_statement_backend::execute(int number)
                     // default multi-row execution
 
                     result_.reset(PQexecPrepared(session_.conn_,
-                            statementName_.c_str(), 0, NULL, NULL, NULL, 0));
+                            statementName_.c_str(), 0, NULL, NULL, NULL, resultFormat));
                 }
             }
             else // stType_ == st_one_time_query
@@ -477,7 +716,10 @@ postgresql_statement_backend::execute(int number)
 #ifndef SOCI_POSTGRESQL_NOSINGLEROWMODE
                 if (single_row_mode_)
                 {
-                    int result = PQsendQuery(session_.conn_, query_.c_str());
+                    int result = resultFormat == 0
+                        ? PQsendQuery(session_.conn_, query_.c_str())
+                        : PQsendQueryParams(session_.conn_, query_.c_str(),
+                            0, NULL, NULL, NULL, NULL, resultFormat);
                     if (result != 1)
                     {
                         throw_soci_error(session_.conn_,
@@ -496,7 +738,11 @@ postgresql_statement_backend::execute(int number)
                 {
                     // default multi-row execution
 
-                    result_.reset(PQexec(session_.conn_, query_.c_str()));
+                    // PQexec() doesn't allow requesting binary results.
+                    result_.reset(resultFormat == 0
+                        ? PQexec(session_.conn_, query_.c_str())
+                        : PQexecParams(session_.conn_, query_.c_str(),
+                            0, NULL, NULL, NULL, NULL, resultFormat));
                 }
             }
         }
@@ -686,6 +932,237 @@ int postgresql_statement_backend::get_number_of_rows()
     return numberOfRows_ - currentRow_;
 }
 
+void postgresql_statement_backend::get_param_values(int row,
+    std::vector<char *> & paramValues, std::vector<int> & paramLengths)
+{
+    if (useByPosBuffers_.empty() == false)
+    {
+        // use elements bind by position
+        // the map of use buffers can be traversed
+        // in its natural order
+
+        for (UseByPosBuffersMap::iterator
+                 it = useByPosBuffers_.begin(),
+                 end = useByPosBuffers_.end();
+             it != end; ++it)
+        {
+            char ** buffers = it->second;
+            paramValues.push_back(buffers[row]);
+            // the length is always bound together with the buffer
+            UseByPosLengthsMap::const_iterator const
+                lit = useByPosLengths_.find(it->first);
+            paramLengths.push_back(lit->second[row]);
+        }
+    }
+    else
+    {
+        // use elements bind by name
+
+        for (std::vector<std::string>::iterator
+                 it = names_.begin(), end = names_.end();
+             it != end; ++it)
+        {
+            UseByNameBuffersMap::iterator b
+                = useByNameBuffers_.find(*it);
+            if (b == useByNameBuffers_.end())
+            {
+                std::string msg(
+                    "Missing use element for bind by name (");
+                msg += *it;
+                msg += ").";
+                throw soci_error(msg);
+            }
+            char ** buffers = b->second;
+            paramValues.push_back(buffers[row]);
+            UseByNameLengthsMap::const_iterator const
+                lit = useByNameLengths_.find(*it);
+            paramLengths.push_back(lit->second[row]);
+        }
+    }
+}
+
+bool postgresql_statement_backend::execute_copy(int numberOfRows)
+{
+    std::vector<char *> paramValues;
+    std::vector<int> paramLengths;
+
+    // COPY data is built in text format, so check that there are no binary
+    // values first and fall back to the usual execution if there are.
+    for (UseByPosLengthsMap::const_iterator it = useByPosLengths_.begin();
+         it != useByPosLengths_.end(); ++it)
+    {
+        if (std::find_if(it->second, it->second + numberOfRows,
+                is_binary_length) != it->second + numberOfRows)
+        {
+            return false;
+        }
+    }
+    for (UseByNameLengthsMap::const_iterator it = useByNameLengths_.begin();
+         it != useByNameLengths_.end(); ++it)
+    {
+        if (std::find_if(it->second, it->second + numberOfRows,
+                is_binary_length) != it->second + numberOfRows)
+        {
+            return false;
+        }
+    }
+
+    // COPY can't be done in pipeline mode.
+    session_.sync_pipeline();
+
+    postgresql_result result(session_,
+        PQexec(session_.conn_, copyQuery_.c_str()));
+    if (PQresultStatus(result) != PGRES_COPY_IN)
+    {
+        result.check_for_errors("Cannot start COPY.");
+        throw soci_error("Cannot start COPY.");
+    }
+
+    // Send the data in reasonably big chunks, to avoid both allocating too
+    // much memory and calling PQputCopyData() too often.
+    std::size_t const chunkSize = 64 * 1024;
+
+    std::string data;
+    data.reserve(chunkSize + 1024);
+    bool ok = true;
+    for (int i = 0; ok && i != numberOfRows; ++i)
+    {
+        paramValues.clear();
+        paramLengths.clear();
+        get_param_values(i, paramValues, paramLengths);
+
+        for (std::size_t j = 0; j != paramValues.size(); ++j)
+        {
+            if (j != 0)
+            {
+                data += '\t';
+            }
+
+            append_copy_value(data, paramValues[j]);
+        }
+        data += '\n';
+
+        if (data.size() >= chunkSize || i == numberOfRows - 1)
+        {
+            ok = PQputCopyData(session_.conn_, data.c_str(),
+                static_cast<int>(data.size())) == 1;
+            data.clear();
+        }
+    }
+
+    if (PQputCopyEnd(session_.conn_,
+            ok ? NULL : "Sending COPY data failed.") != 1)
+    {
+        ok = false;
+    }
+
+    // Get the result of COPY itself, which reports any errors in the data,
+    // and consume the final NULL result.
+    result.reset(PQgetResult(session_.conn_));
+    for (PGresult * res = PQgetResult(session_.conn_); res != NULL;
+         res = PQgetResult(session_.conn_))
+    {
+        PQclear(res);
+    }
+
+    result.check_for_errors("Cannot execute COPY.");
+
+    if (!ok)
+    {
+        throw_soci_error(session_.conn_, "Cannot send COPY data");
+    }
+
+    rowsAffectedBulk_ = std::strtoll(PQcmdTuples(result.get_result()), NULL, 10);
+    result_.reset();
+
+    return true;
+}
+
+bool postgresql_statement_backend::use_pipeline(int numberOfExecutions) const
+{
+    // The results are needed immediately when there are any into elements
+    // or when describing the columns to create them.
+    if (hasIntoElements_ || hasVectorIntoElements_ || single_row_mode_ ||
+        describing_)
+    {
+        return false;
+    }
+
+    return session_.pipeline_ || pipelined_ ||
+        (session_.pipeline_bulk_ && numberOfExecutions > 1);
+}
+
+void postgresql_statement_backend::send_pipelined(int nParams,
+    char const * const * paramValues,
+    int const * paramLengths, int const * paramFormats)
+{
+#ifdef LIBPQ_HAS_PIPELINING
+    if (PQpipelineStatus(session_.conn_) == PQ_PIPELINE_OFF)
+    {
+        if (PQenterPipelineMode(session_.conn_) != 1)
+        {
+            throw_soci_error(session_.conn_, "Cannot enter pipeline mode");
+        }
+    }
+
+    int const resultFormat = session_.binary_results_ ? 1 : 0;
+
+    int const result = stType_ == st_repeatable_query
+        ? PQsendQueryPrepared(session_.conn_, statementName_.c_str(),
+            nParams, paramValues, paramLengths, paramFormats, resultFormat)
+        : PQsendQueryParams(session_.conn_, query_.c_str(),
+            nParams, NULL, paramValues, paramLengths, paramFormats,
+            resultFormat);
+    if (result != 1)
+    {
+        throw_soci_error(session_.conn_, "Cannot queue query in pipeline mode");
+    }
+
+    result_.reset();
+
+    session_.pipeline_command_sent();
+#else // !LIBPQ_HAS_PIPELINING
+    SOCI_UNUSED(nParams)
+    SOCI_UNUSED(paramValues)
+    SOCI_UNUSED(paramLengths)
+    SOCI_UNUSED(paramFormats)
+
+    throw soci_error("Pipeline mode requires libpq 14 or later.");
+#endif // LIBPQ_HAS_PIPELINING
+}
+
+Oid postgresql_statement_backend::get_binary_param_type(
+    int position, std::string const & name) const
+{
+    if (paramTypes_.empty())
+    {
+        return 0;
+    }
+
+    if (position > 0)
+    {
+        return static_cast<std::size_t>(position) <= paramTypes_.size()
+            ? paramTypes_[position - 1]
+            : 0;
+    }
+
+    // The same value is used for all occurrences of the name, so it can only
+    // be sent in binary format if all of them have the same type.
+    Oid type = 0;
+    for (std::size_t i = 0; i != names_.size() && i != paramTypes_.size(); ++i)
+    {
+        if (names_[i] == name)
+        {
+            if (type != 0 && type != paramTypes_[i])
+            {
+                return 0;
+            }
+            type = paramTypes_[i];
+        }
+    }
+    return type;
+}
+
 std::string postgresql_statement_backend::get_parameter_name(int index) const
 {
     return names_.at(index);
@@ -701,7 +1178,18 @@ std::string postgresql_statement_backend::rewrite_for_procedure_call(
 
 int postgresql_statement_backend::prepare_for_describe()
 {
-    execute(1);
+    describing_ = true;
+    try
+    {
+        execute(1);
+    }
+    catch (...)
+    {
+        describing_ = false;
+        throw;
+    }
+    describing_ = false;
+
     justDescribed_ = true;
 
     int columns = PQnfields(result_);
@@ -783,6 +1271,34 @@ void postgresql_statement_backend::describe_column(int colNum, data_type & type,
     columnName = PQfname(result_, pos);
 }
 
+bool postgresql_statement_backend::can_reuse_described_columns() const
+{
+    // The server refuses to execute a prepared statement if its result
+    // columns changed since it was prepared ("cached plan must not change
+    // result type"), but the unnamed ones are parsed anew every time.
+    return !statementName_.empty();
+}
+
+void postgresql_statement_backend::reset_for_reuse()
+{
+    result_.reset();
+    rowsAffectedBulk_ = -1;
+    justDescribed_ = false;
+    pipelined_ = false;
+
+    // the buffers and their lengths belong to the use elements which don't
+    // exist any more
+    useByPosBuffers_.clear();
+    useByNameBuffers_.clear();
+    useByPosLengths_.clear();
+    useByNameLengths_.clear();
+
+    hasIntoElements_ = false;
+    hasVectorIntoElements_ = false;
+    hasUseElements_ = false;
+    hasVectorUseElements_ = false;
+}
+
 postgresql_standard_into_type_backend *
 postgresql_statement_backend::make_into_type_backend()
 {
@@ -79,6 +79,9 @@ void postgresql_vector_into_type_backend::post_fetch(bool gotData, indicator * i
 
         int const endRow = statement_.currentRow_ + statement_.rowsToConsume_;
 
+        // true if binary results were requested
+        bool const binary = PQfformat(statement_.result_, pos) != 0;
+
         for (int curRow = statement_.currentRow_, i = begin_;
              curRow != endRow; ++curRow, ++i)
         {
@@ -104,6 +107,12 @@ void postgresql_vector_into_type_backend::post_fetch(bool gotData, indicator * i
                 }
             }
 
+            if (binary)
+            {
+                post_fetch_binary(statement_.result_, curRow, pos, i);
+                continue;
+            }
+
             // buffer with data retrieved from server, in text format
             char * buf = PQgetvalue(statement_.result_, curRow, pos);
 
@@ -173,6 +182,68 @@ void postgresql_vector_into_type_backend::post_fetch(bool gotData, indicator * i
     }
 }
 
+void postgresql_vector_into_type_backend::post_fetch_binary(
+    PGresult const * res, int row, int pos, int i)
+{
+    switch (type_)
+    {
+    case x_char:
+        {
+            std::string s;
+            binary_to_string(res, row, pos, s);
+            set_invector_(data_, i, s.empty() ? '\0' : s[0]);
+        }
+        break;
+    case x_stdstring:
+        {
+            std::vector<std::string> & v
+                = *static_cast<std::vector<std::string> *>(data_);
+            binary_to_string(res, row, pos, v[i]);
+        }
+        break;
+    case x_short:
+        set_invector_(data_, i, binary_to_integer<short>(res, row, pos));
+        break;
+    case x_integer:
+        set_invector_(data_, i, binary_to_integer<int>(res, row, pos));
+        break;
+    case x_long_long:
+        set_invector_(data_, i, binary_to_integer<long long>(res, row, pos));
+        break;
+    case x_unsigned_long_long:
+        set_invector_(data_, i,
+            binary_to_integer<unsigned long long>(res, row, pos));
+        break;
+    case x_double:
+        set_invector_(data_, i, binary_to_double(res, row, pos));
+        break;
+    case x_stdtm:
+        {
+            std::vector<std::tm> & v
+                = *static_cast<std::vector<std::tm> *>(data_);
+            binary_to_std_tm(res, row, pos, v[i]);
+        }
+        break;
+    case x_xmltype:
+        {
+            std::vector<xml_type> & v
+                = *static_cast<std::vector<xml_type> *>(data_);
+            binary_to_string(res, row, pos, v[i].value);
+        }
+        break;
+    case x_longstring:
+        {
+            std::vector<long_string> & v
+                = *static_cast<std::vector<long_string> *>(data_);
+            binary_to_string(res, row, pos, v[i].value);
+        }
+        break;
+
+    default:
+        throw soci_error("Into element used with non-supported type.");
+    }
+}
+
 namespace // anonymous
 {
 
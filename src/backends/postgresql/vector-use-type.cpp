@@ -50,8 +50,52 @@ void postgresql_vector_use_type_backend::bind_by_name_bulk(
     end_var_ = full_size();
 }
 
+namespace // anonymous
+{
+
+template <typename T>
+void * get_element(void * p, std::size_t i)
+{
+    std::vector<T> & v = *static_cast<std::vector<T> *>(p);
+    return &v[i];
+}
+
+// Return the address of the element which can be passed to
+// make_binary_param() or NULL if it can't be sent in binary format anyhow.
+void * get_binary_element(void * data, exchange_type type, std::size_t i)
+{
+    switch (type)
+    {
+    case x_short:
+        return get_element<short>(data, i);
+    case x_integer:
+        return get_element<int>(data, i);
+    case x_long_long:
+        return get_element<long long>(data, i);
+    case x_unsigned_long_long:
+        return get_element<unsigned long long>(data, i);
+    case x_double:
+        return get_element<double>(data, i);
+    case x_stdtm:
+        return get_element<std::tm>(data, i);
+    case x_stdstring:
+        return get_element<std::string>(data, i);
+    case x_longstring:
+        return get_element<long_string>(data, i);
+    default:
+        return NULL;
+    }
+}
+
+} // namespace anonymous
+
 void postgresql_vector_use_type_backend::pre_use(indicator const * ind)
 {
+    // free the buffers of the previous execution, if any
+    clean_up();
+
+    Oid const paramType = statement_.get_binary_param_type(position_, name_);
+
     std::size_t vend;
 
     if (end_ != NULL && *end_ != 0)
@@ -66,12 +110,18 @@ void postgresql_vector_use_type_backend::pre_use(indicator const * ind)
     for (size_t i = begin_; i != vend; ++i)
     {
         char * buf;
+        int length = -1;
 
         // the data in vector can be either i_ok or i_null
         if (ind != NULL && ind[i] == i_null)
         {
             buf = NULL;
         }
+        else if (paramType != 0 && (buf = make_binary_param(paramType, type_,
+                    get_binary_element(data_, type_, i), length)) != NULL)
+        {
+            // the value will be sent in binary format
+        }
         else
         {
             // allocate and fill the buffer with text-formatted client data
@@ -200,17 +250,20 @@ void postgresql_vector_use_type_backend::pre_use(indicator const * ind)
         }
 
         buffers_.push_back(buf);
+        lengths_.push_back(length);
     }
 
     if (position_ > 0)
     {
         // binding by position
         statement_.useByPosBuffers_[position_] = &buffers_[0];
+        statement_.useByPosLengths_[position_] = &lengths_[0];
     }
     else
     {
         // binding by name
         statement_.useByNameBuffers_[name_] = &buffers_[0];
+        statement_.useByNameLengths_[name_] = &lengths_[0];
     }
 }
 
@@ -285,4 +338,7 @@ void postgresql_vector_use_type_backend::clean_up()
     {
         delete [] buffers_[i];
     }
+
+    buffers_.clear();
+    lengths_.clear();
 }
@@ -10,42 +10,162 @@
 
 #include <algorithm>
 #include <cstring>
+#include <sstream>
 
 using namespace soci;
+using namespace sqlite_api;
+
+namespace // anonymous
+{
+
+void check_blob_err(sqlite_api::sqlite3 * conn, int res, char const * errMsg)
+{
+    if (res != SQLITE_OK)
+    {
+        std::ostringstream ss;
+        ss << errMsg << sqlite3_errmsg(conn);
+        throw sqlite3_soci_error(ss.str(), res);
+    }
+}
+
+} // namespace anonymous
 
 sqlite3_blob_backend::sqlite3_blob_backend(sqlite3_session_backend &session)
-    : session_(session), buf_(0), len_(0)
+    : session_(session), buf_(0), len_(0), capacity_(0), blob_(NULL)
 {
 }
 
 sqlite3_blob_backend::~sqlite3_blob_backend()
 {
+    if (blob_)
+    {
+        sqlite3_blob_close(blob_);
+    }
+
+    delete [] buf_;
+}
+
+void sqlite3_blob_backend::open(std::string const & table,
+    std::string const & column, sqlite3_int64 rowid, bool readWrite,
+    std::string const & database)
+{
+    close();
+
+    int const res = sqlite3_blob_open(session_.conn_, database.c_str(),
+        table.c_str(), column.c_str(), rowid, readWrite ? 1 : 0, &blob_);
+    if (res != SQLITE_OK)
+    {
+        // the handle is set to NULL or to a handle which must still be closed
+        if (blob_)
+        {
+            sqlite3_blob_close(blob_);
+            blob_ = NULL;
+        }
+
+        check_blob_err(session_.conn_, res, "Cannot open BLOB: ");
+    }
+
+    len_ = 0;
+}
+
+void sqlite3_blob_backend::reopen(sqlite3_int64 rowid)
+{
+    if (!blob_)
+    {
+        throw soci_error("Cannot reopen BLOB which is not open.");
+    }
+
+    int const res = sqlite3_blob_reopen(blob_, rowid);
+    if (res != SQLITE_OK)
+    {
+        // the handle can't be used any more after a failure
+        sqlite3_blob_close(blob_);
+        blob_ = NULL;
+
+        check_blob_err(session_.conn_, res, "Cannot reopen BLOB: ");
+    }
+}
+
+void sqlite3_blob_backend::close()
+{
+    if (blob_)
+    {
+        int const res = sqlite3_blob_close(blob_);
+        blob_ = NULL;
+
+        check_blob_err(session_.conn_, res, "Cannot close BLOB: ");
+    }
+}
+
+void sqlite3_blob_backend::check_not_open(char const * operation) const
+{
+    if (blob_)
+    {
+        std::string msg("Cannot ");
+        msg += operation;
+        msg += " BLOB open for incremental I/O.";
+        throw soci_error(msg);
+    }
+}
+
+void sqlite3_blob_backend::ensure_capacity(std::size_t size)
+{
+    // notice that we always allocate the buffer, even if it's empty, as a
+    // NULL buffer would be bound as NULL and not as an empty blob
+    if (buf_ && size <= capacity_)
+    {
+        return;
+    }
+
+    // grow the buffer geometrically to make appending to it in chunks take
+    // amortized linear time
+    std::size_t const newCapacity = (std::max)(size, 2 * capacity_);
+
+    char * const newBuf = new char[newCapacity];
     if (buf_)
     {
+        memcpy(newBuf, buf_, len_);
         delete [] buf_;
-        buf_ = 0;
-        len_ = 0;
     }
+
+    buf_ = newBuf;
+    capacity_ = newCapacity;
 }
 
 std::size_t sqlite3_blob_backend::get_len()
 {
+    if (blob_)
+    {
+        return static_cast<std::size_t>(sqlite3_blob_bytes(blob_));
+    }
+
     return len_;
 }
 
 std::size_t sqlite3_blob_backend::read(
     std::size_t offset, char * buf, std::size_t toRead)
 {
-    size_t r = toRead;
+    std::size_t const len = get_len();
 
     // make sure that we don't try to read
     // past the end of the data
-    if (r > len_ - offset)
+    if (offset >= len)
     {
-        r = len_ - offset;
+        return 0;
     }
 
-    memcpy(buf, buf_ + offset, r);
+    std::size_t const r = (std::min)(toRead, len - offset);
+
+    if (blob_)
+    {
+        int const res = sqlite3_blob_read(blob_, buf,
+            static_cast<int>(r), static_cast<int>(offset));
+        check_blob_err(session_.conn_, res, "Cannot read BLOB: ");
+    }
+    else
+    {
+        memcpy(buf, buf_ + offset, r);
+    }
 
     return r;
 }
@@ -55,21 +175,37 @@ std::size_t sqlite3_blob_backend::write(
     std::size_t offset, char const * buf,
     std::size_t toWrite)
 {
-    const char* oldBuf = buf_;
-    std::size_t oldLen = len_;
-    len_ = (std::max)(len_, offset + toWrite);
+    if (blob_)
+    {
+        // incremental I/O can't change the size of the value
+        std::size_t const len = get_len();
+        if (offset > len || toWrite > len - offset)
+        {
+            throw soci_error("Cannot write past the end of BLOB open for "
+                             "incremental I/O.");
+        }
+
+        int const res = sqlite3_blob_write(blob_, buf,
+            static_cast<int>(toWrite), static_cast<int>(offset));
+        check_blob_err(session_.conn_, res, "Cannot write BLOB: ");
+
+        return len;
+    }
 
-    buf_ = new char[len_];
+    std::size_t const newLen = (std::max)(len_, offset + toWrite);
+    ensure_capacity(newLen);
 
-    if (oldBuf)
+    // the gap between the old end and the offset, if any, is zero-filled
+    if (offset > len_)
     {
-        // we need to copy both old and new buffers
-        // it is possible that the new does not
-        // completely cover the old
-        memcpy(buf_, oldBuf, oldLen);
-        delete [] oldBuf;
+        memset(buf_ + len_, 0, offset - len_);
     }
-    memcpy(buf_ + offset, buf, toWrite);
+
+    if (toWrite)
+    {
+        memcpy(buf_ + offset, buf, toWrite);
+    }
+    len_ = newLen;
 
     return len_;
 }
@@ -78,41 +214,37 @@ std::size_t sqlite3_blob_backend::write(
 std::size_t sqlite3_blob_backend::append(
     char const * buf, std::size_t toWrite)
 {
-    const char* oldBuf = buf_;
+    check_not_open("append to");
 
-    buf_ = new char[len_ + toWrite];
-
-    memcpy(buf_, oldBuf, len_);
-
-    memcpy(buf_ + len_, buf, toWrite);
-
-    delete [] oldBuf;
-
-    len_ += toWrite;
-
-    return len_;
+    return write(len_, buf, toWrite);
 }
 
 
 void sqlite3_blob_backend::trim(std::size_t newLen)
 {
-    const char* oldBuf = buf_;
-    len_ = newLen;
-
-    buf_ = new char[len_];
+    check_not_open("trim");
 
-    memcpy(buf_, oldBuf, len_);
+    if (newLen > len_)
+    {
+        throw soci_error("Cannot trim BLOB to a bigger size.");
+    }
 
-    delete [] oldBuf;
+    len_ = newLen;
 }
 
 std::size_t sqlite3_blob_backend::set_data(char const *buf, std::size_t toWrite)
 {
-    if (buf_)
-    {
-        delete [] buf_;
-        buf_ = 0;
-        len_ = 0;
-    }
+    // fetching a new value detaches the blob from the old one
+    close();
+
+    // reuse the existing buffer if it's big enough
+    len_ = 0;
     return write(0, buf, toWrite);
 }
+
+const char *sqlite3_blob_backend::get_buffer() const
+{
+    check_not_open("bind");
+
+    return buf_;
+}
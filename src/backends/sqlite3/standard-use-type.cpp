@@ -13,6 +13,7 @@
 #include "soci-dtocstr.h"
 #include "soci-exchange-cast.h"
 // std
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -74,15 +75,11 @@ void sqlite3_standard_use_type_backend::bind_by_name(std::string const& name,
 
 void sqlite3_standard_use_type_backend::pre_use(indicator const * ind)
 {
-    statement_.useData_.resize(1);
-    int const pos = position_ - 1;
+    sqlite3_recordset &useData = statement_.useData_;
+    useData.resize(1, std::max(useData.columns(),
+        static_cast<std::size_t>(position_)));
 
-    if (statement_.useData_[0].size() < static_cast<std::size_t>(position_))
-    {
-        statement_.useData_[0].resize(position_);
-    }
-
-    sqlite3_column &col = statement_.useData_[0][pos];
+    sqlite3_column &col = useData(0, position_ - 1);
 
     if (ind != NULL && *ind == i_null)
     {
@@ -138,13 +135,12 @@ void sqlite3_standard_use_type_backend::pre_use(indicator const * ind)
         case x_stdtm:
         {
             col.type_ = dt_date;
-            static const size_t bufSize = 20;
             std::tm &t = exchange_type_cast<x_stdtm>(data_);
 
-            col.buffer_.data_ = new char[bufSize];
+            col.buffer_.data_ = dateBuffer_;
             col.buffer_.size_
                 = snprintf(
-                    col.buffer_.data_, bufSize, "%d-%02d-%02d %02d:%02d:%02d",
+                    dateBuffer_, sizeof(dateBuffer_), "%d-%02d-%02d %02d:%02d:%02d",
                     t.tm_year + 1900, t.tm_mon + 1, t.tm_mday,
                     t.tm_hour, t.tm_min, t.tm_sec
                 );
@@ -200,14 +196,5 @@ void sqlite3_standard_use_type_backend::post_use(
 
 void sqlite3_standard_use_type_backend::clean_up()
 {
-    if (type_ != x_stdtm)
-        return;
-
-    sqlite3_column &col = statement_.useData_[0][position_ - 1];
-
-    if (col.isNull_ || !col.buffer_.data_)
-        return;
-
-    delete[] col.buffer_.data_;
-    col.buffer_.data_ = NULL;
+    // nothing to do here, dateBuffer_ is reused for all executions
 }
@@ -28,8 +28,10 @@ sqlite3_statement_backend::sqlite3_statement_backend(
     : session_(session)
     , stmt_(0)
     , dataCache_()
-    , useData_(0)
+    , useData_()
     , databaseReady_(false)
+    , checkColumns_(false)
+    , reprepareCount_(0)
     , boundByName_(false)
     , boundByPos_(false)
     , rowsAffectedBulk_(-1LL)
@@ -45,6 +47,8 @@ void sqlite3_statement_backend::clean_up()
 {
     rowsAffectedBulk_ = -1LL;
 
+    directStringIntos_.clear();
+
     if (stmt_)
     {
         sqlite3_finalize(stmt_);
@@ -58,11 +62,17 @@ void sqlite3_statement_backend::prepare(std::string const & query,
 {
     clean_up();
 
+    compile(query);
+}
+
+void sqlite3_statement_backend::compile(std::string const & query)
+{
+    sqlite3_stmt * stmt = 0;
     char const* tail = 0; // unused;
     int const res = sqlite3_prepare_v2(session_.conn_,
                               query.c_str(),
                               static_cast<int>(query.size()),
-                              &stmt_,
+                              &stmt,
                               &tail);
     if (res != SQLITE_OK)
     {
@@ -73,7 +83,51 @@ void sqlite3_statement_backend::prepare(std::string const & query,
            << zErrMsg;
         throw sqlite3_soci_error(ss.str(), res);
     }
+
+    if (stmt_)
+    {
+        sqlite3_finalize(stmt_);
+    }
+
+    stmt_ = stmt;
     databaseReady_ = true;
+
+    // the columns of the new statement haven't been described yet
+    columns_.clear();
+    reprepareCount_ = 0;
+}
+
+void sqlite3_recordset::resize(std::size_t rows, std::size_t columns)
+{
+    if (rows > stride_)
+    {
+        // The columns must be moved apart to make space for the new rows.
+        std::vector<sqlite3_column> cells(rows * columns);
+        for (std::size_t c = 0; c < columns_ && c < columns; ++c)
+        {
+            std::vector<sqlite3_column>::const_iterator const
+                first = cells_.begin() + c * stride_;
+            std::copy(first, first + rows_, cells.begin() + c * rows);
+        }
+
+        cells_.swap(cells);
+        stride_ = rows;
+    }
+    else if (stride_ * columns > cells_.size())
+    {
+        // Adding columns at the end preserves the existing ones.
+        cells_.resize(stride_ * columns);
+    }
+
+    rows_ = rows;
+    columns_ = columns;
+}
+
+void sqlite3_recordset::append_data(char const * buf, std::size_t size)
+{
+    // Always NUL-terminate the values, even the blobs, to allow parsing them.
+    data_.insert(data_.end(), buf, buf + size);
+    data_.push_back('\0');
 }
 
 // sqlite3_reset needs to be called before a prepared statment can
@@ -123,17 +177,36 @@ sqlite3_statement_backend::load_rowset(int totalRows)
     }
     else
     {
-        // make the vector big enough to hold the data we need
-        dataCache_.resize(totalRows);
-        for (sqlite3_recordset::iterator it = dataCache_.begin(),
-            end = dataCache_.end(); it != end; ++it)
+        // make the recordset big enough to hold the data we need
+        dataCache_.resize(totalRows, numCols);
+
+        // The string into elements can be filled directly, without storing
+        // the values in dataCache_, if they're big enough.
+        std::vector<std::vector<std::string> *> directStrings(numCols);
+        for (int c = 0; c < numCols; ++c)
         {
-            (*it).resize(numCols);
+            if (c < static_cast<int>(directStringIntos_.size()) &&
+                directStringIntos_[c] != NULL &&
+                directStringIntos_[c]->size() >=
+                    static_cast<std::size_t>(totalRows))
+            {
+                directStrings[c] = directStringIntos_[c];
+            }
         }
 
+        // All the other variable length values are copied into the
+        // recordset data buffer. As it can be reallocated while loading this
+        // batch, the pointers to it are only stored once all the rows have
+        // been read.
+        dataCache_.clear_data();
+
         for (i = 0; i < totalRows && databaseReady_; ++i)
         {
             int const res = sqlite3_step(stmt_);
+            if (checkColumns_ && (SQLITE_ROW == res || SQLITE_DONE == res))
+            {
+                check_columns();
+            }
 
             if (SQLITE_DONE == res)
             {
@@ -146,7 +219,7 @@ sqlite3_statement_backend::load_rowset(int totalRows)
                 for (int c = 0; c < numCols; ++c)
                 {
                     const sqlite3_column_info &coldef = columns_[c];
-                    sqlite3_column &col = dataCache_[i][c];
+                    sqlite3_column &col = dataCache_(i, c);
 
                     if (sqlite3_column_type(stmt_, c) == SQLITE_NULL)
                     {
@@ -161,10 +234,26 @@ sqlite3_statement_backend::load_rowset(int totalRows)
                     {
                         case dt_string:
                         case dt_date:
+                        case dt_blob:
+                        {
+                            char const * const buf = coldef.type_ == dt_blob
+                                ? static_cast<char const *>(
+                                    sqlite3_column_blob(stmt_, c))
+                                : reinterpret_cast<char const *>(
+                                    sqlite3_column_text(stmt_, c));
                             col.buffer_.size_ = sqlite3_column_bytes(stmt_, c);
-                            col.buffer_.data_ = new char[col.buffer_.size_+1];
-                            memcpy(col.buffer_.data_, sqlite3_column_text(stmt_, c), col.buffer_.size_+1);
+
+                            if (directStrings[c] != NULL)
+                            {
+                                (*directStrings[c])[i].assign(buf,
+                                    col.buffer_.size_);
+                                col.buffer_.constData_ = NULL;
+                                break;
+                            }
+
+                            dataCache_.append_data(buf, col.buffer_.size_);
                             break;
+                        }
 
                         case dt_double:
                             col.double_ = sqlite3_column_double(stmt_, c);
@@ -179,12 +268,6 @@ sqlite3_statement_backend::load_rowset(int totalRows)
                             col.int64_ = sqlite3_column_int64(stmt_, c);
                             break;
 
-                        case dt_blob:
-                            col.buffer_.size_ = sqlite3_column_bytes(stmt_, c);
-                            col.buffer_.data_ = (col.buffer_.size_ > 0 ? new char[col.buffer_.size_] : NULL);
-                            memcpy(col.buffer_.data_, sqlite3_column_blob(stmt_, c), col.buffer_.size_);
-                            break;
-
                         case dt_xml:
                             throw soci_error("XML data type is not supported");
                     }
@@ -199,9 +282,37 @@ sqlite3_statement_backend::load_rowset(int totalRows)
                 throw sqlite3_soci_error(ss.str(), res);
             }
         }
+
+        // Now that the data buffer won't be reallocated any more, make the
+        // values point into it, in the same order as they were added to it.
+        std::size_t offset = 0;
+        for (int row = 0; row < i; ++row)
+        {
+            for (int c = 0; c < numCols; ++c)
+            {
+                sqlite3_column &col = dataCache_(row, c);
+                if (col.isNull_ || directStrings[c] != NULL)
+                {
+                    continue;
+                }
+
+                switch (col.type_)
+                {
+                    case dt_string:
+                    case dt_date:
+                    case dt_blob:
+                        col.buffer_.constData_ = dataCache_.get_data(offset);
+                        offset += col.buffer_.size_ + 1;
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+        }
     }
-    // if we read less than requested then shrink the vector
-    dataCache_.resize(i);
+    // if we read less than requested then shrink the recordset
+    dataCache_.resize(i, numCols);
 
     return retVal;
 }
@@ -215,6 +326,10 @@ sqlite3_statement_backend::load_one()
 
     statement_backend::exec_fetch_result retVal = ef_success;
     int const res = sqlite3_step(stmt_);
+    if (checkColumns_ && (SQLITE_ROW == res || SQLITE_DONE == res))
+    {
+        check_columns();
+    }
 
     if (SQLITE_DONE == res)
     {
@@ -251,11 +366,11 @@ sqlite3_statement_backend::bind_and_execute(int number)
     {
         sqlite3_reset(stmt_);
 
-        int const totalPositions = static_cast<int>(useData_[0].size());
+        int const totalPositions = static_cast<int>(useData_.columns());
         for (int pos = 1; pos <= totalPositions; ++pos)
         {
             int bindRes = SQLITE_OK;
-            const sqlite3_column &col = useData_[row][pos-1];
+            const sqlite3_column &col = useData_(row, pos-1);
             if (col.isNull_)
             {
                 bindRes = sqlite3_bind_null(stmt_, pos);
@@ -325,6 +440,7 @@ sqlite3_statement_backend::execute(int number)
 
     sqlite3_reset(stmt_);
     databaseReady_ = true;
+    checkColumns_ = columns_.empty() == false;
 
     statement_backend::exec_fetch_result retVal = ef_no_data;
 
@@ -405,6 +521,43 @@ int sqlite3_statement_backend::prepare_for_describe()
     return sqlite3_column_count(stmt_);
 }
 
+void sqlite3_statement_backend::check_columns()
+{
+    checkColumns_ = false;
+
+#ifdef SQLITE_STMTSTATUS_REPREPARE
+    // SQLite transparently recompiles the statement when it's executed after
+    // a schema change, the columns can only have changed if it did.
+    int const reprepareCount
+        = sqlite3_stmt_status(stmt_, SQLITE_STMTSTATUS_REPREPARE, 0);
+    if (reprepareCount == reprepareCount_)
+    {
+        return;
+    }
+
+    reprepareCount_ = reprepareCount;
+#endif // SQLITE_STMTSTATUS_REPREPARE
+
+    int const numCols = sqlite3_column_count(stmt_);
+    bool changed = static_cast<std::size_t>(numCols) != columns_.size();
+    for (int c = 0; c < numCols && !changed; ++c)
+    {
+        char const* const declType = sqlite3_column_decltype(stmt_, c);
+        changed = columns_[c].name_ != sqlite3_column_name(stmt_, c) ||
+            columns_[c].declType_ != (declType ? declType : "");
+    }
+
+    if (changed)
+    {
+        // The values of the described columns can't be returned any more,
+        // they will be described anew when the statement is executed again.
+        columns_.clear();
+        clear_described_columns();
+
+        throw soci_error("Result columns changed since the statement was described.");
+    }
+}
+
 typedef std::map<std::string, data_type> sqlite3_data_type_map;
 static sqlite3_data_type_map get_data_type_map()
 {
@@ -488,6 +641,11 @@ void sqlite3_statement_backend::describe_column(int colNum, data_type & type,
         static char const* s_char = "char";
         declType = s_char;
     }
+    else
+    {
+        // remember it to check if the column changed, see check_columns()
+        coldef.declType_ = declType;
+    }
 
     std::string dt = declType;
 
@@ -538,6 +696,22 @@ void sqlite3_statement_backend::describe_column(int colNum, data_type & type,
     sqlite3_reset(stmt_);
 }
 
+void sqlite3_statement_backend::reset_for_reuse()
+{
+    // Don't keep the statement active, this would prevent the transaction
+    // from being committed or the database from being written to by others.
+    if (stmt_)
+    {
+        sqlite3_reset(stmt_);
+    }
+    databaseReady_ = true;
+
+    boundByName_ = false;
+    boundByPos_ = false;
+    directStringIntos_.clear();
+    rowsAffectedBulk_ = -1;
+}
+
 sqlite3_standard_into_type_backend *
 sqlite3_statement_backend::make_into_type_backend()
 {
@@ -40,7 +40,18 @@ void sqlite3_vector_into_type_backend::define_by_pos(
 
 void sqlite3_vector_into_type_backend::pre_fetch()
 {
-    // ...
+    if (type_ == details::x_stdstring)
+    {
+        // Let the statement fill our vector directly.
+        std::vector<std::vector<std::string> *> &
+            intos = statement_.directStringIntos_;
+        if (intos.size() < static_cast<std::size_t>(position_))
+        {
+            intos.resize(position_);
+        }
+
+        intos[position_ - 1] = static_cast<std::vector<std::string> *>(data_);
+    }
 }
 
 namespace // anonymous
@@ -98,10 +109,17 @@ void sqlite3_vector_into_type_backend::post_fetch(bool gotData, indicator * ind)
         return;
     }
 
+    // Check if the string values were already stored in our vector.
+    std::vector<std::vector<std::string> *> const &
+        directIntos = statement_.directStringIntos_;
+    bool const direct = type_ == x_stdstring &&
+        static_cast<std::size_t>(position_) <= directIntos.size() &&
+        directIntos[position_ - 1] == data_;
+
     int const endRow = static_cast<int>(statement_.dataCache_.size());
     for (int i = 0; i < endRow; ++i)
     {
-        sqlite3_column &col = statement_.dataCache_[i][position_-1];
+        sqlite3_column &col = statement_.dataCache_(i, position_-1);
 
         if (col.isNull_)
         {
@@ -166,7 +184,10 @@ void sqlite3_vector_into_type_backend::post_fetch(bool gotData, indicator * ind)
                     case dt_date:
                     case dt_string:
                     case dt_blob:
-                        set_in_vector(data_, i, std::string(col.buffer_.constData_, col.buffer_.size_));
+                        if (!direct)
+                        {
+                            set_in_vector(data_, i, std::string(col.buffer_.constData_, col.buffer_.size_));
+                        }
                         break;
 
                     case dt_double:
@@ -247,26 +268,6 @@ void sqlite3_vector_into_type_backend::post_fetch(bool gotData, indicator * ind)
             default:
                 throw soci_error("Into element used with non-supported type.");
         }
-
-        // cleanup data
-        switch (col.type_)
-        {
-            case dt_date:
-            case dt_string:
-            case dt_blob:
-                delete[] col.buffer_.data_;
-                col.buffer_.data_ = NULL;
-                break;
-
-            case dt_double:
-            case dt_integer:
-            case dt_long_long:
-            case dt_unsigned_long_long:
-                break;
-
-            case dt_xml:
-                throw soci_error("XML data type is not supported");
-        }
     }
 }
 
@@ -349,6 +350,12 @@ std::size_t sqlite3_vector_into_type_backend::size()
 
 void sqlite3_vector_into_type_backend::clean_up()
 {
+    std::vector<std::vector<std::string> *> &
+        intos = statement_.directStringIntos_;
+    if (static_cast<std::size_t>(position_) <= intos.size() && position_ > 0)
+    {
+        intos[position_ - 1] = NULL;
+    }
 }
 
 } // namespace soci
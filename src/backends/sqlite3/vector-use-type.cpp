@@ -12,6 +12,7 @@
 #include "soci-dtocstr.h"
 #include "common.h"
 // std
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -70,19 +71,22 @@ void sqlite3_vector_use_type_backend::pre_use(indicator const * ind)
 {
     std::size_t const vsize = size();
 
-    // make sure that useData can hold enough rows
-    if (statement_.useData_.size() != vsize)
-        statement_.useData_.resize(vsize);
+    // make sure that useData can hold enough rows and columns
+    sqlite3_recordset &useData = statement_.useData_;
+    useData.resize(vsize, std::max(useData.columns(),
+        static_cast<std::size_t>(position_)));
 
     int const pos = position_ - 1;
 
-    for (size_t i = 0; i != vsize; ++i)
+    static const size_t bufSize = 20;
+    if (type_ == x_stdtm)
     {
-        // make sure that each row can accomodate the number of columns
-        if (statement_.useData_[i].size() < static_cast<std::size_t>(position_))
-            statement_.useData_[i].resize(position_);
+        dateBuffers_.resize(vsize * bufSize);
+    }
 
-        sqlite3_column &col = statement_.useData_[i][pos];
+    for (size_t i = 0; i != vsize; ++i)
+    {
+        sqlite3_column &col = useData(i, pos);
 
         // the data in vector can be either i_ok or i_null
         if (ind != NULL && ind[i] == i_null)
@@ -139,10 +143,9 @@ void sqlite3_vector_use_type_backend::pre_use(indicator const * ind)
             case x_stdtm:
             {
                 std::tm &tm = (*static_cast<std::vector<exchange_type_traits<x_stdtm>::value_type> *>(data_))[i];
-                static const size_t bufSize = 20;
 
                 col.type_ = dt_date;
-                col.buffer_.data_ = new char[bufSize];
+                col.buffer_.data_ = &dateBuffers_[i * bufSize];
                 col.buffer_.size_
                     = snprintf(col.buffer_.data_, bufSize, "%d-%02d-%02d %02d:%02d:%02d",
                         tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
@@ -197,19 +200,5 @@ std::size_t sqlite3_vector_use_type_backend::size()
 
 void sqlite3_vector_use_type_backend::clean_up()
 {
-    if (type_ != x_stdtm)
-        return;
-
-    int const pos = position_ - 1;
-
-    for (sqlite3_recordset::iterator iter = statement_.useData_.begin(), last = statement_.useData_.end();
-        iter != last; ++iter)
-    {
-        sqlite3_column &col = (*iter)[pos];
-
-        if (col.isNull_)
-            continue;
-
-        delete[] col.buffer_.data_;
-    }
+    // nothing to do here, dateBuffers_ are reused for all executions
 }
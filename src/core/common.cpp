@@ -9,10 +9,15 @@
 #define SOCI_SOURCE
 #include "soci/error.h"
 #include "soci-mktime.h"
+#include "soci-timer.h"
 #include <climits>
 #include <cstdlib>
 #include <ctime>
 
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
 namespace // anonymous
 {
 
@@ -91,3 +96,21 @@ void soci::details::parse_std_tm(char const * buf, std::tm & t)
 
     mktime_from_ymdhms(t, year, month, day, hour, minute, second);
 }
+
+long long soci::details::get_monotonic_microseconds()
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    return static_cast<long long>(
+        counter.QuadPart / frequency.QuadPart * 1000000 +
+        counter.QuadPart % frequency.QuadPart * 1000000 / frequency.QuadPart);
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return static_cast<long long>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
@@ -10,6 +10,9 @@
 #include "soci/soci-backend.h"
 #include "soci/backend-loader.h"
 
+#include <cerrno>
+#include <cstdlib>
+
 using namespace soci;
 
 namespace // anonymous
@@ -60,3 +63,33 @@ connection_parameters::connection_parameters(std::string const & fullConnectStri
     factory_ = &dynamic_backends::get(backendName);
     connectString_ = connectString;
 }
+
+bool connection_parameters::get_size_option(const char * name,
+    std::size_t & value, std::size_t maxValue) const
+{
+    std::string str;
+    if (!get_option(name, str))
+        return false;
+
+    // strtoul() would accept leading spaces and a sign, so check for the
+    // digits only first
+    unsigned long size = 0;
+    bool ok = !str.empty() &&
+        str.find_first_not_of("0123456789") == std::string::npos;
+    if (ok)
+    {
+        errno = 0;
+        size = std::strtoul(str.c_str(), NULL, 10);
+        ok = errno != ERANGE && size <= maxValue;
+    }
+
+    if (!ok)
+    {
+        throw soci_error("Invalid value \"" + str + "\" of option \"" +
+                         name + "\".");
+    }
+
+    value = static_cast<std::size_t>(size);
+
+    return true;
+}
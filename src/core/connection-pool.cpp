@@ -7,139 +7,924 @@
 
 #define SOCI_SOURCE
 #include "soci/connection-pool.h"
+#include "soci/connection-parameters.h"
 #include "soci/error.h"
 #include "soci/session.h"
+#include <algorithm>
+#include <ctime>
+#include <deque>
+#include <exception>
+#include <string>
 #include <vector>
-#include <utility>
 
 #ifndef _WIN32
-// POSIX implementation
 
 #include <pthread.h>
 #include <sys/time.h>
 #include <errno.h>
 
-using namespace soci;
+#else
+
+#include <windows.h>
+
+#endif // _WIN32
+
+using namespace soci;
+
+namespace // anonymous
+{
+
+// Minimal set of atomic operations used by the pool, all of them are full
+// memory barriers.
+#if defined(_WIN32)
+
+typedef LONG atomic_long;
+typedef LONGLONG atomic_long_long;
+
+inline bool compare_and_swap(atomic_long volatile * p,
+    atomic_long oldValue, atomic_long newValue)
+{
+    return InterlockedCompareExchange(p, newValue, oldValue) == oldValue;
+}
+
+inline bool compare_and_swap(atomic_long_long volatile * p,
+    atomic_long_long oldValue, atomic_long_long newValue)
+{
+    return InterlockedCompareExchange64(p, newValue, oldValue) == oldValue;
+}
+
+inline atomic_long atomic_add(atomic_long volatile * p, atomic_long delta)
+{
+    return InterlockedExchangeAdd(p, delta) + delta;
+}
+
+inline atomic_long atomic_load(atomic_long volatile * p)
+{
+    return InterlockedCompareExchange(p, 0, 0);
+}
+
+inline atomic_long_long atomic_load(atomic_long_long volatile * p)
+{
+    return InterlockedCompareExchange64(p, 0, 0);
+}
+
+inline void atomic_store(atomic_long volatile * p, atomic_long value)
+{
+    InterlockedExchange(p, value);
+}
+
+#elif defined(__GNUC__)
+
+// GCC and compatible compilers, e.g. clang or Intel C++.
+
+typedef long atomic_long;
+typedef long long atomic_long_long;
+
+inline bool compare_and_swap(atomic_long volatile * p,
+    atomic_long oldValue, atomic_long newValue)
+{
+    return __sync_bool_compare_and_swap(p, oldValue, newValue);
+}
+
+inline bool compare_and_swap(atomic_long_long volatile * p,
+    atomic_long_long oldValue, atomic_long_long newValue)
+{
+    return __sync_bool_compare_and_swap(p, oldValue, newValue);
+}
+
+inline atomic_long atomic_add(atomic_long volatile * p, atomic_long delta)
+{
+    return __sync_add_and_fetch(p, delta);
+}
+
+inline atomic_long atomic_load(atomic_long volatile * p)
+{
+    return __sync_add_and_fetch(p, 0);
+}
+
+inline atomic_long_long atomic_load(atomic_long_long volatile * p)
+{
+    // also avoids reading a 64-bit value non-atomically on 32-bit platforms
+    return __sync_add_and_fetch(p, 0);
+}
+
+inline void atomic_store(atomic_long volatile * p, atomic_long value)
+{
+    // this builtin is only an acquire barrier, so add a full one before it
+    __sync_synchronize();
+    __sync_lock_test_and_set(p, value);
+}
+
+#else
+
+// Other POSIX compilers: without any atomic builtins, serialize all the
+// operations using a single global mutex. This is much slower, but still
+// correct.
+
+typedef long atomic_long;
+typedef long long atomic_long_long;
+
+pthread_mutex_t atomicMutex = PTHREAD_MUTEX_INITIALIZER;
+
+class atomic_guard
+{
+public:
+    atomic_guard() { pthread_mutex_lock(&atomicMutex); }
+    ~atomic_guard() { pthread_mutex_unlock(&atomicMutex); }
+
+private:
+    SOCI_NOT_COPYABLE(atomic_guard)
+};
+
+template <typename T>
+inline bool locked_compare_and_swap(T volatile * p, T oldValue, T newValue)
+{
+    atomic_guard guard;
+    if (*p != oldValue)
+    {
+        return false;
+    }
+
+    *p = newValue;
+    return true;
+}
+
+inline bool compare_and_swap(atomic_long volatile * p,
+    atomic_long oldValue, atomic_long newValue)
+{
+    return locked_compare_and_swap(p, oldValue, newValue);
+}
+
+inline bool compare_and_swap(atomic_long_long volatile * p,
+    atomic_long_long oldValue, atomic_long_long newValue)
+{
+    return locked_compare_and_swap(p, oldValue, newValue);
+}
+
+inline atomic_long atomic_add(atomic_long volatile * p, atomic_long delta)
+{
+    atomic_guard guard;
+    return *p += delta;
+}
+
+template <typename T>
+inline T atomic_load(T volatile * p)
+{
+    atomic_guard guard;
+    return *p;
+}
+
+inline void atomic_store(atomic_long volatile * p, atomic_long value)
+{
+    atomic_guard guard;
+    *p = value;
+}
+
+#endif // _WIN32/__GNUC__
+
+// Lock-free LIFO list of the positions of the free pool entries.
+//
+// The lower 32 bits of its head contain the position of the top entry biased
+// by 1, so that 0 means that the list is empty, and the upper ones contain a
+// counter incremented by every change. The counter ensures that popping an
+// entry using a stale value of the next position (which can happen if another
+// thread popped and pushed back the same entry in the meanwhile) fails.
+//
+// Reusing the most recently returned entry first also keeps using the same
+// few connections when the pool is not fully loaded.
+class free_list
+{
+public:
+    explicit free_list(std::size_t size)
+        : next_(size), head_(0)
+    {
+    }
+
+    void push(std::size_t pos)
+    {
+        for (;;)
+        {
+            atomic_long_long const head = atomic_load(&head_);
+
+            set_next(pos, top_of(head));
+            if (compare_and_swap(&head_, head,
+                    make_head(head, static_cast<unsigned>(pos + 1))))
+            {
+                return;
+            }
+        }
+    }
+
+    bool pop(std::size_t & pos)
+    {
+        for (;;)
+        {
+            atomic_long_long const head = atomic_load(&head_);
+
+            unsigned const top = top_of(head);
+            if (top == 0)
+            {
+                return false;
+            }
+
+            // the entry may be concurrently popped and pushed back by another
+            // thread, changing its next position, but then the counter in the
+            // head changes too and the value read here is not used
+            if (compare_and_swap(&head_, head, make_head(head, get_next(top - 1))))
+            {
+                pos = top - 1;
+                return true;
+            }
+        }
+    }
+
+    // Take all the entries from the list at once, most recent first.
+    void pop_all(std::vector<std::size_t> & positions)
+    {
+        atomic_long_long head;
+        do
+        {
+            head = atomic_load(&head_);
+        }
+        while (compare_and_swap(&head_, head, make_head(head, 0)) == false);
+
+        // nobody else can access these entries now
+        for (unsigned top = top_of(head); top != 0; top = get_next(top - 1))
+        {
+            positions.push_back(top - 1);
+        }
+    }
+
+private:
+    static unsigned top_of(atomic_long_long head)
+    {
+        return static_cast<unsigned>(
+            static_cast<unsigned long long>(head) & 0xffffffffu);
+    }
+
+    static atomic_long_long make_head(atomic_long_long head, unsigned top)
+    {
+        unsigned long long const counter =
+            (static_cast<unsigned long long>(head) >> 32) + 1;
+
+        return static_cast<atomic_long_long>((counter << 32) | top);
+    }
+
+    // The links are accessed atomically as they may be read by one thread
+    // while another one is pushing the same entry.
+    unsigned get_next(std::size_t pos)
+    {
+        return static_cast<unsigned>(atomic_load(&next_[pos]));
+    }
+
+    void set_next(std::size_t pos, unsigned next)
+    {
+        atomic_store(&next_[pos], static_cast<atomic_long>(next));
+    }
+
+    // position of the next entry biased by 1 for each entry in the list
+    std::vector<atomic_long> next_;
+    atomic_long_long volatile head_;
+};
+
+// Session opened in a separate thread when warming up an elastic pool.
+struct session_opener
+{
+    session * session_;
+    connection_parameters const * parameters_;
+
+    bool failed_;
+    std::string error_;
+};
+
+void run_session_opener(session_opener & opener)
+{
+    try
+    {
+        opener.session_->open(*opener.parameters_);
+    }
+    catch (std::exception const & e)
+    {
+        opener.failed_ = true;
+        opener.error_ = e.what();
+    }
+    catch (...)
+    {
+        opener.failed_ = true;
+        opener.error_ = "unknown error";
+    }
+}
+
+// Run all the openers concurrently, defined below for each platform.
+void run_session_openers(std::vector<session_opener> & openers);
+
+// Part of the pool implementation common to all platforms.
+//
+// The entries of an elastic pool which are not connected are kept in a
+// separate list, so that the entries in the list of the free ones can be
+// used immediately and the other ones need to be opened first.
+struct connection_pool_base
+{
+    connection_pool_base(std::size_t size, std::size_t openSize)
+        : sessions_(size), leased_(size, 0), lastUsed_(size, 0),
+          free_(size), closed_(size),
+          elastic_(false), minSize_(0), openCount_(0),
+          created_(std::time(NULL)), idleTimeout_(0), sweeping_(0),
+          stopReaper_(0), validateOnLease_(false)
+    {
+        for (std::size_t i = size; i != 0; --i)
+        {
+            sessions_[i - 1] = new session();
+
+            if (i <= openSize)
+            {
+                free_.push(i - 1);
+            }
+            else
+            {
+                closed_.push(i - 1);
+            }
+        }
+    }
+
+    virtual ~connection_pool_base()
+    {
+        for (std::size_t i = 0; i != sessions_.size(); ++i)
+        {
+            delete sessions_[i];
+        }
+    }
+
+    // Body of the thread closing the idle sessions, defined for each platform.
+    virtual void run_reaper() = 0;
+
+    // Interval between the checks for the idle sessions in milliseconds: twice
+    // per timeout period, but at least once per hour.
+    static int reaper_interval(int timeout)
+    {
+        return ((timeout < 7200 ? timeout : 7200) + 1) / 2 * 1000;
+    }
+
+    // Open the first minSize sessions of an elastic pool concurrently.
+    void warm_up(connection_parameters const & parameters, std::size_t minSize)
+    {
+        elastic_ = true;
+        parameters_ = parameters;
+        minSize_ = minSize;
+
+        std::vector<session_opener> openers(minSize);
+        for (std::size_t i = 0; i != minSize; ++i)
+        {
+            session_opener & opener = openers[i];
+            opener.session_ = sessions_[i];
+            opener.parameters_ = &parameters_;
+            opener.failed_ = false;
+        }
+
+        run_session_openers(openers);
+
+        for (std::size_t i = 0; i != minSize; ++i)
+        {
+            if (openers[i].failed_)
+            {
+                throw soci_error("Failed to open pool session: " + openers[i].error_);
+            }
+        }
+
+        openCount_ = static_cast<atomic_long>(minSize);
+    }
+
+    // Take a free entry, preferring the already connected ones. If the entry
+    // returned is not connected yet, mustOpen is set to true.
+    //
+    // While the idle sessions are being checked, the connected free entries
+    // are temporarily taken out of the list, so don't open a new session
+    // then but return false to wait until they're put back.
+    bool take_free(std::size_t & pos, bool & mustOpen)
+    {
+        mustOpen = false;
+        if (free_.pop(pos) == false)
+        {
+            if (atomic_load(&sweeping_) != 0 || closed_.pop(pos) == false)
+            {
+                return false;
+            }
+
+            mustOpen = true;
+        }
+
+        compare_and_swap(&leased_[pos], 0, 1);
+        return true;
+    }
+
+    // Open or validate the session of the entry just taken from the pool,
+    // making the entry free again if this fails.
+    void prepare_leased(std::size_t pos, bool mustOpen)
+    {
+        session & s = *sessions_[pos];
+        try
+        {
+            if (mustOpen)
+            {
+                s.open(parameters_);
+                atomic_add(&openCount_, 1);
+            }
+            else if (validateOnLease_ && s.is_connected() == false)
+            {
+                s.reconnect();
+            }
+        }
+        catch (...)
+        {
+            if (elastic_ == false)
+            {
+                put_free(pos);
+            }
+            else
+            {
+                if (mustOpen == false)
+                {
+                    s.close();
+                    atomic_add(&openCount_, -1);
+                }
+
+                compare_and_swap(&leased_[pos], 1, 0);
+                closed_.push(pos);
+            }
+
+            throw;
+        }
+    }
+
+    void put_free(std::size_t pos)
+    {
+        if (pos >= sessions_.size())
+        {
+            throw soci_error("Invalid pool position");
+        }
+
+        if (compare_and_swap(&leased_[pos], 1, 0) == false)
+        {
+            throw soci_error("Cannot release pool entry (already free)");
+        }
+
+        lastUsed_[pos] = seconds_since_creation();
+
+        free_.push(pos);
+    }
+
+    long seconds_since_creation() const
+    {
+        return static_cast<long>(std::difftime(std::time(NULL), created_));
+    }
+
+    // Take the free sessions of an elastic pool which were not used for at
+    // least the given number of seconds out of the pool, unless this is
+    // already being done by another thread.
+    //
+    // The entries of these sessions are returned in the provided vector and
+    // must be passed to close_evicted() later. The other free entries are
+    // unavailable during the check, so if it was done, this function returns
+    // true and the threads which may have been waiting for them must be woken
+    // up.
+    bool evict_idle(int seconds, std::vector<std::size_t> & evicted)
+    {
+        if (elastic_ == false || compare_and_swap(&sweeping_, 0, 1) == false)
+        {
+            return false;
+        }
+
+        long const now = seconds_since_creation();
+
+        std::vector<std::size_t> positions;
+        free_.pop_all(positions);
+
+        // put back the sessions to keep, preserving their order, and let the
+        // caller close the other ones, as this may take some time
+        std::size_t const openCount =
+            static_cast<std::size_t>(atomic_load(&openCount_));
+
+        for (std::size_t i = positions.size(); i != 0; --i)
+        {
+            std::size_t const pos = positions[i - 1];
+
+            // the least recently used sessions come first
+            if (now - lastUsed_[pos] >= seconds &&
+                openCount - evicted.size() > minSize_)
+            {
+                evicted.push_back(pos);
+            }
+            else
+            {
+                free_.push(pos);
+            }
+        }
+
+        atomic_store(&sweeping_, 0);
+
+        return true;
+    }
+
+    void close_evicted(std::vector<std::size_t> const & evicted)
+    {
+        for (std::size_t i = 0; i != evicted.size(); ++i)
+        {
+            std::size_t const pos = evicted[i];
+
+            // there is nothing to do if closing the session fails, and the
+            // entry can be opened again later in any case
+            try
+            {
+                sessions_[pos]->close();
+            }
+            catch (...)
+            {
+            }
+
+            atomic_add(&openCount_, -1);
+
+            closed_.push(pos);
+        }
+    }
+
+    std::vector<session *> sessions_;
+
+    // non-zero for the entries currently leased
+    std::vector<atomic_long> leased_;
+
+    // when the entry was given back to the pool for the last time, in
+    // seconds since the pool creation
+    std::vector<long> lastUsed_;
+
+    // the free entries with and without open sessions
+    free_list free_;
+    free_list closed_;
+
+    // true if the pool opens its sessions itself
+    bool elastic_;
+    connection_parameters parameters_;
+    std::size_t minSize_;
+
+    // number of open sessions in an elastic pool
+    atomic_long volatile openCount_;
+
+    // the idle sessions times are relative to it, to avoid storing time_t
+    // values in atomic_long, which is only 32 bits under Windows
+    std::time_t const created_;
+
+    // in seconds, 0 if the idle sessions are never closed
+    atomic_long volatile idleTimeout_;
+
+    // non-zero while the idle sessions are being checked
+    atomic_long volatile sweeping_;
+
+    // non-zero to ask the thread closing the idle sessions to exit
+    atomic_long volatile stopReaper_;
+
+    bool validateOnLease_;
+};
+
+} // namespace anonymous
+
+#ifndef _WIN32
+// POSIX implementation
+
+namespace // anonymous
+{
+
+extern "C" void * session_opener_thread(void * arg)
+{
+    run_session_opener(*static_cast<session_opener *>(arg));
+    return NULL;
+}
+
+void run_session_openers(std::vector<session_opener> & openers)
+{
+    std::vector<pthread_t> threads(openers.size());
+    std::vector<bool> started(openers.size(), false);
+    for (std::size_t i = 0; i != openers.size(); ++i)
+    {
+        started[i] = pthread_create(&threads[i], NULL,
+            session_opener_thread, &openers[i]) == 0;
+        if (started[i] == false)
+        {
+            // just do it in this thread then
+            run_session_opener(openers[i]);
+        }
+    }
+
+    for (std::size_t i = 0; i != openers.size(); ++i)
+    {
+        if (started[i])
+        {
+            pthread_join(threads[i], NULL);
+        }
+    }
+}
+
+// Compute the absolute time corresponding to the timeout in milliseconds.
+void make_deadline(struct timespec & tm, int timeout)
+{
+    struct timeval tmv;
+    gettimeofday(&tmv, NULL);
+
+    tm.tv_sec = tmv.tv_sec + timeout / 1000;
+    tm.tv_nsec = tmv.tv_usec * 1000 + (timeout % 1000) * 1000 * 1000;
+
+    if (tm.tv_nsec >= 1000 * 1000 * 1000)
+    {
+        ++tm.tv_sec;
+        tm.tv_nsec -= 1000 * 1000 * 1000;
+    }
+}
+
+extern "C" void * idle_reaper_thread(void * arg)
+{
+    static_cast<connection_pool_base *>(arg)->run_reaper();
+    return NULL;
+}
+
+// Thread waiting for an entry to be given back to the pool.
+struct waiter
+{
+    pthread_cond_t cond_;
+
+    // true while the waiter is in the queue, i.e. wasn't woken up yet
+    bool queued_;
+};
+
+} // namespace anonymous
+
+struct connection_pool::connection_pool_impl : connection_pool_base
+{
+    connection_pool_impl(std::size_t size, std::size_t openSize)
+        : connection_pool_base(size, openSize), waiting_(0),
+          reaperStarted_(false)
+    {
+    }
+
+    bool wait_for_free(std::size_t & pos, bool & mustOpen, int timeout);
+
+    std::size_t close_idle(int seconds)
+    {
+        std::vector<std::size_t> evicted;
+        if (evict_idle(seconds, evicted) == false)
+        {
+            return 0;
+        }
+
+        // the threads which didn't find a free entry while checking the idle
+        // sessions may still be able to take it
+        notify(true);
+
+        close_evicted(evicted);
+        for (std::size_t i = 0; i != evicted.size(); ++i)
+        {
+            notify();
+        }
+
+        return evicted.size();
+    }
+
+    // Start the thread closing the idle sessions if it's not running yet or
+    // let it know that the idle timeout has changed otherwise.
+    void start_reaper();
+    void run_reaper() SOCI_OVERRIDE;
+    void stop_reaper();
+
+    // Wake up only the thread waiting for the longest time, if any, or all
+    // of them if the entries they waited for may have become available. Notice
+    // that this must be called after making the entries available, see
+    // wait_for_free().
+    void notify(bool all = false)
+    {
+        if (atomic_load(&waiting_) == 0)
+        {
+            return;
+        }
+
+        int cc = pthread_mutex_lock(&mtx_);
+        if (cc != 0)
+        {
+            throw soci_error("Synchronization error");
+        }
 
-struct connection_pool::connection_pool_impl
-{
-    bool find_free(std::size_t & pos)
-    {
-        for (std::size_t i = 0; i != sessions_.size(); ++i)
+        while (waiters_.empty() == false)
         {
-            if (sessions_[i].first)
+            waiter * const w = waiters_.front();
+            waiters_.pop_front();
+
+            w->queued_ = false;
+            pthread_cond_signal(&(w->cond_));
+
+            if (all == false)
             {
-                pos = i;
-                return true;
+                break;
             }
         }
 
-        return false;
+        pthread_mutex_unlock(&mtx_);
     }
 
-    // by convention, first == true means the entry is free (not used)
-    std::vector<std::pair<bool, session *> > sessions_;
+    // number of threads which didn't find a free entry without locking the
+    // mutex, it is only modified when the mutex is locked
+    atomic_long volatile waiting_;
+
+    // threads waiting for an entry, woken up one by one in FIFO order
+    std::deque<waiter *> waiters_;
+
     pthread_mutex_t mtx_;
-    pthread_cond_t cond_;
+
+    // the thread closing the idle sessions of an elastic pool, if any, and
+    // the condition used to wake it up, both protected by the mutex
+    pthread_t reaper_;
+    pthread_cond_t reaperCond_;
+    bool reaperStarted_;
 };
 
-connection_pool::connection_pool(std::size_t size)
+void connection_pool::connection_pool_impl::start_reaper()
 {
-    if (size == 0)
+    int cc = pthread_mutex_lock(&mtx_);
+    if (cc != 0)
     {
-        throw soci_error("Invalid pool size");
+        throw soci_error("Synchronization error");
     }
 
-    pimpl_ = new connection_pool_impl();
-    pimpl_->sessions_.resize(size);
-    for (std::size_t i = 0; i != size; ++i)
+    if (reaperStarted_)
+    {
+        pthread_cond_signal(&reaperCond_);
+    }
+    else if (atomic_load(&idleTimeout_) == 0)
     {
-        pimpl_->sessions_[i] = std::make_pair(true, new session());
+        // no need to start it yet
+        pthread_mutex_unlock(&mtx_);
+        return;
+    }
+    else if (pthread_cond_init(&reaperCond_, NULL) == 0)
+    {
+        reaperStarted_ = pthread_create(&reaper_, NULL, idle_reaper_thread,
+            static_cast<connection_pool_base *>(this)) == 0;
+        if (reaperStarted_ == false)
+        {
+            pthread_cond_destroy(&reaperCond_);
+        }
     }
 
-    int cc = pthread_mutex_init(&(pimpl_->mtx_), NULL);
-    if (cc != 0)
+    bool const started = reaperStarted_;
+
+    pthread_mutex_unlock(&mtx_);
+
+    if (started == false)
     {
-        throw soci_error("Synchronization error");
+        throw soci_error("Failed to start the thread closing idle sessions");
     }
+}
 
-    cc = pthread_cond_init(&(pimpl_->cond_), NULL);
-    if (cc != 0)
+void connection_pool::connection_pool_impl::run_reaper()
+{
+    pthread_mutex_lock(&mtx_);
+
+    while (atomic_load(&stopReaper_) == 0)
     {
-        throw soci_error("Synchronization error");
+        int const timeout = static_cast<int>(atomic_load(&idleTimeout_));
+        if (timeout == 0)
+        {
+            pthread_cond_wait(&reaperCond_, &mtx_);
+            continue;
+        }
+
+        struct timespec tm;
+        make_deadline(tm, reaper_interval(timeout));
+        if (pthread_cond_timedwait(&reaperCond_, &mtx_, &tm) != ETIMEDOUT)
+        {
+            // woken up because the timeout changed or to exit
+            continue;
+        }
+
+        // closing the sessions may take time, don't block the other threads
+        pthread_mutex_unlock(&mtx_);
+
+        try
+        {
+            close_idle(timeout);
+        }
+        catch (...)
+        {
+            // there is nobody to report the error to, just try again later
+        }
+
+        pthread_mutex_lock(&mtx_);
     }
+
+    pthread_mutex_unlock(&mtx_);
 }
 
-connection_pool::~connection_pool()
+void connection_pool::connection_pool_impl::stop_reaper()
 {
-    for (std::size_t i = 0; i != pimpl_->sessions_.size(); ++i)
+    pthread_mutex_lock(&mtx_);
+
+    bool const started = reaperStarted_;
+    if (started)
     {
-        delete pimpl_->sessions_[i].second;
+        atomic_store(&stopReaper_, 1);
+        pthread_cond_signal(&reaperCond_);
     }
 
-    pthread_mutex_destroy(&(pimpl_->mtx_));
-    pthread_cond_destroy(&(pimpl_->cond_));
+    pthread_mutex_unlock(&mtx_);
 
-    delete pimpl_;
+    if (started)
+    {
+        pthread_join(reaper_, NULL);
+        pthread_cond_destroy(&reaperCond_);
+    }
 }
 
-bool connection_pool::try_lease(std::size_t & pos, int timeout)
+bool connection_pool::connection_pool_impl::wait_for_free(
+    std::size_t & pos, bool & mustOpen, int timeout)
 {
     struct timespec tm;
     if (timeout >= 0)
     {
         // timeout is relative in milliseconds
-
-        struct timeval tmv;
-        gettimeofday(&tmv, NULL);
-
-        tm.tv_sec = tmv.tv_sec + timeout / 1000;
-        tm.tv_nsec = tmv.tv_usec * 1000 + (timeout % 1000) * 1000 * 1000;
-
-        if (tm.tv_nsec >= 1000 * 1000 * 1000)
-        {
-            ++tm.tv_sec;
-            tm.tv_nsec -= 1000 * 1000 * 1000;
-        }
+        make_deadline(tm, timeout);
     }
 
-    int cc = pthread_mutex_lock(&(pimpl_->mtx_));
+    int cc = pthread_mutex_lock(&mtx_);
     if (cc != 0)
     {
         throw soci_error("Synchronization error");
     }
 
-    while (pimpl_->find_free(pos) == false)
+    // Let notify() know that it needs to wake up a waiting thread before
+    // checking for the free entries once again: either we find the entry
+    // which was made available or it sees that we're waiting for it.
+    atomic_add(&waiting_, 1);
+
+    bool found = false;
+
+    waiter w;
+    w.queued_ = false;
+
+    cc = pthread_cond_init(&(w.cond_), NULL);
+    if (cc == 0)
     {
-        if (timeout < 0)
-        {
-            // no timeout, allow unlimited blocking
-            cc = pthread_cond_wait(&(pimpl_->cond_), &(pimpl_->mtx_));
-        }
-        else
+        for (bool first = true; ; first = false)
         {
-            // wait with timeout
-            cc = pthread_cond_timedwait(
-                &(pimpl_->cond_), &(pimpl_->mtx_), &tm);
+            if (take_free(pos, mustOpen))
+            {
+                found = true;
+                break;
+            }
+
+            if (cc != 0)
+            {
+                break;
+            }
+
+            if (w.queued_ == false)
+            {
+                // Wait at the end of the queue initially, but keep our place
+                // at its front if another thread took the entry before us.
+                if (first)
+                {
+                    waiters_.push_back(&w);
+                }
+                else
+                {
+                    waiters_.push_front(&w);
+                }
+
+                w.queued_ = true;
+            }
+
+            if (timeout < 0)
+            {
+                // no timeout, allow unlimited blocking
+                cc = pthread_cond_wait(&(w.cond_), &mtx_);
+            }
+            else
+            {
+                // wait with timeout
+                cc = pthread_cond_timedwait(&(w.cond_), &mtx_, &tm);
+            }
         }
 
-        if (cc == ETIMEDOUT)
+        if (w.queued_)
         {
-            break;
+            waiters_.erase(std::find(waiters_.begin(), waiters_.end(), &w));
         }
-    }
 
-    if (cc == 0)
-    {
-        pimpl_->sessions_[pos].first = false;
+        pthread_cond_destroy(&(w.cond_));
     }
 
-    pthread_mutex_unlock(&(pimpl_->mtx_));
+    atomic_add(&waiting_, -1);
 
-    if (cc != 0)
+    pthread_mutex_unlock(&mtx_);
+
+    if (found == false)
     {
         // we can only fail if timeout expired
-        if (timeout < 0)
+        if (timeout < 0 || cc != ETIMEDOUT)
         {
             throw soci_error("Getting connection from the pool unexpectedly failed");
         }
@@ -150,99 +935,308 @@ bool connection_pool::try_lease(std::size_t & pos, int timeout)
     return true;
 }
 
-void connection_pool::give_back(std::size_t pos)
+connection_pool::connection_pool(std::size_t size)
 {
-    if (pos >= pimpl_->sessions_.size())
+    if (size == 0 || size > 0xfffffffeu)
     {
-        throw soci_error("Invalid pool position");
+        throw soci_error("Invalid pool size");
+    }
+
+    pimpl_ = new connection_pool_impl(size, size);
+
+    int cc = pthread_mutex_init(&(pimpl_->mtx_), NULL);
+    if (cc != 0)
+    {
+        delete pimpl_;
+        throw soci_error("Synchronization error");
+    }
+}
+
+connection_pool::connection_pool(connection_parameters const & parameters,
+    std::size_t minSize, std::size_t maxSize)
+{
+    if (maxSize == 0 || maxSize > 0xfffffffeu || minSize > maxSize)
+    {
+        throw soci_error("Invalid pool size");
     }
 
-    int cc = pthread_mutex_lock(&(pimpl_->mtx_));
+    pimpl_ = new connection_pool_impl(maxSize, minSize);
+
+    int cc = pthread_mutex_init(&(pimpl_->mtx_), NULL);
     if (cc != 0)
     {
+        delete pimpl_;
         throw soci_error("Synchronization error");
     }
 
-    if (pimpl_->sessions_[pos].first)
+    try
+    {
+        pimpl_->warm_up(parameters, minSize);
+    }
+    catch (...)
+    {
+        pthread_mutex_destroy(&(pimpl_->mtx_));
+        delete pimpl_;
+        throw;
+    }
+}
+
+connection_pool::~connection_pool()
+{
+    pimpl_->stop_reaper();
+
+    pthread_mutex_destroy(&(pimpl_->mtx_));
+
+    delete pimpl_;
+}
+
+bool connection_pool::try_lease(std::size_t & pos, int timeout)
+{
+    bool mustOpen;
+
+    // try to take a free entry without locking anything first
+    if (pimpl_->take_free(pos, mustOpen) == false &&
+        pimpl_->wait_for_free(pos, mustOpen, timeout) == false)
     {
-        pthread_mutex_unlock(&(pimpl_->mtx_));
-        throw soci_error("Cannot release pool entry (already free)");
+        return false;
     }
 
-    pimpl_->sessions_[pos].first = true;
+    try
+    {
+        pimpl_->prepare_leased(pos, mustOpen);
+    }
+    catch (...)
+    {
+        // the entry is available again
+        pimpl_->notify();
+        throw;
+    }
 
-    pthread_mutex_unlock(&(pimpl_->mtx_));
+    return true;
+}
 
-    pthread_cond_signal(&(pimpl_->cond_));
+void connection_pool::give_back(std::size_t pos)
+{
+    pimpl_->put_free(pos);
+    pimpl_->notify();
 }
 
 #else
 // Windows implementation
 
-#include <windows.h>
+namespace // anonymous
+{
 
-using namespace soci;
+DWORD WINAPI session_opener_thread(LPVOID arg)
+{
+    run_session_opener(*static_cast<session_opener *>(arg));
+    return 0;
+}
+
+DWORD WINAPI idle_reaper_thread(LPVOID arg)
+{
+    static_cast<connection_pool_base *>(arg)->run_reaper();
+    return 0;
+}
 
-struct connection_pool::connection_pool_impl
+void run_session_openers(std::vector<session_opener> & openers)
 {
-    bool find_free(std::size_t & pos)
+    std::vector<HANDLE> threads(openers.size());
+    for (std::size_t i = 0; i != openers.size(); ++i)
     {
-        for (std::size_t i = 0; i != sessions_.size(); ++i)
+        threads[i] = CreateThread(NULL, 0,
+            session_opener_thread, &openers[i], 0, NULL);
+        if (threads[i] == NULL)
+        {
+            // just do it in this thread then
+            run_session_opener(openers[i]);
+        }
+    }
+
+    for (std::size_t i = 0; i != openers.size(); ++i)
+    {
+        if (threads[i] != NULL)
+        {
+            WaitForSingleObject(threads[i], INFINITE);
+            CloseHandle(threads[i]);
+        }
+    }
+}
+
+} // namespace anonymous
+
+struct connection_pool::connection_pool_impl : connection_pool_base
+{
+    connection_pool_impl(std::size_t size, std::size_t openSize)
+        : connection_pool_base(size, openSize), sem_(NULL),
+          reaper_(NULL), reaperEvent_(NULL), reaperStarting_(0)
+    {
+    }
+
+    ~connection_pool_impl()
+    {
+        stop_reaper();
+
+        if (sem_ != NULL)
+        {
+            CloseHandle(sem_);
+        }
+    }
+
+    std::size_t close_idle(int seconds)
+    {
+        // this doesn't change the number of available entries
+        std::vector<std::size_t> evicted;
+        if (evict_idle(seconds, evicted) == false)
         {
-            if (sessions_[i].first)
+            return 0;
+        }
+
+        close_evicted(evicted);
+
+        return evicted.size();
+    }
+
+    // Start the thread closing the idle sessions if it's not running yet or
+    // let it know that the idle timeout has changed otherwise.
+    void start_reaper()
+    {
+        if (compare_and_swap(&reaperStarting_, 0, 1) == false)
+        {
+            // already started (or being started by another thread)
+            if (reaperEvent_ != NULL)
             {
-                pos = i;
-                return true;
+                SetEvent(reaperEvent_);
             }
+
+            return;
         }
 
-        return false;
+        if (atomic_load(&idleTimeout_) == 0)
+        {
+            // no need to start it yet
+            atomic_store(&reaperStarting_, 0);
+            return;
+        }
+
+        reaperEvent_ = CreateEvent(NULL, FALSE, FALSE, NULL);
+        if (reaperEvent_ != NULL)
+        {
+            reaper_ = CreateThread(NULL, 0, idle_reaper_thread,
+                static_cast<connection_pool_base *>(this), 0, NULL);
+            if (reaper_ == NULL)
+            {
+                CloseHandle(reaperEvent_);
+                reaperEvent_ = NULL;
+            }
+        }
+
+        if (reaper_ == NULL)
+        {
+            atomic_store(&reaperStarting_, 0);
+            throw soci_error("Failed to start the thread closing idle sessions");
+        }
+    }
+
+    void run_reaper() SOCI_OVERRIDE
+    {
+        for (;;)
+        {
+            int const timeout = static_cast<int>(atomic_load(&idleTimeout_));
+            DWORD const cc = WaitForSingleObject(reaperEvent_, timeout != 0
+                ? static_cast<DWORD>(reaper_interval(timeout)) : INFINITE);
+
+            if (atomic_load(&stopReaper_) != 0 || cc == WAIT_FAILED)
+            {
+                break;
+            }
+
+            // otherwise the event was set because the timeout changed
+            if (cc == WAIT_TIMEOUT)
+            {
+                close_idle(timeout);
+            }
+        }
     }
 
-    // by convention, first == true means the entry is free (not used)
-    std::vector<std::pair<bool, session *> > sessions_;
+    void stop_reaper()
+    {
+        if (reaper_ == NULL)
+        {
+            return;
+        }
+
+        atomic_store(&stopReaper_, 1);
+        SetEvent(reaperEvent_);
+
+        WaitForSingleObject(reaper_, INFINITE);
+        CloseHandle(reaper_);
+        CloseHandle(reaperEvent_);
+        reaper_ = NULL;
+    }
 
-    CRITICAL_SECTION mtx_;
+    // counts the free entries, the threads waiting for it are woken up one
+    // by one in (roughly) FIFO order
     HANDLE sem_;
+
+    // the thread closing the idle sessions of an elastic pool, if any, and
+    // the event used to wake it up
+    HANDLE reaper_;
+    HANDLE reaperEvent_;
+    atomic_long volatile reaperStarting_;
 };
 
 connection_pool::connection_pool(std::size_t size)
 {
-    if (size == 0)
+    if (size == 0 || size > 0xfffffffeu)
     {
         throw soci_error("Invalid pool size");
     }
 
-    pimpl_ = new connection_pool_impl();
-    pimpl_->sessions_.resize(size);
-    for (std::size_t i = 0; i != size; ++i)
-    {
-        pimpl_->sessions_[i] = std::make_pair(true, new session());
-    }
-
-    InitializeCriticalSection(&(pimpl_->mtx_));
+    pimpl_ = new connection_pool_impl(size, size);
 
     // initially all entries are available
-    HANDLE s = CreateSemaphore(NULL,
+    pimpl_->sem_ = CreateSemaphore(NULL,
         static_cast<LONG>(size), static_cast<LONG>(size), NULL);
-    if (s == NULL)
+    if (pimpl_->sem_ == NULL)
     {
+        delete pimpl_;
         throw soci_error("Synchronization error");
     }
-
-    pimpl_->sem_ = s;
 }
 
-connection_pool::~connection_pool()
+connection_pool::connection_pool(connection_parameters const & parameters,
+    std::size_t minSize, std::size_t maxSize)
 {
-    for (std::size_t i = 0; i != pimpl_->sessions_.size(); ++i)
+    if (maxSize == 0 || maxSize > 0xfffffffeu || minSize > maxSize)
+    {
+        throw soci_error("Invalid pool size");
+    }
+
+    pimpl_ = new connection_pool_impl(maxSize, minSize);
+
+    // all entries are available, even if not all of them are opened yet
+    pimpl_->sem_ = CreateSemaphore(NULL,
+        static_cast<LONG>(maxSize), static_cast<LONG>(maxSize), NULL);
+    if (pimpl_->sem_ == NULL)
     {
-        delete pimpl_->sessions_[i].second;
+        delete pimpl_;
+        throw soci_error("Synchronization error");
     }
 
-    DeleteCriticalSection(&(pimpl_->mtx_));
-    CloseHandle(pimpl_->sem_);
+    try
+    {
+        pimpl_->warm_up(parameters, minSize);
+    }
+    catch (...)
+    {
+        delete pimpl_;
+        throw;
+    }
+}
 
+connection_pool::~connection_pool()
+{
     delete pimpl_;
 }
 
@@ -252,19 +1246,24 @@ bool connection_pool::try_lease(std::size_t & pos, int timeout)
         timeout >= 0 ? static_cast<DWORD>(timeout) : INFINITE);
     if (cc == WAIT_OBJECT_0)
     {
-        // semaphore acquired, there is (at least) one free entry
-
-        EnterCriticalSection(&(pimpl_->mtx_));
-
-        if (!pimpl_->find_free(pos))
+        // semaphore acquired, there is (at least) one free entry, but it
+        // can be temporarily unavailable while evicting the idle sessions
+        bool mustOpen;
+        while (pimpl_->take_free(pos, mustOpen) == false)
         {
-            // this should be impossible
-            throw soci_error("Getting connection from the pool unexpectedly failed");
+            SwitchToThread();
         }
 
-        pimpl_->sessions_[pos].first = false;
-
-        LeaveCriticalSection(&(pimpl_->mtx_));
+        try
+        {
+            pimpl_->prepare_leased(pos, mustOpen);
+        }
+        catch (...)
+        {
+            // the entry is available again
+            ReleaseSemaphore(pimpl_->sem_, 1, NULL);
+            throw;
+        }
 
         return true;
     }
@@ -280,22 +1279,7 @@ bool connection_pool::try_lease(std::size_t & pos, int timeout)
 
 void connection_pool::give_back(std::size_t pos)
 {
-    if (pos >= pimpl_->sessions_.size())
-    {
-        throw soci_error("Invalid pool position");
-    }
-
-    EnterCriticalSection(&(pimpl_->mtx_));
-
-    if (pimpl_->sessions_[pos].first)
-    {
-        LeaveCriticalSection(&(pimpl_->mtx_));
-        throw soci_error("Cannot release pool entry (already free)");
-    }
-
-    pimpl_->sessions_[pos].first = true;
-
-    LeaveCriticalSection(&(pimpl_->mtx_));
+    pimpl_->put_free(pos);
 
     ReleaseSemaphore(pimpl_->sem_, 1, NULL);
 }
@@ -309,7 +1293,7 @@ session & connection_pool::at(std::size_t pos)
         throw soci_error("Invalid pool position");
     }
 
-    return *(pimpl_->sessions_[pos].second);
+    return *(pimpl_->sessions_[pos]);
 }
 
 std::size_t connection_pool::lease()
@@ -323,4 +1307,43 @@ std::size_t connection_pool::lease()
     return pos;
 }
 
+void connection_pool::set_idle_timeout(int seconds)
+{
+    if (seconds < 0)
+    {
+        throw soci_error("Invalid idle timeout");
+    }
+
+    atomic_store(&pimpl_->idleTimeout_, seconds);
+
+    // only the elastic pools close their sessions themselves
+    if (pimpl_->elastic_)
+    {
+        pimpl_->start_reaper();
+    }
+}
+
+std::size_t connection_pool::close_idle_sessions(int seconds)
+{
+    if (seconds < 0)
+    {
+        throw soci_error("Invalid idle timeout");
+    }
+
+    return pimpl_->close_idle(seconds);
+}
+
+void connection_pool::set_validate_on_lease(bool validate)
+{
+    pimpl_->validateOnLease_ = validate;
+}
+
+std::size_t connection_pool::get_size() const
+{
+    if (pimpl_->elastic_)
+    {
+        return static_cast<std::size_t>(atomic_load(&pimpl_->openCount_));
+    }
 
+    return pimpl_->sessions_.size();
+}
@@ -38,6 +38,10 @@ logger_impl::~logger_impl()
 {
 }
 
+void logger_impl::end_query_phase(std::string const &, query_phase_info const &)
+{
+}
+
 void logger_impl::set_stream(std::ostream *)
 {
     throw_not_supported();
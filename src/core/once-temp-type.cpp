@@ -17,7 +17,7 @@ once_temp_type::once_temp_type(session & s)
     : rcst_(new ref_counted_statement(s))
 {
     // this is the beginning of new query
-    s.get_query_stream().str("");
+    s.reset_query();
 }
 
 once_temp_type::once_temp_type(once_temp_type const & o)
@@ -56,7 +56,7 @@ ddl_type::ddl_type(session & s)
     : s_(&s), rcst_(new ref_counted_statement(s))
 {
     // this is the beginning of new query
-    s.get_query_stream().str("");
+    s.reset_query();
 }
 
 ddl_type::ddl_type(const ddl_type & d)
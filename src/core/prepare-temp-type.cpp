@@ -17,7 +17,7 @@ prepare_temp_type::prepare_temp_type(session & s)
     : rcpi_(new ref_counted_prepare_info(s))
 {
     // this is the beginning of new query
-    s.get_query_stream().str("");
+    s.reset_query();
 }
 
 prepare_temp_type::prepare_temp_type(prepare_temp_type const & o)
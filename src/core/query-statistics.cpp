@@ -0,0 +1,256 @@
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#define SOCI_SOURCE
+#include "soci/query-statistics.h"
+#include "soci/error.h"
+#include <cctype>
+#include <map>
+#include <utility>
+
+#ifndef _WIN32
+#include <pthread.h>
+#else
+#include <windows.h>
+#endif // _WIN32
+
+using namespace soci;
+
+namespace // anonymous
+{
+
+// Minimal mutex wrapper, only used to protect the statistics map.
+#ifndef _WIN32
+
+class stats_mutex
+{
+public:
+    stats_mutex()
+    {
+        if (pthread_mutex_init(&mtx_, NULL) != 0)
+        {
+            throw soci_error("Synchronization error");
+        }
+    }
+
+    ~stats_mutex() { pthread_mutex_destroy(&mtx_); }
+
+    void lock()
+    {
+        if (pthread_mutex_lock(&mtx_) != 0)
+        {
+            throw soci_error("Synchronization error");
+        }
+    }
+
+    void unlock() { pthread_mutex_unlock(&mtx_); }
+
+private:
+    pthread_mutex_t mtx_;
+};
+
+#else
+
+class stats_mutex
+{
+public:
+    stats_mutex() { InitializeCriticalSection(&cs_); }
+    ~stats_mutex() { DeleteCriticalSection(&cs_); }
+
+    void lock() { EnterCriticalSection(&cs_); }
+    void unlock() { LeaveCriticalSection(&cs_); }
+
+private:
+    CRITICAL_SECTION cs_;
+};
+
+#endif // _WIN32
+
+class stats_lock
+{
+public:
+    explicit stats_lock(stats_mutex & mtx) : mtx_(mtx) { mtx_.lock(); }
+    ~stats_lock() { mtx_.unlock(); }
+
+private:
+    stats_mutex & mtx_;
+};
+
+bool is_identifier_char(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_'
+        || c == '$' || c == ':' || c == '@';
+}
+
+} // namespace anonymous
+
+struct query_statistics::query_statistics_impl
+{
+    typedef std::map<std::string, query_statistics_entry> entries_type;
+
+    entries_type entries_;
+    stats_mutex mtx_;
+};
+
+query_statistics::query_statistics()
+    : pimpl_(new query_statistics_impl())
+{
+}
+
+query_statistics::~query_statistics()
+{
+    delete pimpl_;
+}
+
+void query_statistics::add_query_phase(std::string const & query,
+    query_phase_info const & info)
+{
+    // do the normalization before locking, it doesn't need to be protected
+    std::string const key = normalize_query(query);
+
+    stats_lock lock(pimpl_->mtx_);
+
+    query_statistics_impl::entries_type::iterator it
+        = pimpl_->entries_.find(key);
+    if (it == pimpl_->entries_.end())
+    {
+        it = pimpl_->entries_.insert(
+            std::make_pair(key, query_statistics_entry())).first;
+        it->second.query_ = key;
+    }
+
+    query_statistics_entry & entry = it->second;
+    if (info.phase_ == qp_execute)
+    {
+        ++entry.calls_;
+    }
+    if (info.failed_)
+    {
+        ++entry.errors_;
+    }
+    if (info.rows_ > 0)
+    {
+        entry.rows_ += info.rows_;
+    }
+
+    entry.totalDuration_ += info.duration_;
+    if (info.duration_ > entry.maxDuration_)
+    {
+        entry.maxDuration_ = info.duration_;
+    }
+}
+
+std::vector<query_statistics_entry> query_statistics::get_snapshot() const
+{
+    std::vector<query_statistics_entry> snapshot;
+
+    stats_lock lock(pimpl_->mtx_);
+
+    snapshot.reserve(pimpl_->entries_.size());
+    for (query_statistics_impl::entries_type::const_iterator
+            it = pimpl_->entries_.begin(); it != pimpl_->entries_.end(); ++it)
+    {
+        snapshot.push_back(it->second);
+    }
+
+    return snapshot;
+}
+
+std::size_t query_statistics::get_size() const
+{
+    stats_lock lock(pimpl_->mtx_);
+
+    return pimpl_->entries_.size();
+}
+
+void query_statistics::reset()
+{
+    stats_lock lock(pimpl_->mtx_);
+
+    pimpl_->entries_.clear();
+}
+
+std::string query_statistics::normalize_query(std::string const & query)
+{
+    std::string result;
+    result.reserve(query.size());
+
+    std::string::size_type const len = query.size();
+    std::string::size_type i = 0;
+    while (i != len)
+    {
+        char const c = query[i];
+
+        if (std::isspace(static_cast<unsigned char>(c)))
+        {
+            while (i != len && std::isspace(static_cast<unsigned char>(query[i])))
+            {
+                ++i;
+            }
+
+            // collapse all whitespace runs into a single space and drop the
+            // leading and trailing ones
+            if (result.empty() == false && i != len)
+            {
+                result += ' ';
+            }
+        }
+        else if (c == '\'')
+        {
+            // skip the string literal, including the doubled quotes in it
+            for (++i; i != len; ++i)
+            {
+                if (query[i] == '\'')
+                {
+                    if (i + 1 == len || query[i + 1] != '\'')
+                    {
+                        ++i;
+                        break;
+                    }
+
+                    ++i;
+                }
+            }
+
+            result += '?';
+        }
+        else if (std::isdigit(static_cast<unsigned char>(c))
+            && (result.empty() || is_identifier_char(result[result.size() - 1]) == false))
+        {
+            // skip the numeric literal, including its fractional part and
+            // exponent, if any
+            for (++i; i != len; ++i)
+            {
+                char const n = query[i];
+                if (std::isdigit(static_cast<unsigned char>(n)) || n == '.')
+                {
+                    continue;
+                }
+
+                if ((n == 'e' || n == 'E') && i + 1 != len)
+                {
+                    char const next = query[i + 1];
+                    if ((next == '+' || next == '-') && i + 2 != len)
+                    {
+                        ++i;
+                    }
+                    continue;
+                }
+
+                break;
+            }
+
+            result += '?';
+        }
+        else
+        {
+            result += c;
+            ++i;
+        }
+    }
+
+    return result;
+}
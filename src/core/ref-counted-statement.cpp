@@ -21,12 +21,39 @@ void ref_counted_statement::final_action()
 {
     try
     {
-        st_.alloc();
-        st_.prepare(session_.get_query(), st_one_time_query);
+        std::string const & query = session_.get_query_text();
+
+        // Statements kept in the cache are prepared as repeatable ones, so
+        // that they could be executed again.
+        bool const useCache = session_.get_statement_cache_size() != 0;
+
+        statement_backend * const cached = useCache
+            ? session_.take_cached_statement(query)
+            : NULL;
+        if (cached)
+        {
+            st_.use_prepared_backend(cached, query);
+        }
+        else
+        {
+            st_.alloc();
+            st_.prepare(query,
+                useCache ? st_repeatable_query : st_one_time_query);
+        }
+
         st_.define_and_bind();
 
         const bool gotData = st_.execute(true);
         session_.set_got_data(gotData);
+
+        if (useCache)
+        {
+            // The query text may have been already overwritten by another
+            // query executed on this session, e.g. by a type conversion.
+            session_.cache_statement(st_.get_query(),
+                st_.release_prepared_backend());
+            return;
+        }
     }
     catch (...)
     {
@@ -41,3 +68,28 @@ std::ostringstream& ref_counted_statement_base::get_query_stream()
 {
     return session_.get_query_stream();
 }
+
+void ref_counted_statement_base::append_to_query(std::string const & s)
+{
+    session_.append_to_query(s);
+}
+
+void ref_counted_statement_base::append_to_query(char const * s)
+{
+    session_.append_to_query(s);
+}
+
+void ref_counted_statement_base::append_to_query(long long n)
+{
+    session_.append_to_query(n);
+}
+
+void ref_counted_statement_base::append_to_query(unsigned long long n)
+{
+    session_.append_to_query(n);
+}
+
+void ref_counted_statement_base::append_to_query(double d)
+{
+    session_.append_to_query(d);
+}
@@ -16,6 +16,24 @@
 using namespace soci;
 using namespace details;
 
+namespace // anonymous
+{
+
+// FNV-1a hash of the column name
+std::size_t hash_column_name(std::string const& name)
+{
+    std::size_t h = 2166136261u;
+    for (std::size_t i = 0; i != name.size(); ++i)
+    {
+        h ^= static_cast<unsigned char>(name[i]);
+        h *= 16777619u;
+    }
+
+    return h;
+}
+
+} // namespace anonymous
+
 row::row()
     : uppercaseColumnNames_(false)
     , currentPos_(0)
@@ -49,12 +67,93 @@ void row::add_properties(column_properties const &cp)
 
         columns_[columns_.size() - 1].set_name(columnName);
     }
+
+    // keep the table at most half full
+    std::size_t const count = columns_.size();
+    if (2 * count > index_.size())
+    {
+        std::size_t newSize = 16;
+        while (newSize < 2 * count)
+        {
+            newSize *= 2;
+        }
+
+        index_.assign(newSize, 0);
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            add_to_index(i);
+        }
+    }
     else
     {
-        columnName = originalName;
+        add_to_index(count - 1);
+    }
+}
+
+void row::add_to_index(std::size_t pos)
+{
+    std::string const& name = columns_[pos].get_name();
+
+    std::size_t const mask = index_.size() - 1;
+    for (std::size_t i = hash_column_name(name) & mask; ; i = (i + 1) & mask)
+    {
+        std::size_t& slot = index_[i];
+
+        // the last column with the given name wins
+        if (slot == 0 || columns_[slot - 1].get_name() == name)
+        {
+            slot = pos + 1;
+            break;
+        }
+    }
+}
+
+void row::reserve(std::size_t columns)
+{
+    columns_.reserve(columns);
+    holders_.reserve(columns);
+    strings_.reserve(columns);
+    indicators_.reserve(columns);
+}
+
+bool row::has_columns(std::vector<column_description> const& columns) const
+{
+    std::size_t const count = columns.size();
+    if (holders_.size() != count || columns_.size() != count)
+    {
+        return false;
     }
 
-    index_[columnName] = columns_.size() - 1;
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        column_properties const& props = columns_[i];
+        if (props.get_data_type() != columns[i].dataType_ ||
+            holders_[i].type_ != columns[i].dataType_)
+        {
+            return false;
+        }
+
+        // compare with the name as it would be stored by add_properties()
+        std::string const& name = columns[i].name_;
+        std::string const& storedName = props.get_name();
+        if (storedName.size() != name.size())
+        {
+            return false;
+        }
+
+        for (std::size_t n = 0; n != name.size(); ++n)
+        {
+            char const c = uppercaseColumnNames_
+                ? static_cast<char>(std::toupper(name[n]))
+                : name[n];
+            if (storedName[n] != c)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
 }
 
 std::size_t row::size() const
@@ -64,22 +163,16 @@ std::size_t row::size() const
 
 void row::clean_up()
 {
-    std::size_t const hsize = holders_.size();
-    for (std::size_t i = 0; i != hsize; ++i)
-    {
-        delete holders_[i];
-        delete indicators_[i];
-    }
-
     columns_.clear();
     holders_.clear();
+    strings_.clear();
     indicators_.clear();
     index_.clear();
 }
 
 indicator row::get_indicator(std::size_t pos) const
 {
-    return *indicators_.at(pos);
+    return indicators_.at(pos);
 }
 
 indicator row::get_indicator(std::string const &name) const
@@ -99,13 +192,21 @@ column_properties const & row::get_properties(std::string const &name) const
 
 std::size_t row::find_column(std::string const &name) const
 {
-    std::map<std::string, std::size_t>::const_iterator it = index_.find(name);
-    if (it == index_.end())
+    if (index_.empty() == false)
     {
-        std::ostringstream msg;
-        msg << "Column '" << name << "' not found";
-        throw soci_error(msg.str());
+        std::size_t const mask = index_.size() - 1;
+        for (std::size_t i = hash_column_name(name) & mask; index_[i] != 0;
+             i = (i + 1) & mask)
+        {
+            std::size_t const pos = index_[i] - 1;
+            if (columns_[pos].get_name() == name)
+            {
+                return pos;
+            }
+        }
     }
 
-    return it->second;
+    std::ostringstream msg;
+    msg << "Column '" << name << "' not found";
+    throw soci_error(msg.str());
 }
@@ -11,6 +11,12 @@
 #include "soci/connection-pool.h"
 #include "soci/soci-backend.h"
 #include "soci/query_transformation.h"
+// std
+#include <clocale>
+#include <cstdio>
+#include <list>
+#include <map>
+#include <utility>
 
 using namespace soci;
 using namespace soci::details;
@@ -70,12 +76,196 @@ private:
     std::string lastQuery_;
 };
 
+// Append the decimal representation of the number with the given absolute
+// value and sign to the string.
+void append_number(std::string & s, unsigned long long absValue, bool negative)
+{
+    char buf[24];
+    char * const end = buf + sizeof(buf);
+    char * p = end;
+    do
+    {
+        *--p = static_cast<char>('0' + absValue % 10);
+        absValue /= 10;
+    }
+    while (absValue != 0);
+
+    if (negative)
+    {
+        *--p = '-';
+    }
+
+    s.append(p, end);
+}
+
+// Append the number formatted in the same way as by the default query stream,
+// i.e. using the default precision and the period as decimal separator, even
+// if the C locale uses a different one.
+void append_number(std::string & s, double d)
+{
+    char buf[32];
+    int const len = snprintf(buf, sizeof(buf), "%g", d);
+    if (len <= 0 || static_cast<std::size_t>(len) >= sizeof(buf))
+    {
+        throw soci_error("Cannot format number in query.");
+    }
+
+    char const point = *std::localeconv()->decimal_point;
+    if (point != '.')
+    {
+        for (int i = 0; i != len; ++i)
+        {
+            if (buf[i] == point)
+            {
+                buf[i] = '.';
+            }
+        }
+    }
+
+    s.append(buf, len);
+}
+
 } // namespace anonymous
 
+namespace soci
+{
+
+namespace details
+{
+
+// Statements prepared for the one-time queries, indexed by the query text and
+// ordered from the most to the least recently used one. The entries of the
+// statements currently in use have NULL statement pointers.
+class statement_cache
+{
+public:
+    explicit statement_cache(std::size_t maxSize)
+        : maxSize_(maxSize)
+    {
+    }
+
+    ~statement_cache()
+    {
+        clear();
+    }
+
+    std::size_t get_max_size() const { return maxSize_; }
+
+    void set_max_size(std::size_t maxSize)
+    {
+        maxSize_ = maxSize;
+        while (index_.size() > maxSize_)
+        {
+            discard_least_recently_used();
+        }
+    }
+
+    // The entry of the returned statement is kept, so that it doesn't need
+    // to be allocated again when the statement is put back.
+    statement_backend * take(std::string const & query)
+    {
+        index_type::iterator const it = index_.find(query);
+        if (it == index_.end())
+        {
+            return NULL;
+        }
+
+        entries_.splice(entries_.begin(), entries_, it->second);
+
+        statement_backend * const st = it->second->second;
+        it->second->second = NULL;
+
+        return st;
+    }
+
+    void put(std::string const & query, statement_backend * st)
+    {
+        if (maxSize_ == 0)
+        {
+            discard(st);
+            return;
+        }
+
+        index_type::iterator const it = index_.find(query);
+        if (it != index_.end())
+        {
+            // Another statement for the same query could have been put back
+            // while this one was in use, there is no need to keep both.
+            if (it->second->second != NULL)
+            {
+                discard(st);
+            }
+            else
+            {
+                it->second->second = st;
+            }
+            return;
+        }
+
+        entries_.push_front(std::make_pair(query, st));
+        index_[query] = entries_.begin();
+
+        if (index_.size() > maxSize_)
+        {
+            discard_least_recently_used();
+        }
+    }
+
+    void clear()
+    {
+        while (index_.empty() == false)
+        {
+            discard_least_recently_used();
+        }
+    }
+
+private:
+    typedef std::list<std::pair<std::string, statement_backend *> > entries_type;
+    typedef std::map<std::string, entries_type::iterator> index_type;
+
+    static void discard(statement_backend * st)
+    {
+        // the statement may be currently in use
+        if (st == NULL)
+        {
+            return;
+        }
+
+        try
+        {
+            st->clean_up();
+        }
+        catch (...)
+        {
+            // The statement is not needed any more anyhow.
+        }
+
+        delete st;
+    }
+
+    void discard_least_recently_used()
+    {
+        statement_backend * const st = entries_.back().second;
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+
+        discard(st);
+    }
+
+    std::size_t maxSize_;
+    entries_type entries_;
+    index_type index_;
+};
+
+} // namespace details
+
+} // namespace soci
+
 session::session()
     : once(this), prepare(this), query_transformation_(NULL),
       logger_(new standard_logger_impl),
-      uppercaseColumnNames_(false), backEnd_(NULL),
+      uppercaseColumnNames_(false), rowsetPrefetchSize_(1),
+      statementCache_(NULL), backEnd_(NULL),
       isFromPool_(false), pool_(NULL)
 {
 }
@@ -84,7 +274,8 @@ session::session(connection_parameters const & parameters)
     : once(this), prepare(this), query_transformation_(NULL),
       logger_(new standard_logger_impl),
       lastConnectParameters_(parameters),
-      uppercaseColumnNames_(false), backEnd_(NULL),
+      uppercaseColumnNames_(false), rowsetPrefetchSize_(1),
+      statementCache_(NULL), backEnd_(NULL),
       isFromPool_(false), pool_(NULL)
 {
     open(lastConnectParameters_);
@@ -95,7 +286,8 @@ session::session(backend_factory const & factory,
     : once(this), prepare(this), query_transformation_(NULL),
     logger_(new standard_logger_impl),
       lastConnectParameters_(factory, connectString),
-      uppercaseColumnNames_(false), backEnd_(NULL),
+      uppercaseColumnNames_(false), rowsetPrefetchSize_(1),
+      statementCache_(NULL), backEnd_(NULL),
       isFromPool_(false), pool_(NULL)
 {
     open(lastConnectParameters_);
@@ -106,7 +298,8 @@ session::session(std::string const & backendName,
     : once(this), prepare(this), query_transformation_(NULL),
       logger_(new standard_logger_impl),
       lastConnectParameters_(backendName, connectString),
-      uppercaseColumnNames_(false), backEnd_(NULL),
+      uppercaseColumnNames_(false), rowsetPrefetchSize_(1),
+      statementCache_(NULL), backEnd_(NULL),
       isFromPool_(false), pool_(NULL)
 {
     open(lastConnectParameters_);
@@ -116,7 +309,8 @@ session::session(std::string const & connectString)
     : once(this), prepare(this), query_transformation_(NULL),
       logger_(new standard_logger_impl),
       lastConnectParameters_(connectString),
-      uppercaseColumnNames_(false), backEnd_(NULL),
+      uppercaseColumnNames_(false), rowsetPrefetchSize_(1),
+      statementCache_(NULL), backEnd_(NULL),
       isFromPool_(false), pool_(NULL)
 {
     open(lastConnectParameters_);
@@ -125,6 +319,7 @@ session::session(std::string const & connectString)
 session::session(connection_pool & pool)
     : query_transformation_(NULL),
       logger_(new standard_logger_impl),
+      statementCache_(NULL),
       isFromPool_(true), pool_(&pool)
 {
     poolPosition_ = pool.lease();
@@ -144,6 +339,7 @@ session::~session()
     else
     {
         delete query_transformation_;
+        delete statementCache_;
         delete backEnd_;
     }
 }
@@ -198,6 +394,12 @@ void session::close()
     }
     else
     {
+        // cached statements can't outlive the connection they belong to
+        if (statementCache_ != NULL)
+        {
+            statementCache_->clear();
+        }
+
         delete backEnd_;
         backEnd_ = NULL;
     }
@@ -227,6 +429,16 @@ void session::reconnect()
     }
 }
 
+bool session::is_connected() const
+{
+    if (isFromPool_)
+    {
+        return pool_->at(poolPosition_).is_connected();
+    }
+
+    return backEnd_ != NULL && backEnd_->is_connected();
+}
+
 void session::begin()
 {
     ensureConnected(backEnd_);
@@ -248,6 +460,27 @@ void session::rollback()
     backEnd_->rollback();
 }
 
+void session::begin_pipeline()
+{
+    ensureConnected(backEnd_);
+
+    backEnd_->begin_pipeline();
+}
+
+long long session::sync_pipeline()
+{
+    ensureConnected(backEnd_);
+
+    return backEnd_->sync_pipeline();
+}
+
+long long session::end_pipeline()
+{
+    ensureConnected(backEnd_);
+
+    return backEnd_->end_pipeline();
+}
+
 std::ostringstream & session::get_query_stream()
 {
     if (isFromPool_)
@@ -268,16 +501,107 @@ std::string session::get_query() const
     }
     else
     {
-        // preserve logical constness of get_query,
-        // stream used as read-only here,
-        session* pthis = const_cast<session*>(this);
+        // one of the two places where user-defined query transformation is
+        // applied, see get_query_text()
+        if (query_transformation_)
+        {
+            return (*query_transformation_)(query_);
+        }
+        return query_;
+    }
+}
 
-        // sole place where any user-defined query transformation is applied
+void session::reset_query()
+{
+    if (isFromPool_)
+    {
+        pool_->at(poolPosition_).reset_query();
+    }
+    else
+    {
+        // this keeps the already allocated memory
+        query_.clear();
+    }
+}
+
+void session::append_to_query(std::string const & s)
+{
+    if (isFromPool_)
+    {
+        pool_->at(poolPosition_).append_to_query(s);
+    }
+    else
+    {
+        query_ += s;
+    }
+}
+
+void session::append_to_query(char const * s)
+{
+    if (isFromPool_)
+    {
+        pool_->at(poolPosition_).append_to_query(s);
+    }
+    else
+    {
+        query_ += s;
+    }
+}
+
+void session::append_to_query(long long n)
+{
+    if (isFromPool_)
+    {
+        pool_->at(poolPosition_).append_to_query(n);
+    }
+    else
+    {
+        // avoid overflow when negating the smallest value
+        append_number(query_,
+            n < 0 ? 0ULL - static_cast<unsigned long long>(n)
+                  : static_cast<unsigned long long>(n),
+            n < 0);
+    }
+}
+
+void session::append_to_query(unsigned long long n)
+{
+    if (isFromPool_)
+    {
+        pool_->at(poolPosition_).append_to_query(n);
+    }
+    else
+    {
+        append_number(query_, n, false);
+    }
+}
+
+void session::append_to_query(double d)
+{
+    if (isFromPool_)
+    {
+        pool_->at(poolPosition_).append_to_query(d);
+    }
+    else
+    {
+        append_number(query_, d);
+    }
+}
+
+std::string const & session::get_query_text()
+{
+    if (isFromPool_)
+    {
+        return pool_->at(poolPosition_).get_query_text();
+    }
+    else
+    {
         if (query_transformation_)
         {
-            return (*query_transformation_)(pthis->get_query_stream().str());
+            transformedQuery_ = (*query_transformation_)(query_);
+            return transformedQuery_;
         }
-        return pthis->get_query_stream().str();
+        return query_;
     }
 }
 
@@ -355,6 +679,31 @@ void session::log_query(std::string const & query)
     }
 }
 
+bool session::wants_query_phases() const
+{
+    if (isFromPool_)
+    {
+        return pool_->at(poolPosition_).wants_query_phases();
+    }
+    else
+    {
+        return logger_.wants_query_phases();
+    }
+}
+
+void session::log_query_phase(std::string const & query,
+    query_phase_info const & info)
+{
+    if (isFromPool_)
+    {
+        pool_->at(poolPosition_).log_query_phase(query, info);
+    }
+    else
+    {
+        logger_.end_query_phase(query, info);
+    }
+}
+
 std::string session::get_last_query() const
 {
     if (isFromPool_)
@@ -415,6 +764,58 @@ bool session::get_uppercase_column_names() const
     }
 }
 
+void session::set_rowset_prefetch_size(std::size_t prefetchSize)
+{
+    if (isFromPool_)
+    {
+        pool_->at(poolPosition_).set_rowset_prefetch_size(prefetchSize);
+    }
+    else
+    {
+        rowsetPrefetchSize_ = prefetchSize;
+    }
+}
+
+std::size_t session::get_rowset_prefetch_size() const
+{
+    if (isFromPool_)
+    {
+        return pool_->at(poolPosition_).get_rowset_prefetch_size();
+    }
+    else
+    {
+        return rowsetPrefetchSize_;
+    }
+}
+
+void session::set_statement_cache_size(std::size_t size)
+{
+    if (isFromPool_)
+    {
+        pool_->at(poolPosition_).set_statement_cache_size(size);
+    }
+    else if (statementCache_ != NULL)
+    {
+        statementCache_->set_max_size(size);
+    }
+    else if (size != 0)
+    {
+        statementCache_ = new statement_cache(size);
+    }
+}
+
+std::size_t session::get_statement_cache_size() const
+{
+    if (isFromPool_)
+    {
+        return pool_->at(poolPosition_).get_statement_cache_size();
+    }
+    else
+    {
+        return statementCache_ != NULL ? statementCache_->get_max_size() : 0;
+    }
+}
+
 bool session::get_next_sequence_value(std::string const & sequence, long long & value)
 {
     ensureConnected(backEnd_);
@@ -557,6 +958,35 @@ statement_backend * session::make_statement_backend()
     return backEnd_->make_statement_backend();
 }
 
+statement_backend * session::take_cached_statement(std::string const & query)
+{
+    if (isFromPool_)
+    {
+        return pool_->at(poolPosition_).take_cached_statement(query);
+    }
+    else
+    {
+        return statementCache_ != NULL ? statementCache_->take(query) : NULL;
+    }
+}
+
+void session::cache_statement(std::string const & query, statement_backend * st)
+{
+    if (isFromPool_)
+    {
+        pool_->at(poolPosition_).cache_statement(query, st);
+    }
+    else if (statementCache_ != NULL && st->supports_reuse())
+    {
+        statementCache_->put(query, st);
+    }
+    else
+    {
+        st->clean_up();
+        delete st;
+    }
+}
+
 rowid_backend * session::make_rowid_backend()
 {
     ensureConnected(backEnd_);
@@ -10,6 +10,7 @@
 #include "soci/soci-simple.h"
 #include "soci/soci.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdio>
 #include <ctime>
@@ -305,39 +306,44 @@ struct statement_wrapper
     enum state { clean, defining, executing } statement_state;
     enum kind { empty, single, bulk } into_kind, use_kind;
 
-    // into elements
+    // into elements, all the vectors below are indexed by position and the
+    // vectors of values only extend up to the last element of their type
     int next_position;
     std::vector<data_type> into_types; // for both single and bulk
     std::vector<indicator> into_indicators;
-    std::map<int, std::string> into_strings;
-    std::map<int, int> into_ints;
-    std::map<int, long long> into_longlongs;
-    std::map<int, double> into_doubles;
-    std::map<int, std::tm> into_dates;
-    std::map<int, blob_wrapper *> into_blob;
+    std::vector<std::string> into_strings;
+    std::vector<int> into_ints;
+    std::vector<long long> into_longlongs;
+    std::vector<double> into_doubles;
+    std::vector<std::tm> into_dates;
+    std::vector<blob_wrapper *> into_blob;
 
     std::vector<std::vector<indicator> > into_indicators_v;
-    std::map<int, std::vector<std::string> > into_strings_v;
-    std::map<int, std::vector<int> > into_ints_v;
-    std::map<int, std::vector<long long> > into_longlongs_v;
-    std::map<int, std::vector<double> > into_doubles_v;
-    std::map<int, std::vector<std::tm> > into_dates_v;
-
-    // use elements
-    std::map<std::string, indicator> use_indicators;
-    std::map<std::string, std::string> use_strings;
-    std::map<std::string, int> use_ints;
-    std::map<std::string, long long> use_longlongs;
-    std::map<std::string, double> use_doubles;
-    std::map<std::string, std::tm> use_dates;
-    std::map<std::string, blob_wrapper *> use_blob;
-
-    std::map<std::string, std::vector<indicator> > use_indicators_v;
-    std::map<std::string, std::vector<std::string> > use_strings_v;
-    std::map<std::string, std::vector<int> > use_ints_v;
-    std::map<std::string, std::vector<long long> > use_longlongs_v;
-    std::map<std::string, std::vector<double> > use_doubles_v;
-    std::map<std::string, std::vector<std::tm> > use_dates_v;
+    std::vector<std::vector<std::string> > into_strings_v;
+    std::vector<std::vector<int> > into_ints_v;
+    std::vector<std::vector<long long> > into_longlongs_v;
+    std::vector<std::vector<double> > into_doubles_v;
+    std::vector<std::vector<std::tm> > into_dates_v;
+
+    // use elements, stored in the same way as into elements, their names are
+    // only used to find their positions
+    std::map<std::string, int> use_positions;
+    std::vector<std::string> use_names;
+    std::vector<data_type> use_types; // for both single and bulk
+    std::vector<indicator> use_indicators;
+    std::vector<std::string> use_strings;
+    std::vector<int> use_ints;
+    std::vector<long long> use_longlongs;
+    std::vector<double> use_doubles;
+    std::vector<std::tm> use_dates;
+    std::vector<blob_wrapper *> use_blob;
+
+    std::vector<std::vector<indicator> > use_indicators_v;
+    std::vector<std::vector<std::string> > use_strings_v;
+    std::vector<std::vector<int> > use_ints_v;
+    std::vector<std::vector<long long> > use_longlongs_v;
+    std::vector<std::vector<double> > use_doubles_v;
+    std::vector<std::vector<std::tm> > use_dates_v;
 
     // format is: "YYYY MM DD hh mm ss", but we make the buffer bigger to
     // avoid gcc -Wformat-truncation warnings as it considers that the output
@@ -353,18 +359,16 @@ private:
 
 statement_wrapper::~statement_wrapper()
 {
-    for (std::map<int, blob_wrapper *>::iterator iter = into_blob.begin(), last = into_blob.end();
-         iter != last; ++iter)
+    for (std::size_t i = 0; i != into_blob.size(); ++i)
     {
-        soci_destroy_blob(iter->second);
+        if (into_blob[i] != NULL)
+            soci_destroy_blob(into_blob[i]);
     }
 
-    for (std::map<std::string, blob_wrapper *>::iterator iter = use_blob.begin(), last = use_blob.end();
-         iter != last; ++iter)
+    for (std::size_t i = 0; i != use_blob.size(); ++i)
     {
-        soci::indicator &ind = use_indicators[iter->first];
-        blob_wrapper *&blob = iter->second;
-        if (ind == i_null && blob != NULL)
+        blob_wrapper *blob = use_blob[i];
+        if (use_indicators[i] == i_null && blob != NULL)
             soci_destroy_blob(blob);
     }
 }
@@ -427,7 +431,7 @@ bool position_check_failed(statement_wrapper & wrapper, statement_wrapper::kind
         return true;
     }
 
-    if (wrapper.into_types[position] != expected_type)
+    if (wrapper.into_kind != k || wrapper.into_types[position] != expected_type)
     {
         wrapper.is_ok = false;
         wrapper.error_message = "No into ";
@@ -490,31 +494,9 @@ bool index_check_failed(std::vector<T> const & v,
 }
 
 // helper for checking the uniqueness of the use element's name
-bool name_unique_check_failed(statement_wrapper & wrapper,
-    statement_wrapper::kind k, char const * name)
+bool name_unique_check_failed(statement_wrapper & wrapper, char const * name)
 {
-    bool is_unique;
-    if (k == statement_wrapper::single)
-    {
-        typedef std::map<std::string, indicator>::const_iterator iterator;
-        iterator const it = wrapper.use_indicators.find(name);
-        is_unique = it == wrapper.use_indicators.end();
-    }
-    else
-    {
-        // vector version
-
-        typedef std::map
-            <
-                std::string,
-                std::vector<indicator>
-            >::const_iterator iterator;
-
-        iterator const it = wrapper.use_indicators_v.find(name);
-        is_unique = it == wrapper.use_indicators_v.end();
-    }
-
-    if (is_unique)
+    if (wrapper.use_positions.find(name) == wrapper.use_positions.end())
     {
         wrapper.is_ok = true;
         return false;
@@ -527,133 +509,19 @@ bool name_unique_check_failed(statement_wrapper & wrapper,
     }
 }
 
-// helper for checking if the use element with the given name exists
+// helper for checking if the use element with the given name exists and
+// finding its position
 bool name_exists_check_failed(statement_wrapper & wrapper,
     char const * name, data_type expected_type,
-    statement_wrapper::kind k, char const * type_name)
+    statement_wrapper::kind k, char const * type_name, int & position)
 {
-    bool name_exists = false;
-    if (k == statement_wrapper::single)
-    {
-        switch (expected_type)
-        {
-        case dt_string:
-            {
-                typedef std::map
-                    <
-                        std::string,
-                        std::string
-                    >::const_iterator iterator;
-                iterator const it = wrapper.use_strings.find(name);
-                name_exists = (it != wrapper.use_strings.end());
-            }
-            break;
-        case dt_integer:
-            {
-                typedef std::map<std::string, int>::const_iterator iterator;
-                iterator const it = wrapper.use_ints.find(name);
-                name_exists = (it != wrapper.use_ints.end());
-            }
-            break;
-        case dt_long_long:
-        case dt_unsigned_long_long:
-            {
-                typedef std::map<std::string, long long>::const_iterator
-                    iterator;
-                iterator const it = wrapper.use_longlongs.find(name);
-                name_exists = (it != wrapper.use_longlongs.end());
-            }
-            break;
-        case dt_double:
-            {
-                typedef std::map<std::string, double>::const_iterator iterator;
-                iterator const it = wrapper.use_doubles.find(name);
-                name_exists = (it != wrapper.use_doubles.end());
-            }
-            break;
-        case dt_date:
-            {
-                typedef std::map<std::string, std::tm>::const_iterator iterator;
-                iterator const it = wrapper.use_dates.find(name);
-                name_exists = (it != wrapper.use_dates.end());
-            }
-            break;
-        case dt_blob:
-            {
-                typedef std::map<std::string, blob_wrapper *>::const_iterator iterator;
-                iterator const it = wrapper.use_blob.find(name);
-                name_exists = (it != wrapper.use_blob.end());
-            }
-        case dt_xml:
-            // no support for xml
-            break;
-        }
-    }
-    else
-    {
-        // vector version
-
-        switch (expected_type)
-        {
-        case dt_string:
-            {
-                typedef std::map
-                    <
-                        std::string,
-                        std::vector<std::string>
-                    >::const_iterator iterator;
-                iterator const it = wrapper.use_strings_v.find(name);
-                name_exists = (it != wrapper.use_strings_v.end());
-            }
-            break;
-        case dt_integer:
-            {
-                typedef std::map
-                    <
-                        std::string,
-                        std::vector<int>
-                    >::const_iterator iterator;
-                iterator const it = wrapper.use_ints_v.find(name);
-                name_exists = (it != wrapper.use_ints_v.end());
-            }
-            break;
-        case dt_long_long:
-        case dt_unsigned_long_long:
-            {
-                typedef std::map
-                    <
-                        std::string,
-                        std::vector<long long>
-                    >::const_iterator iterator;
-                iterator const it = wrapper.use_longlongs_v.find(name);
-                name_exists = (it != wrapper.use_longlongs_v.end());
-            }
-            break;
-        case dt_double:
-            {
-                typedef std::map<std::string,
-                    std::vector<double> >::const_iterator iterator;
-                iterator const it = wrapper.use_doubles_v.find(name);
-                name_exists = (it != wrapper.use_doubles_v.end());
-            }
-            break;
-        case dt_date:
-            {
-                typedef std::map<std::string,
-                        std::vector<std::tm> >::const_iterator iterator;
-                iterator const it = wrapper.use_dates_v.find(name);
-                name_exists = (it != wrapper.use_dates_v.end());
-            }
-            break;
-        case dt_blob:
-        case dt_xml:
-            // no support for bulk and xml load
-            break;
-        }
-    }
-
-    if (name_exists)
+    typedef std::map<std::string, int>::const_iterator iterator;
+    iterator const it = wrapper.use_positions.find(name);
+    if (it != wrapper.use_positions.end() &&
+        wrapper.use_kind == k &&
+        wrapper.use_types[it->second] == expected_type)
     {
+        position = it->second;
         wrapper.is_ok = true;
         return false;
     }
@@ -667,18 +535,89 @@ bool name_exists_check_failed(statement_wrapper & wrapper,
     }
 }
 
-// helper function for resizing all vectors<T> in the map
+// helper for checking if the use element with the given name exists,
+// whatever its type, and finding its position
+bool name_check_failed(statement_wrapper & wrapper,
+    char const * name, statement_wrapper::kind k, int & position)
+{
+    typedef std::map<std::string, int>::const_iterator iterator;
+    iterator const it = wrapper.use_positions.find(name);
+    if (it == wrapper.use_positions.end() || wrapper.use_kind != k)
+    {
+        wrapper.is_ok = false;
+        wrapper.error_message = "Invalid name.";
+        return true;
+    }
+
+    position = it->second;
+    wrapper.is_ok = true;
+    return false;
+}
+
+// helper for adding a new use element, returns its position
+int add_use_element(statement_wrapper & wrapper,
+    char const * name, data_type type)
+{
+    int const position = static_cast<int>(wrapper.use_types.size());
+    wrapper.use_positions[name] = position;
+    wrapper.use_names.push_back(name);
+    wrapper.use_types.push_back(type);
+    return position;
+}
+
+// helper for copying the values of a vector into element to the user arrays,
+// returns the number of copied values
 template <typename T>
-void resize_in_map(std::map<std::string, std::vector<T> > & m, int new_size)
+int get_into_array(statement_wrapper & wrapper, std::vector<T> const & v,
+    int position, T * values, int * states, int size)
 {
-    typedef typename std::map<std::string, std::vector<T> >::iterator iterator;
-    iterator it = m.begin();
-    iterator const end = m.end();
-    for ( ; it != end; ++it)
+    if (size < 0)
     {
-        std::vector<T> & v = it->second;
-        v.resize(new_size);
+        wrapper.is_ok = false;
+        wrapper.error_message = "Invalid size.";
+        return -1;
     }
+
+    // the indicators are always resized by the core, but resizing the values
+    // is left to the backend, so don't rely on it having done it
+    std::vector<indicator> const & inds = wrapper.into_indicators_v[position];
+    int const count = std::min(size,
+        static_cast<int>(std::min(v.size(), inds.size())));
+    for (int i = 0; i != count; ++i)
+    {
+        bool const is_null = inds[i] == i_null;
+        values[i] = is_null ? T() : v[i];
+        if (states != NULL)
+        {
+            states[i] = is_null ? 0 : 1;
+        }
+    }
+
+    wrapper.is_ok = true;
+    return count;
+}
+
+// helper for setting all values of a vector use element from the user arrays
+template <typename T>
+void set_use_array(statement_wrapper & wrapper, std::vector<T> & v,
+    int position, T const * values, int const * states, int size)
+{
+    if (size != static_cast<int>(v.size()))
+    {
+        wrapper.is_ok = false;
+        wrapper.error_message = "Invalid size.";
+        return;
+    }
+
+    std::copy(values, values + size, v.begin());
+
+    std::vector<indicator> & inds = wrapper.use_indicators_v[position];
+    for (int i = 0; i != size; ++i)
+    {
+        inds[i] = (states == NULL || states[i] != 0) ? i_ok : i_null;
+    }
+
+    wrapper.is_ok = true;
 }
 
 // helper for formatting date values
@@ -761,7 +700,7 @@ SOCI_DECL int soci_into_string(statement_handle st)
 
     wrapper->into_types.push_back(dt_string);
     wrapper->into_indicators.push_back(i_ok);
-    wrapper->into_strings[wrapper->next_position]; // create new entry
+    wrapper->into_strings.resize(wrapper->next_position + 1);
     return wrapper->next_position++;
 }
 
@@ -779,7 +718,7 @@ SOCI_DECL int soci_into_int(statement_handle st)
 
     wrapper->into_types.push_back(dt_integer);
     wrapper->into_indicators.push_back(i_ok);
-    wrapper->into_ints[wrapper->next_position]; // create new entry
+    wrapper->into_ints.resize(wrapper->next_position + 1);
     return wrapper->next_position++;
 }
 
@@ -797,7 +736,7 @@ SOCI_DECL int soci_into_long_long(statement_handle st)
 
     wrapper->into_types.push_back(dt_long_long);
     wrapper->into_indicators.push_back(i_ok);
-    wrapper->into_longlongs[wrapper->next_position]; // create new entry
+    wrapper->into_longlongs.resize(wrapper->next_position + 1);
     return wrapper->next_position++;
 }
 
@@ -815,7 +754,7 @@ SOCI_DECL int soci_into_double(statement_handle st)
 
     wrapper->into_types.push_back(dt_double);
     wrapper->into_indicators.push_back(i_ok);
-    wrapper->into_doubles[wrapper->next_position]; // create new entry
+    wrapper->into_doubles.resize(wrapper->next_position + 1);
     return wrapper->next_position++;
 }
 
@@ -833,7 +772,7 @@ SOCI_DECL int soci_into_date(statement_handle st)
 
     wrapper->into_types.push_back(dt_date);
     wrapper->into_indicators.push_back(i_ok);
-    wrapper->into_dates[wrapper->next_position]; // create new entry
+    wrapper->into_dates.resize(wrapper->next_position + 1);
     return wrapper->next_position++;
 }
 
@@ -851,7 +790,8 @@ SOCI_DECL int soci_into_blob(statement_handle st)
 
     wrapper->into_types.push_back(dt_blob);
     wrapper->into_indicators.push_back(i_ok);
-    wrapper->into_blob[wrapper->next_position] = soci_create_blob_session(wrapper->sql); // create new entry
+    wrapper->into_blob.resize(wrapper->next_position + 1);
+    wrapper->into_blob[wrapper->next_position] = soci_create_blob_session(wrapper->sql);
     return wrapper->next_position++;
 }
 
@@ -869,7 +809,7 @@ SOCI_DECL int soci_into_string_v(statement_handle st)
 
     wrapper->into_types.push_back(dt_string);
     wrapper->into_indicators_v.push_back(std::vector<indicator>());
-    wrapper->into_strings_v[wrapper->next_position];
+    wrapper->into_strings_v.resize(wrapper->next_position + 1);
     return wrapper->next_position++;
 }
 
@@ -887,7 +827,7 @@ SOCI_DECL int soci_into_int_v(statement_handle st)
 
     wrapper->into_types.push_back(dt_integer);
     wrapper->into_indicators_v.push_back(std::vector<indicator>());
-    wrapper->into_ints_v[wrapper->next_position];
+    wrapper->into_ints_v.resize(wrapper->next_position + 1);
     return wrapper->next_position++;
 }
 
@@ -905,7 +845,7 @@ SOCI_DECL int soci_into_long_long_v(statement_handle st)
 
     wrapper->into_types.push_back(dt_long_long);
     wrapper->into_indicators_v.push_back(std::vector<indicator>());
-    wrapper->into_longlongs_v[wrapper->next_position];
+    wrapper->into_longlongs_v.resize(wrapper->next_position + 1);
     return wrapper->next_position++;
 }
 
@@ -923,7 +863,7 @@ SOCI_DECL int soci_into_double_v(statement_handle st)
 
     wrapper->into_types.push_back(dt_double);
     wrapper->into_indicators_v.push_back(std::vector<indicator>());
-    wrapper->into_doubles_v[wrapper->next_position];
+    wrapper->into_doubles_v.resize(wrapper->next_position + 1);
     return wrapper->next_position++;
 }
 
@@ -941,7 +881,7 @@ SOCI_DECL int soci_into_date_v(statement_handle st)
 
     wrapper->into_types.push_back(dt_date);
     wrapper->into_indicators_v.push_back(std::vector<indicator>());
-    wrapper->into_dates_v[wrapper->next_position];
+    wrapper->into_dates_v.resize(wrapper->next_position + 1);
     return wrapper->next_position++;
 }
 
@@ -1230,12 +1170,57 @@ SOCI_DECL char const * soci_get_into_date_v(statement_handle st, int position, i
     return format_date(*wrapper, v[index]);
 }
 
+SOCI_DECL int soci_get_into_int_array(statement_handle st, int position,
+    int * values, int * states, int size)
+{
+    statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
+
+    if (position_check_failed(*wrapper,
+            statement_wrapper::bulk, position, dt_integer, "int"))
+    {
+        return -1;
+    }
+
+    return get_into_array(*wrapper, wrapper->into_ints_v[position],
+        position, values, states, size);
+}
+
+SOCI_DECL int soci_get_into_long_long_array(statement_handle st, int position,
+    long long * values, int * states, int size)
+{
+    statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
+
+    if (position_check_failed(*wrapper,
+            statement_wrapper::bulk, position, dt_long_long, "long long"))
+    {
+        return -1;
+    }
+
+    return get_into_array(*wrapper, wrapper->into_longlongs_v[position],
+        position, values, states, size);
+}
+
+SOCI_DECL int soci_get_into_double_array(statement_handle st, int position,
+    double * values, int * states, int size)
+{
+    statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
+
+    if (position_check_failed(*wrapper,
+            statement_wrapper::bulk, position, dt_double, "double"))
+    {
+        return -1;
+    }
+
+    return get_into_array(*wrapper, wrapper->into_doubles_v[position],
+        position, values, states, size);
+}
+
 SOCI_DECL void soci_use_string(statement_handle st, char const * name)
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
     if (cannot_add_elements(*wrapper, statement_wrapper::single, false) ||
-        name_unique_check_failed(*wrapper, statement_wrapper::single, name))
+        name_unique_check_failed(*wrapper, name))
     {
         return;
     }
@@ -1243,8 +1228,9 @@ SOCI_DECL void soci_use_string(statement_handle st, char const * name)
     wrapper->statement_state = statement_wrapper::defining;
     wrapper->use_kind = statement_wrapper::single;
 
-    wrapper->use_indicators[name] = i_ok; // create new entry
-    wrapper->use_strings[name]; // create new entry
+    int const position = add_use_element(*wrapper, name, dt_string);
+    wrapper->use_indicators.push_back(i_ok);
+    wrapper->use_strings.resize(position + 1);
 }
 
 SOCI_DECL void soci_use_int(statement_handle st, char const * name)
@@ -1252,7 +1238,7 @@ SOCI_DECL void soci_use_int(statement_handle st, char const * name)
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
     if (cannot_add_elements(*wrapper, statement_wrapper::single, false) ||
-        name_unique_check_failed(*wrapper, statement_wrapper::single, name))
+        name_unique_check_failed(*wrapper, name))
     {
         return;
     }
@@ -1260,8 +1246,9 @@ SOCI_DECL void soci_use_int(statement_handle st, char const * name)
     wrapper->statement_state = statement_wrapper::defining;
     wrapper->use_kind = statement_wrapper::single;
 
-    wrapper->use_indicators[name] = i_ok; // create new entry
-    wrapper->use_ints[name]; // create new entry
+    int const position = add_use_element(*wrapper, name, dt_integer);
+    wrapper->use_indicators.push_back(i_ok);
+    wrapper->use_ints.resize(position + 1);
 }
 
 SOCI_DECL void soci_use_long_long(statement_handle st, char const * name)
@@ -1269,7 +1256,7 @@ SOCI_DECL void soci_use_long_long(statement_handle st, char const * name)
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
     if (cannot_add_elements(*wrapper, statement_wrapper::single, false) ||
-        name_unique_check_failed(*wrapper, statement_wrapper::single, name))
+        name_unique_check_failed(*wrapper, name))
     {
         return;
     }
@@ -1277,8 +1264,9 @@ SOCI_DECL void soci_use_long_long(statement_handle st, char const * name)
     wrapper->statement_state = statement_wrapper::defining;
     wrapper->use_kind = statement_wrapper::single;
 
-    wrapper->use_indicators[name] = i_ok; // create new entry
-    wrapper->use_longlongs[name]; // create new entry
+    int const position = add_use_element(*wrapper, name, dt_long_long);
+    wrapper->use_indicators.push_back(i_ok);
+    wrapper->use_longlongs.resize(position + 1);
 }
 
 SOCI_DECL void soci_use_double(statement_handle st, char const * name)
@@ -1286,7 +1274,7 @@ SOCI_DECL void soci_use_double(statement_handle st, char const * name)
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
     if (cannot_add_elements(*wrapper, statement_wrapper::single, false) ||
-        name_unique_check_failed(*wrapper, statement_wrapper::single, name))
+        name_unique_check_failed(*wrapper, name))
     {
         return;
     }
@@ -1294,8 +1282,9 @@ SOCI_DECL void soci_use_double(statement_handle st, char const * name)
     wrapper->statement_state = statement_wrapper::defining;
     wrapper->use_kind = statement_wrapper::single;
 
-    wrapper->use_indicators[name] = i_ok; // create new entry
-    wrapper->use_doubles[name]; // create new entry
+    int const position = add_use_element(*wrapper, name, dt_double);
+    wrapper->use_indicators.push_back(i_ok);
+    wrapper->use_doubles.resize(position + 1);
 }
 
 SOCI_DECL void soci_use_date(statement_handle st, char const * name)
@@ -1303,7 +1292,7 @@ SOCI_DECL void soci_use_date(statement_handle st, char const * name)
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
     if (cannot_add_elements(*wrapper, statement_wrapper::single, false) ||
-        name_unique_check_failed(*wrapper, statement_wrapper::single, name))
+        name_unique_check_failed(*wrapper, name))
     {
         return;
     }
@@ -1311,8 +1300,9 @@ SOCI_DECL void soci_use_date(statement_handle st, char const * name)
     wrapper->statement_state = statement_wrapper::defining;
     wrapper->use_kind = statement_wrapper::single;
 
-    wrapper->use_indicators[name] = i_ok; // create new entry
-    wrapper->use_dates[name]; // create new entry
+    int const position = add_use_element(*wrapper, name, dt_date);
+    wrapper->use_indicators.push_back(i_ok);
+    wrapper->use_dates.resize(position + 1);
 }
 
 SOCI_DECL void soci_use_blob(statement_handle st, char const * name)
@@ -1320,7 +1310,7 @@ SOCI_DECL void soci_use_blob(statement_handle st, char const * name)
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
     if (cannot_add_elements(*wrapper, statement_wrapper::single, false) ||
-        name_unique_check_failed(*wrapper, statement_wrapper::single, name))
+        name_unique_check_failed(*wrapper, name))
     {
         return;
     }
@@ -1328,8 +1318,10 @@ SOCI_DECL void soci_use_blob(statement_handle st, char const * name)
     wrapper->statement_state = statement_wrapper::defining;
     wrapper->use_kind = statement_wrapper::single;
 
-    wrapper->use_indicators[name] = i_null; // create new entry
-    wrapper->use_blob[name] = soci_create_blob_session(wrapper->sql); // create new entry
+    int const position = add_use_element(*wrapper, name, dt_blob);
+    wrapper->use_indicators.push_back(i_null);
+    wrapper->use_blob.resize(position + 1);
+    wrapper->use_blob[position] = soci_create_blob_session(wrapper->sql);
 }
 
 SOCI_DECL void soci_use_string_v(statement_handle st, char const * name)
@@ -1337,7 +1329,7 @@ SOCI_DECL void soci_use_string_v(statement_handle st, char const * name)
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
     if (cannot_add_elements(*wrapper, statement_wrapper::bulk, false) ||
-        name_unique_check_failed(*wrapper, statement_wrapper::bulk, name))
+        name_unique_check_failed(*wrapper, name))
     {
         return;
     }
@@ -1345,8 +1337,9 @@ SOCI_DECL void soci_use_string_v(statement_handle st, char const * name)
     wrapper->statement_state = statement_wrapper::defining;
     wrapper->use_kind = statement_wrapper::bulk;
 
-    wrapper->use_indicators_v[name]; // create new entry
-    wrapper->use_strings_v[name]; // create new entry
+    int const position = add_use_element(*wrapper, name, dt_string);
+    wrapper->use_indicators_v.push_back(std::vector<indicator>());
+    wrapper->use_strings_v.resize(position + 1);
 }
 
 SOCI_DECL void soci_use_int_v(statement_handle st, char const * name)
@@ -1354,7 +1347,7 @@ SOCI_DECL void soci_use_int_v(statement_handle st, char const * name)
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
     if (cannot_add_elements(*wrapper, statement_wrapper::bulk, false) ||
-        name_unique_check_failed(*wrapper, statement_wrapper::bulk, name))
+        name_unique_check_failed(*wrapper, name))
     {
         return;
     }
@@ -1362,8 +1355,9 @@ SOCI_DECL void soci_use_int_v(statement_handle st, char const * name)
     wrapper->statement_state = statement_wrapper::defining;
     wrapper->use_kind = statement_wrapper::bulk;
 
-    wrapper->use_indicators_v[name]; // create new entry
-    wrapper->use_ints_v[name]; // create new entry
+    int const position = add_use_element(*wrapper, name, dt_integer);
+    wrapper->use_indicators_v.push_back(std::vector<indicator>());
+    wrapper->use_ints_v.resize(position + 1);
 }
 
 SOCI_DECL void soci_use_long_long_v(statement_handle st, char const * name)
@@ -1371,7 +1365,7 @@ SOCI_DECL void soci_use_long_long_v(statement_handle st, char const * name)
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
     if (cannot_add_elements(*wrapper, statement_wrapper::bulk, false) ||
-        name_unique_check_failed(*wrapper, statement_wrapper::bulk, name))
+        name_unique_check_failed(*wrapper, name))
     {
         return;
     }
@@ -1379,8 +1373,9 @@ SOCI_DECL void soci_use_long_long_v(statement_handle st, char const * name)
     wrapper->statement_state = statement_wrapper::defining;
     wrapper->use_kind = statement_wrapper::bulk;
 
-    wrapper->use_indicators_v[name]; // create new entry
-    wrapper->use_longlongs_v[name]; // create new entry
+    int const position = add_use_element(*wrapper, name, dt_long_long);
+    wrapper->use_indicators_v.push_back(std::vector<indicator>());
+    wrapper->use_longlongs_v.resize(position + 1);
 }
 
 SOCI_DECL void soci_use_double_v(statement_handle st, char const * name)
@@ -1388,7 +1383,7 @@ SOCI_DECL void soci_use_double_v(statement_handle st, char const * name)
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
     if (cannot_add_elements(*wrapper, statement_wrapper::bulk, false) ||
-        name_unique_check_failed(*wrapper, statement_wrapper::bulk, name))
+        name_unique_check_failed(*wrapper, name))
     {
         return;
     }
@@ -1396,8 +1391,9 @@ SOCI_DECL void soci_use_double_v(statement_handle st, char const * name)
     wrapper->statement_state = statement_wrapper::defining;
     wrapper->use_kind = statement_wrapper::bulk;
 
-    wrapper->use_indicators_v[name]; // create new entry
-    wrapper->use_doubles_v[name]; // create new entry
+    int const position = add_use_element(*wrapper, name, dt_double);
+    wrapper->use_indicators_v.push_back(std::vector<indicator>());
+    wrapper->use_doubles_v.resize(position + 1);
 }
 
 SOCI_DECL void soci_use_date_v(statement_handle st, char const * name)
@@ -1405,7 +1401,7 @@ SOCI_DECL void soci_use_date_v(statement_handle st, char const * name)
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
     if (cannot_add_elements(*wrapper, statement_wrapper::bulk, false) ||
-        name_unique_check_failed(*wrapper, statement_wrapper::bulk, name))
+        name_unique_check_failed(*wrapper, name))
     {
         return;
     }
@@ -1413,89 +1409,91 @@ SOCI_DECL void soci_use_date_v(statement_handle st, char const * name)
     wrapper->statement_state = statement_wrapper::defining;
     wrapper->use_kind = statement_wrapper::bulk;
 
-    wrapper->use_indicators_v[name]; // create new entry
-    wrapper->use_dates_v[name]; // create new entry
+    int const position = add_use_element(*wrapper, name, dt_date);
+    wrapper->use_indicators_v.push_back(std::vector<indicator>());
+    wrapper->use_dates_v.resize(position + 1);
 }
 
 SOCI_DECL void soci_set_use_state(statement_handle st, char const * name, int state)
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
-    typedef std::map<std::string, indicator>::const_iterator iterator;
-    iterator const it = wrapper->use_indicators.find(name);
-    if (it == wrapper->use_indicators.end())
+    int position;
+    if (name_check_failed(*wrapper, name, statement_wrapper::single, position))
     {
-        wrapper->is_ok = false;
-        wrapper->error_message = "Invalid name.";
         return;
     }
 
-    wrapper->is_ok = true;
-    wrapper->use_indicators[name] = (state != 0 ? i_ok : i_null);
+    wrapper->use_indicators[position] = (state != 0 ? i_ok : i_null);
 }
 
 SOCI_DECL void soci_set_use_string(statement_handle st, char const * name, char const * val)
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
+    int position;
     if (name_exists_check_failed(*wrapper,
-            name, dt_string, statement_wrapper::single, "string"))
+            name, dt_string, statement_wrapper::single, "string", position))
     {
         return;
     }
 
-    wrapper->use_indicators[name] = i_ok;
-    wrapper->use_strings[name] = val;
+    wrapper->use_indicators[position] = i_ok;
+    wrapper->use_strings[position] = val;
 }
 
 SOCI_DECL void soci_set_use_int(statement_handle st, char const * name, int val)
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
+    int position;
     if (name_exists_check_failed(*wrapper,
-            name, dt_integer, statement_wrapper::single, "int"))
+            name, dt_integer, statement_wrapper::single, "int", position))
     {
         return;
     }
 
-    wrapper->use_indicators[name] = i_ok;
-    wrapper->use_ints[name] = val;
+    wrapper->use_indicators[position] = i_ok;
+    wrapper->use_ints[position] = val;
 }
 
 SOCI_DECL void soci_set_use_long_long(statement_handle st, char const * name, long long val)
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
+    int position;
     if (name_exists_check_failed(*wrapper,
-            name, dt_long_long, statement_wrapper::single, "long long"))
+            name, dt_long_long, statement_wrapper::single, "long long", position))
     {
         return;
     }
 
-    wrapper->use_indicators[name] = i_ok;
-    wrapper->use_longlongs[name] = val;
+    wrapper->use_indicators[position] = i_ok;
+    wrapper->use_longlongs[position] = val;
 }
 
 SOCI_DECL void soci_set_use_double(statement_handle st, char const * name, double val)
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
+    int position;
     if (name_exists_check_failed(*wrapper,
-            name, dt_double, statement_wrapper::single, "double"))
+            name, dt_double, statement_wrapper::single, "double", position))
     {
         return;
     }
 
-    wrapper->use_indicators[name] = i_ok;
-    wrapper->use_doubles[name] = val;
+    wrapper->use_indicators[position] = i_ok;
+    wrapper->use_doubles[position] = val;
 }
 
 SOCI_DECL void soci_set_use_date(statement_handle st, char const * name, char const * val)
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
+    int position;
     if (name_exists_check_failed(*wrapper,
-            name, dt_date, statement_wrapper::single, "date"))
+            name, dt_date, statement_wrapper::single, "date", position))
     {
         return;
     }
@@ -1507,22 +1505,23 @@ SOCI_DECL void soci_set_use_date(statement_handle st, char const * name, char co
         return;
     }
 
-    wrapper->use_indicators[name] = i_ok;
-    wrapper->use_dates[name] = dt;
+    wrapper->use_indicators[position] = i_ok;
+    wrapper->use_dates[position] = dt;
 }
 
 SOCI_DECL void soci_set_use_blob(statement_handle st, char const * name, blob_handle b)
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
+    int position;
     if (name_exists_check_failed(*wrapper,
-            name, dt_blob, statement_wrapper::single, "blob"))
+            name, dt_blob, statement_wrapper::single, "blob", position))
     {
         return;
     }
 
-    soci::indicator &ind = wrapper->use_indicators[name];
-    blob_wrapper *&blob = wrapper->use_blob[name];
+    soci::indicator &ind = wrapper->use_indicators[position];
+    blob_wrapper *&blob = wrapper->use_blob[position];
     if (ind == i_null && blob != NULL)
         soci_destroy_blob(blob);
 
@@ -1548,7 +1547,7 @@ SOCI_DECL int soci_use_get_size_v(statement_handle st)
         return -1;
     }
 
-    return static_cast<int>(wrapper->use_indicators_v.begin()->second.size());
+    return static_cast<int>(wrapper->use_indicators_v[0].size());
 }
 
 SOCI_DECL void soci_use_resize_v(statement_handle st, int new_size)
@@ -1569,12 +1568,35 @@ SOCI_DECL void soci_use_resize_v(statement_handle st, int new_size)
         return;
     }
 
-    resize_in_map(wrapper->use_indicators_v, new_size);
-    resize_in_map(wrapper->use_strings_v, new_size);
-    resize_in_map(wrapper->use_ints_v, new_size);
-    resize_in_map(wrapper->use_longlongs_v, new_size);
-    resize_in_map(wrapper->use_doubles_v, new_size);
-    resize_in_map(wrapper->use_dates_v, new_size);
+    int const use_elements = static_cast<int>(wrapper->use_types.size());
+    for (int i = 0; i != use_elements; ++i)
+    {
+        wrapper->use_indicators_v[i].resize(new_size);
+
+        switch (wrapper->use_types[i])
+        {
+        case dt_string:
+            wrapper->use_strings_v[i].resize(new_size);
+            break;
+        case dt_integer:
+            wrapper->use_ints_v[i].resize(new_size);
+            break;
+        case dt_long_long:
+        case dt_unsigned_long_long:
+            wrapper->use_longlongs_v[i].resize(new_size);
+            break;
+        case dt_double:
+            wrapper->use_doubles_v[i].resize(new_size);
+            break;
+        case dt_date:
+            wrapper->use_dates_v[i].resize(new_size);
+            break;
+        case dt_blob:
+        case dt_xml:
+            // no support for bulk blob
+            break;
+        }
+    }
 
     wrapper->is_ok = true;
 }
@@ -1584,16 +1606,13 @@ SOCI_DECL void soci_set_use_state_v(statement_handle st,
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
-    typedef std::map<std::string, std::vector<indicator> >::iterator iterator;
-    iterator const it = wrapper->use_indicators_v.find(name);
-    if (it == wrapper->use_indicators_v.end())
+    int position;
+    if (name_check_failed(*wrapper, name, statement_wrapper::bulk, position))
     {
-        wrapper->is_ok = false;
-        wrapper->error_message = "Invalid name.";
         return;
     }
 
-    std::vector<indicator> & v = it->second;
+    std::vector<indicator> & v = wrapper->use_indicators_v[position];
     if (index_check_failed(v, *wrapper, index))
     {
         return;
@@ -1607,19 +1626,20 @@ SOCI_DECL void soci_set_use_string_v(statement_handle st,
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
+    int position;
     if (name_exists_check_failed(*wrapper,
-            name, dt_string, statement_wrapper::bulk, "vector string"))
+            name, dt_string, statement_wrapper::bulk, "vector string", position))
     {
         return;
     }
 
-    std::vector<std::string> & v = wrapper->use_strings_v[name];
+    std::vector<std::string> & v = wrapper->use_strings_v[position];
     if (index_check_failed(v, *wrapper, index))
     {
         return;
     }
 
-    wrapper->use_indicators_v[name][index] = i_ok;
+    wrapper->use_indicators_v[position][index] = i_ok;
     v[index] = val;
 }
 
@@ -1628,19 +1648,20 @@ SOCI_DECL void soci_set_use_int_v(statement_handle st,
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
+    int position;
     if (name_exists_check_failed(*wrapper,
-            name, dt_integer, statement_wrapper::bulk, "vector int"))
+            name, dt_integer, statement_wrapper::bulk, "vector int", position))
     {
         return;
     }
 
-    std::vector<int> & v = wrapper->use_ints_v[name];
+    std::vector<int> & v = wrapper->use_ints_v[position];
     if (index_check_failed(v, *wrapper, index))
     {
         return;
     }
 
-    wrapper->use_indicators_v[name][index] = i_ok;
+    wrapper->use_indicators_v[position][index] = i_ok;
     v[index] = val;
 }
 
@@ -1649,19 +1670,20 @@ SOCI_DECL void soci_set_use_long_long_v(statement_handle st,
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
+    int position;
     if (name_exists_check_failed(*wrapper,
-            name, dt_long_long, statement_wrapper::bulk, "vector long long"))
+            name, dt_long_long, statement_wrapper::bulk, "vector long long", position))
     {
         return;
     }
 
-    std::vector<long long> & v = wrapper->use_longlongs_v[name];
+    std::vector<long long> & v = wrapper->use_longlongs_v[position];
     if (index_check_failed(v, *wrapper, index))
     {
         return;
     }
 
-    wrapper->use_indicators_v[name][index] = i_ok;
+    wrapper->use_indicators_v[position][index] = i_ok;
     v[index] = val;
 }
 
@@ -1670,19 +1692,20 @@ SOCI_DECL void soci_set_use_double_v(statement_handle st,
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
+    int position;
     if (name_exists_check_failed(*wrapper,
-            name, dt_double, statement_wrapper::bulk, "vector double"))
+            name, dt_double, statement_wrapper::bulk, "vector double", position))
     {
         return;
     }
 
-    std::vector<double> & v = wrapper->use_doubles_v[name];
+    std::vector<double> & v = wrapper->use_doubles_v[position];
     if (index_check_failed(v, *wrapper, index))
     {
         return;
     }
 
-    wrapper->use_indicators_v[name][index] = i_ok;
+    wrapper->use_indicators_v[position][index] = i_ok;
     v[index] = val;
 }
 
@@ -1691,13 +1714,14 @@ SOCI_DECL void soci_set_use_date_v(statement_handle st,
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
+    int position;
     if (name_exists_check_failed(*wrapper,
-            name, dt_date, statement_wrapper::bulk, "vector date"))
+            name, dt_date, statement_wrapper::bulk, "vector date", position))
     {
         return;
     }
 
-    std::vector<std::tm> & v = wrapper->use_dates_v[name];
+    std::vector<std::tm> & v = wrapper->use_dates_v[position];
     if (index_check_failed(v, *wrapper, index))
     {
         return;
@@ -1710,91 +1734,140 @@ SOCI_DECL void soci_set_use_date_v(statement_handle st,
         return;
     }
 
-    wrapper->use_indicators_v[name][index] = i_ok;
+    wrapper->use_indicators_v[position][index] = i_ok;
     v[index] = dt;
 }
 
+SOCI_DECL void soci_set_use_int_array(statement_handle st,
+    char const * name, int const * values, int const * states, int size)
+{
+    statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
+
+    int position;
+    if (name_exists_check_failed(*wrapper,
+            name, dt_integer, statement_wrapper::bulk, "vector int", position))
+    {
+        return;
+    }
+
+    set_use_array(*wrapper, wrapper->use_ints_v[position],
+        position, values, states, size);
+}
+
+SOCI_DECL void soci_set_use_long_long_array(statement_handle st,
+    char const * name, long long const * values, int const * states, int size)
+{
+    statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
+
+    int position;
+    if (name_exists_check_failed(*wrapper,
+            name, dt_long_long, statement_wrapper::bulk, "vector long long", position))
+    {
+        return;
+    }
+
+    set_use_array(*wrapper, wrapper->use_longlongs_v[position],
+        position, values, states, size);
+}
+
+SOCI_DECL void soci_set_use_double_array(statement_handle st,
+    char const * name, double const * values, int const * states, int size)
+{
+    statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
+
+    int position;
+    if (name_exists_check_failed(*wrapper,
+            name, dt_double, statement_wrapper::bulk, "vector double", position))
+    {
+        return;
+    }
+
+    set_use_array(*wrapper, wrapper->use_doubles_v[position],
+        position, values, states, size);
+}
+
 SOCI_DECL int soci_get_use_state(statement_handle st, char const * name)
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
-    typedef std::map<std::string, indicator>::const_iterator iterator;
-    iterator const it = wrapper->use_indicators.find(name);
-    if (it == wrapper->use_indicators.end())
+    int position;
+    if (name_check_failed(*wrapper, name, statement_wrapper::single, position))
     {
-        wrapper->is_ok = false;
-        wrapper->error_message = "Invalid name.";
         return 0;
     }
 
-    wrapper->is_ok = true;
-    return wrapper->use_indicators[name] == i_ok ? 1 : 0;
+    return wrapper->use_indicators[position] == i_ok ? 1 : 0;
 }
 
 SOCI_DECL char const * soci_get_use_string(statement_handle st, char const * name)
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
+    int position;
     if (name_exists_check_failed(*wrapper,
-            name, dt_string, statement_wrapper::bulk, "string"))
+            name, dt_string, statement_wrapper::single, "string", position))
     {
         return "";
     }
 
-    return wrapper->use_strings[name].c_str();
+    return wrapper->use_strings[position].c_str();
 }
 
 SOCI_DECL int soci_get_use_int(statement_handle st, char const * name)
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
+    int position;
     if (name_exists_check_failed(*wrapper,
-            name, dt_integer, statement_wrapper::bulk, "int"))
+            name, dt_integer, statement_wrapper::single, "int", position))
     {
         return 0;
     }
 
-    return wrapper->use_ints[name];
+    return wrapper->use_ints[position];
 }
 
 SOCI_DECL long long soci_get_use_long_long(statement_handle st, char const * name)
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
+    int position;
     if (name_exists_check_failed(*wrapper,
-            name, dt_long_long, statement_wrapper::bulk, "long long"))
+            name, dt_long_long, statement_wrapper::single, "long long", position))
     {
         return 0LL;
     }
 
-    return wrapper->use_longlongs[name];
+    return wrapper->use_longlongs[position];
 }
 
 SOCI_DECL double soci_get_use_double(statement_handle st, char const * name)
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
+    int position;
     if (name_exists_check_failed(*wrapper,
-            name, dt_double, statement_wrapper::bulk, "double"))
+            name, dt_double, statement_wrapper::single, "double", position))
     {
         return 0.0;
     }
 
-    return wrapper->use_doubles[name];
+    return wrapper->use_doubles[position];
 }
 
 SOCI_DECL char const * soci_get_use_date(statement_handle st, char const * name)
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
+    int position;
     if (name_exists_check_failed(*wrapper,
-            name, dt_date, statement_wrapper::bulk, "date"))
+            name, dt_date, statement_wrapper::single, "date", position))
     {
         return "";
     }
 
     // format is: "YYYY MM DD hh mm ss"
-    std::tm const & d = wrapper->use_dates[name];
+    std::tm const & d = wrapper->use_dates[position];
     std::sprintf(wrapper->date_formatted, "%d %d %d %d %d %d",
         d.tm_year + 1900, d.tm_mon + 1, d.tm_mday,
         d.tm_hour, d.tm_min, d.tm_sec);
@@ -1806,13 +1879,14 @@ SOCI_DECL blob_handle soci_get_use_blob(statement_handle st, char const * name)
 {
     statement_wrapper * wrapper = static_cast<statement_wrapper *>(st);
 
+    int position;
     if (name_exists_check_failed(*wrapper,
-            name, dt_blob, statement_wrapper::bulk, "blob"))
+            name, dt_blob, statement_wrapper::single, "blob", position))
     {
         return NULL;
     }
 
-    return wrapper->use_blob[name];
+    return wrapper->use_blob[position];
 }
 
 SOCI_DECL void soci_prepare(statement_handle st, char const * query)
@@ -1900,159 +1974,82 @@ SOCI_DECL void soci_prepare(statement_handle st, char const * query)
         }
 
         // bind all use elements
-        {
-            // strings
-            typedef std::map<std::string, std::string>::iterator iterator;
-            iterator uit = wrapper->use_strings.begin();
-            iterator const uend = wrapper->use_strings.end();
-            for ( ; uit != uend; ++uit)
-            {
-                std::string const & use_name = uit->first;
-                std::string & use_string = uit->second;
-                indicator & use_ind = wrapper->use_indicators[use_name];
-                wrapper->st.exchange(use(use_string, use_ind, use_name));
-            }
-        }
-        {
-            // ints
-            typedef std::map<std::string, int>::iterator iterator;
-            iterator uit = wrapper->use_ints.begin();
-            iterator const uend = wrapper->use_ints.end();
-            for ( ; uit != uend; ++uit)
-            {
-                std::string const & use_name = uit->first;
-                int & use_int = uit->second;
-                indicator & use_ind = wrapper->use_indicators[use_name];
-                wrapper->st.exchange(use(use_int, use_ind, use_name));
-            }
-        }
-        {
-            // longlongs
-            typedef std::map<std::string, long long>::iterator iterator;
-            iterator uit = wrapper->use_longlongs.begin();
-            iterator const uend = wrapper->use_longlongs.end();
-            for ( ; uit != uend; ++uit)
-            {
-                std::string const & use_name = uit->first;
-                long long & use_longlong = uit->second;
-                indicator & use_ind = wrapper->use_indicators[use_name];
-                wrapper->st.exchange(use(use_longlong, use_ind, use_name));
-            }
-        }
-        {
-            // doubles
-            typedef std::map<std::string, double>::iterator iterator;
-            iterator uit = wrapper->use_doubles.begin();
-            iterator const uend = wrapper->use_doubles.end();
-            for ( ; uit != uend; ++uit)
-            {
-                std::string const & use_name = uit->first;
-                double & use_double = uit->second;
-                indicator & use_ind = wrapper->use_indicators[use_name];
-                wrapper->st.exchange(use(use_double, use_ind, use_name));
-            }
-        }
-        {
-            // dates
-            typedef std::map<std::string, std::tm>::iterator iterator;
-            iterator uit = wrapper->use_dates.begin();
-            iterator const uend = wrapper->use_dates.end();
-            for ( ; uit != uend; ++uit)
-            {
-                std::string const & use_name = uit->first;
-                std::tm & use_date = uit->second;
-                indicator & use_ind = wrapper->use_indicators[use_name];
-                wrapper->st.exchange(use(use_date, use_ind, use_name));
-            }
-        }
-        {
-            // blobs
-            typedef std::map<std::string, blob_wrapper *>::iterator iterator;
-            iterator uit = wrapper->use_blob.begin();
-            iterator uend = wrapper->use_blob.end();
-            for ( ; uit != uend; ++uit)
-            {
-                std::string const & use_name = uit->first;
-                blob &use_blob = uit->second->blob_;
-                indicator & use_ind = wrapper->use_indicators[use_name];
-                wrapper->st.exchange(use(use_blob, use_ind, use_name));
-            }
-        }
 
-        // bind all use vecctor elements
+        int const use_elements = static_cast<int>(wrapper->use_types.size());
+        if (wrapper->use_kind == statement_wrapper::single)
         {
-            // strings
-            typedef std::map<std::string,
-                std::vector<std::string> >::iterator iterator;
-            iterator uit = wrapper->use_strings_v.begin();
-            iterator const uend = wrapper->use_strings_v.end();
-            for ( ; uit != uend; ++uit)
+            for (int i = 0; i != use_elements; ++i)
             {
-                std::string const & use_name = uit->first;
-                std::vector<std::string> & use_string = uit->second;
-                std::vector<indicator> & use_ind =
-                    wrapper->use_indicators_v[use_name];
-                wrapper->st.exchange(use(use_string, use_ind, use_name));
-            }
-        }
-        {
-            // ints
-            typedef std::map<std::string,
-                std::vector<int> >::iterator iterator;
-            iterator uit = wrapper->use_ints_v.begin();
-            iterator const uend = wrapper->use_ints_v.end();
-            for ( ; uit != uend; ++uit)
-            {
-                std::string const & use_name = uit->first;
-                std::vector<int> & use_int = uit->second;
-                std::vector<indicator> & use_ind =
-                    wrapper->use_indicators_v[use_name];
-                wrapper->st.exchange(use(use_int, use_ind, use_name));
-            }
-        }
-        {
-            // longlongs
-            typedef std::map<std::string,
-                std::vector<long long> >::iterator iterator;
-            iterator uit = wrapper->use_longlongs_v.begin();
-            iterator const uend = wrapper->use_longlongs_v.end();
-            for ( ; uit != uend; ++uit)
-            {
-                std::string const & use_name = uit->first;
-                std::vector<long long> & use_longlong = uit->second;
-                std::vector<indicator> & use_ind =
-                    wrapper->use_indicators_v[use_name];
-                wrapper->st.exchange(use(use_longlong, use_ind, use_name));
-            }
-        }
-        {
-            // doubles
-            typedef std::map<std::string,
-                std::vector<double> >::iterator iterator;
-            iterator uit = wrapper->use_doubles_v.begin();
-            iterator const uend = wrapper->use_doubles_v.end();
-            for ( ; uit != uend; ++uit)
-            {
-                std::string const & use_name = uit->first;
-                std::vector<double> & use_double = uit->second;
-                std::vector<indicator> & use_ind =
-                    wrapper->use_indicators_v[use_name];
-                wrapper->st.exchange(use(use_double, use_ind, use_name));
+                std::string const & use_name = wrapper->use_names[i];
+                indicator & use_ind = wrapper->use_indicators[i];
+                switch (wrapper->use_types[i])
+                {
+                case dt_string:
+                    wrapper->st.exchange(
+                        use(wrapper->use_strings[i], use_ind, use_name));
+                    break;
+                case dt_integer:
+                    wrapper->st.exchange(
+                        use(wrapper->use_ints[i], use_ind, use_name));
+                    break;
+                case dt_long_long:
+                case dt_unsigned_long_long:
+                    wrapper->st.exchange(
+                        use(wrapper->use_longlongs[i], use_ind, use_name));
+                    break;
+                case dt_double:
+                    wrapper->st.exchange(
+                        use(wrapper->use_doubles[i], use_ind, use_name));
+                    break;
+                case dt_date:
+                    wrapper->st.exchange(
+                        use(wrapper->use_dates[i], use_ind, use_name));
+                    break;
+                case dt_blob:
+                    wrapper->st.exchange(
+                        use(wrapper->use_blob[i]->blob_, use_ind, use_name));
+                    break;
+                case dt_xml:
+                    // no support for xml
+                    break;
+                }
             }
         }
+        else
         {
-            // dates
-            typedef std::map<std::string,
-                std::vector<std::tm> >::iterator iterator;
-            iterator uit = wrapper->use_dates_v.begin();
-            iterator const uend = wrapper->use_dates_v.end();
-            for ( ; uit != uend; ++uit)
+            // vector elements
+            for (int i = 0; i != use_elements; ++i)
             {
-                std::string const & use_name = uit->first;
-                std::vector<std::tm> & use_date = uit->second;
-                std::vector<indicator> & use_ind =
-                    wrapper->use_indicators_v[use_name];
-                wrapper->st.exchange(use(use_date, use_ind, use_name));
+                std::string const & use_name = wrapper->use_names[i];
+                std::vector<indicator> & use_ind = wrapper->use_indicators_v[i];
+                switch (wrapper->use_types[i])
+                {
+                case dt_string:
+                    wrapper->st.exchange(
+                        use(wrapper->use_strings_v[i], use_ind, use_name));
+                    break;
+                case dt_integer:
+                    wrapper->st.exchange(
+                        use(wrapper->use_ints_v[i], use_ind, use_name));
+                    break;
+                case dt_long_long:
+                case dt_unsigned_long_long:
+                    wrapper->st.exchange(
+                        use(wrapper->use_longlongs_v[i], use_ind, use_name));
+                    break;
+                case dt_double:
+                    wrapper->st.exchange(
+                        use(wrapper->use_doubles_v[i], use_ind, use_name));
+                    break;
+                case dt_date:
+                    wrapper->st.exchange(
+                        use(wrapper->use_dates_v[i], use_ind, use_name));
+                    break;
+                case dt_blob:
+                case dt_xml:
+                    // no support for bulk blob and xml
+                    break;
+                }
             }
         }
 
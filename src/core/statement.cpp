@@ -12,8 +12,10 @@
 #include "soci/use-type.h"
 #include "soci/values.h"
 #include "soci-compiler.h"
+#include "soci-timer.h"
 #include <ctime>
 #include <cctype>
+#include <exception>
 
 using namespace soci;
 using namespace soci::details;
@@ -21,15 +23,16 @@ using namespace soci::details;
 
 statement_impl::statement_impl(session & s)
     : session_(s), refCount_(1), row_(0),
-      fetchSize_(1), initialFetchSize_(1),
-      alreadyDescribed_(false)
+      fetchSize_(1), initialFetchSize_(1), rowBatchSize_(1),
+      alreadyDescribed_(false), pipelined_(false)
 {
     backEnd_ = s.make_statement_backend();
 }
 
 statement_impl::statement_impl(prepare_temp_type const & prep)
     : session_(prep.get_prepare_info()->session_),
-      refCount_(1), row_(0), fetchSize_(1), alreadyDescribed_(false)
+      refCount_(1), row_(0), fetchSize_(1), rowBatchSize_(1),
+      alreadyDescribed_(false), pipelined_(false)
 {
     backEnd_ = session_.make_statement_backend();
 
@@ -151,13 +154,7 @@ void statement_impl::bind_clean_up()
         intos_.resize(i - 1);
     }
 
-    std::size_t const ifrsize = intosForRow_.size();
-    for (std::size_t i = ifrsize; i != 0; --i)
-    {
-        intosForRow_[i - 1]->clean_up();
-        delete intosForRow_[i - 1];
-        intosForRow_.resize(i - 1);
-    }
+    clean_up_row_intos();
 
     std::size_t const usize = uses_.size();
     for (std::size_t i = usize; i != 0; --i)
@@ -178,6 +175,24 @@ void statement_impl::bind_clean_up()
     alreadyDescribed_ = false;
 }
 
+void statement_impl::clean_up_row_intos()
+{
+    std::size_t const ifrsize = intosForRow_.size();
+    for (std::size_t i = ifrsize; i != 0; --i)
+    {
+        intosForRow_[i - 1]->clean_up();
+        delete intosForRow_[i - 1];
+        intosForRow_.resize(i - 1);
+    }
+
+    std::size_t const rbsize = rowBatch_.size();
+    for (std::size_t i = 0; i != rbsize; ++i)
+    {
+        delete rowBatch_[i];
+    }
+    rowBatch_.clear();
+}
+
 void statement_impl::clean_up()
 {
     bind_clean_up();
@@ -192,17 +207,57 @@ void statement_impl::clean_up()
 void statement_impl::prepare(std::string const & query,
     statement_type eType)
 {
+    // only measure the time if the logger is interested in it
+    bool const timed = session_.wants_query_phases();
+    long long const start = timed ? get_monotonic_microseconds() : 0;
+
     try
     {
         query_ = query;
         session_.log_query(query);
 
+        backEnd_->clear_described_columns();
         backEnd_->prepare(query, eType);
     }
     catch (...)
     {
+        if (timed)
+        {
+            end_query_phase_with_error(qp_prepare, start);
+        }
+
         rethrow_current_exception_with_context("preparing");
     }
+
+    // outside of the try block, as an exception thrown by the logger itself
+    // must not be reported as a failure of the statement
+    if (timed)
+    {
+        end_query_phase(qp_prepare, start, -1);
+    }
+}
+
+void statement_impl::use_prepared_backend(statement_backend * backEnd,
+    std::string const & query)
+{
+    // the backend created by the ctor was never allocated
+    delete backEnd_;
+    backEnd_ = backEnd;
+
+    query_ = query;
+    session_.log_query(query);
+}
+
+statement_backend * statement_impl::release_prepared_backend()
+{
+    bind_clean_up();
+
+    backEnd_->reset_for_reuse();
+
+    statement_backend * const backEnd = backEnd_;
+    backEnd_ = NULL;
+
+    return backEnd;
 }
 
 void statement_impl::define_and_bind()
@@ -230,10 +285,12 @@ void statement_impl::define_and_bind()
 
 void statement_impl::define_for_row()
 {
+    // the row columns may be defined again if they're described anew
+    int definePosition = definePositionForRow_;
     std::size_t const isize = intosForRow_.size();
     for (std::size_t i = 0; i != isize; ++i)
     {
-        intosForRow_[i]->define(*this, definePositionForRow_);
+        intosForRow_[i]->define(*this, definePosition);
     }
 }
 
@@ -260,6 +317,12 @@ void statement_impl::undefine_and_bind()
 
 bool statement_impl::execute(bool withDataExchange)
 {
+    bool const timed = session_.wants_query_phases();
+    long long const start = timed ? get_monotonic_microseconds() : 0;
+
+    bool gotData = false;
+    long long rows = -1;
+
     try
     {
         initialFetchSize_ = intos_size();
@@ -291,12 +354,24 @@ bool statement_impl::execute(bool withDataExchange)
         // and *before* the into elements are touched, so that the row
         // description process can inject more into elements for
         // implicit data exchange
-        if (row_ != NULL && alreadyDescribed_ == false)
+        if (row_ != NULL && describe_row())
         {
-            describe();
             define_for_row();
         }
 
+        if (rowBatch_.empty() == false)
+        {
+            // the last batch fetched by the previous execution could have
+            // been partial, restore the full size of the row columns
+            std::size_t const ifrsize = intosForRow_.size();
+            for (std::size_t i = 0; i != ifrsize; ++i)
+            {
+                intosForRow_[i]->resize(rowBatchSize_);
+            }
+
+            initialFetchSize_ = fetchSize_ = rowBatchSize_;
+        }
+
         int num = 0;
         if (withDataExchange)
         {
@@ -316,10 +391,9 @@ bool statement_impl::execute(bool withDataExchange)
         
         pre_exec(num);
 
+        backEnd_->set_pipelined(pipelined_);
         statement_backend::exec_fetch_result res = backEnd_->execute(num);
 
-        bool gotData = false;
-
         if (res == statement_backend::ef_success)
         {
             // the "success" means that the statement executed correctly
@@ -350,12 +424,31 @@ bool statement_impl::execute(bool withDataExchange)
         post_use(gotData);
 
         session_.set_got_data(gotData);
-        return gotData;
+
+        if (timed)
+        {
+            rows = get_rows_for_query_phase(gotData, num > 0);
+        }
     }
     catch (...)
     {
+        if (timed)
+        {
+            end_query_phase_with_error(qp_execute, start);
+        }
+
+        // the result columns may have changed, describe them again next time
+        backEnd_->clear_described_columns();
+
         rethrow_current_exception_with_context("executing");
     }
+
+    if (timed)
+    {
+        end_query_phase(qp_execute, start, rows);
+    }
+
+    return gotData;
 }
 
 long long statement_impl::get_affected_rows()
@@ -372,6 +465,12 @@ long long statement_impl::get_affected_rows()
 
 bool statement_impl::fetch()
 {
+    bool const timed = session_.wants_query_phases();
+    long long const start = timed ? get_monotonic_microseconds() : 0;
+
+    bool gotData = false;
+    long long rows = -1;
+
     try
     {
         if (fetchSize_ == 0)
@@ -381,8 +480,6 @@ bool statement_impl::fetch()
             return false;
         }
 
-        bool gotData = false;
-
         // vectors might have been resized between fetches
         std::size_t const newFetchSize = intos_size();
         if (newFetchSize > initialFetchSize_)
@@ -434,19 +531,95 @@ bool statement_impl::fetch()
 
         post_fetch(gotData, true);
         session_.set_got_data(gotData);
-        return gotData;
+
+        if (timed)
+        {
+            rows = get_rows_for_query_phase(gotData, true);
+        }
     }
     catch (...)
     {
+        if (timed)
+        {
+            end_query_phase_with_error(qp_fetch, start);
+        }
+
         rethrow_current_exception_with_context("fetching data from");
     }
+
+    if (timed)
+    {
+        end_query_phase(qp_fetch, start, rows);
+    }
+
+    return gotData;
+}
+
+void statement_impl::end_query_phase(query_phase phase, long long start,
+    long long rows)
+{
+    query_phase_info info;
+    info.phase_ = phase;
+    info.duration_ = get_monotonic_microseconds() - start;
+    info.rows_ = rows;
+
+    session_.log_query_phase(query_, info);
+}
+
+void statement_impl::end_query_phase_with_error(query_phase phase,
+    long long start)
+{
+    query_phase_info info;
+    info.phase_ = phase;
+    info.duration_ = get_monotonic_microseconds() - start;
+    info.failed_ = true;
+
+    try
+    {
+        throw;
+    }
+    catch (std::exception const & e)
+    {
+        info.error_ = e.what();
+    }
+    catch (...)
+    {
+        info.error_ = "unknown error";
+    }
+
+    session_.log_query_phase(query_, info);
+}
+
+long long statement_impl::get_rows_for_query_phase(bool gotData, bool fetched)
+{
+    if (intos_.empty() == false)
+    {
+        return fetched && gotData ? static_cast<long long>(intos_size()) : 0;
+    }
+
+    // not all backends can return the number of affected rows for all
+    // statements, but this is not worth failing the statement for
+    try
+    {
+        return backEnd_->get_affected_rows();
+    }
+    catch (...)
+    {
+        return -1;
+    }
 }
 
 std::size_t statement_impl::intos_size()
 {
     // this function does not need to take into account intosForRow_ elements,
     // since their sizes are always 1 (which is the same and the primary
-    // into(row) element, which has injected them)
+    // into(row) element, which has injected them), unless the row columns
+    // are fetched in batches
+
+    if (rowBatch_.empty() == false)
+    {
+        return intosForRow_[0]->size();
+    }
 
     std::size_t intos_size = 0;
     std::size_t const isize = intos_.size();
@@ -502,7 +675,8 @@ std::size_t statement_impl::uses_size()
 bool statement_impl::resize_intos(std::size_t upperBound)
 {
     // this function does not need to take into account the intosForRow_
-    // elements, since they are never used for bulk operations
+    // elements, since they are never used for bulk operations, unless the
+    // row columns are fetched in batches
 
     int rows = backEnd_->get_number_of_rows();
     if (rows < 0)
@@ -520,6 +694,15 @@ bool statement_impl::resize_intos(std::size_t upperBound)
         intos_[i]->resize((std::size_t)rows);
     }
 
+    if (rowBatch_.empty() == false)
+    {
+        std::size_t const ifrsize = intosForRow_.size();
+        for (std::size_t i = 0; i != ifrsize; ++i)
+        {
+            intosForRow_[i]->resize((std::size_t)rows);
+        }
+    }
+
     return rows > 0 ? true : false;
 }
 
@@ -530,6 +713,15 @@ void statement_impl::truncate_intos()
     {
         intos_[i]->resize(0);
     }
+
+    if (rowBatch_.empty() == false)
+    {
+        std::size_t const ifrsize = intosForRow_.size();
+        for (std::size_t i = 0; i != ifrsize; ++i)
+        {
+            intosForRow_[i]->resize(0);
+        }
+    }
 }
 
 void statement_impl::pre_exec(int num)
@@ -628,76 +820,122 @@ namespace details
 // Map data_types to stock types for dynamic result set support
 
 template<>
-void statement_impl::bind_into<dt_string>()
+void statement_impl::bind_into<dt_string>(std::size_t pos, bool reuseHolder)
 {
-    into_row<std::string>();
+    into_row<std::string>(pos, reuseHolder);
 }
 
 template<>
-void statement_impl::bind_into<dt_double>()
+void statement_impl::bind_into<dt_double>(std::size_t pos, bool reuseHolder)
 {
-    into_row<double>();
+    into_row<double>(pos, reuseHolder);
 }
 
 template<>
-void statement_impl::bind_into<dt_integer>()
+void statement_impl::bind_into<dt_integer>(std::size_t pos, bool reuseHolder)
 {
-    into_row<int>();
+    into_row<int>(pos, reuseHolder);
 }
 
 template<>
-void statement_impl::bind_into<dt_long_long>()
+void statement_impl::bind_into<dt_long_long>(std::size_t pos, bool reuseHolder)
 {
-    into_row<long long>();
+    into_row<long long>(pos, reuseHolder);
 }
 
 template<>
-void statement_impl::bind_into<dt_unsigned_long_long>()
+void statement_impl::bind_into<dt_unsigned_long_long>(std::size_t pos, bool reuseHolder)
 {
-    into_row<unsigned long long>();
+    into_row<unsigned long long>(pos, reuseHolder);
 }
 
 template<>
-void statement_impl::bind_into<dt_date>()
+void statement_impl::bind_into<dt_date>(std::size_t pos, bool reuseHolder)
 {
-    into_row<std::tm>();
+    into_row<std::tm>(pos, reuseHolder);
 }
 
 void statement_impl::describe()
 {
-    row_->clean_up();
+    describe_row();
+}
+
+bool statement_impl::describe_row()
+{
+    // the description is only forgotten if executing the statement failed,
+    // as its columns could have changed
+    if (alreadyDescribed_ && backEnd_->get_described_columns().empty() == false)
+    {
+        return false;
+    }
 
-    int const numcols = backEnd_->prepare_for_describe();
-    for (int i = 1; i <= numcols; ++i)
+    // describing the columns may be expensive (and even involve executing
+    // the statement for some backends), so do it only once per prepared query
+    // if the backend guarantees that they can't change
+    if (backEnd_->get_described_columns().empty() ||
+        backEnd_->can_reuse_described_columns() == false)
     {
-        data_type dtype;
-        std::string columnName;
+        std::vector<column_description> described;
 
-        backEnd_->describe_column(i, dtype, columnName);
+        int const numcols = backEnd_->prepare_for_describe();
+        described.resize(numcols);
+        for (int i = 1; i <= numcols; ++i)
+        {
+            column_description & cd = described[i - 1];
+            backEnd_->describe_column(i, cd.dataType_, cd.name_);
+        }
 
-        column_properties props;
-        props.set_name(columnName);
-        props.set_data_type(dtype);
+        backEnd_->set_described_columns(described);
+    }
+
+    std::vector<column_description> const & columns
+        = backEnd_->get_described_columns();
+
+    // If the row already has the same columns, because the statement is
+    // executed again after describing it anew or because the row was used
+    // with another statement before, keep its values and the into elements
+    // bound to them, if any, instead of creating them again.
+    bool const reuseHolders = row_->has_columns(columns);
+    if (reuseHolders && intosForRow_.empty() == false)
+    {
+        alreadyDescribed_ = true;
+        return false;
+    }
+
+    clean_up_row_intos();
+
+    std::size_t const numcols = columns.size();
+    if (reuseHolders == false)
+    {
+        row_->clean_up();
+
+        // the into elements refer to the row storage which must not move
+        row_->reserve(numcols);
+    }
+
+    for (std::size_t i = 0; i != numcols; ++i)
+    {
+        data_type const dtype = columns[i].dataType_;
 
         switch (dtype)
         {
         case dt_string:
-            bind_into<dt_string>();
+            bind_into<dt_string>(i, reuseHolders);
             break;
         case dt_double:
-            bind_into<dt_double>();
+            bind_into<dt_double>(i, reuseHolders);
             break;
         case dt_integer:
-            bind_into<dt_integer>();
+            bind_into<dt_integer>(i, reuseHolders);
             break;
         case dt_long_long:
-            bind_into<dt_long_long>();
+            bind_into<dt_long_long>(i, reuseHolders);
             break;
         case dt_unsigned_long_long:
-            bind_into<dt_unsigned_long_long>();
+            bind_into<dt_unsigned_long_long>(i, reuseHolders);
             break;
         case dt_date:
-            bind_into<dt_date>();
+            bind_into<dt_date>(i, reuseHolders);
             break;
         default:
             std::ostringstream msg;
@@ -705,10 +943,19 @@ void statement_impl::describe()
                 <<" not supported for dynamic selects"<<std::endl;
             throw soci_error(msg.str());
         }
-        row_->add_properties(props);
+
+        if (reuseHolders == false)
+        {
+            column_properties props;
+            props.set_name(columns[i].name_);
+            props.set_data_type(dtype);
+            row_->add_properties(props);
+        }
     }
 
     alreadyDescribed_ = true;
+
+    return true;
 }
 
 } // namespace details
@@ -726,6 +973,28 @@ void statement_impl::set_row(row * r)
     row_->uppercase_column_names(session_.get_uppercase_column_names());
 }
 
+std::size_t statement_impl::get_row_batch_count()
+{
+    if (rowBatch_.empty())
+    {
+        // either not fetching in batches or there are no columns at all
+        return 1;
+    }
+
+    return intosForRow_[0]->size();
+}
+
+void statement_impl::load_row_from_batch(std::size_t pos)
+{
+    std::size_t const rbsize = rowBatch_.size();
+    for (std::size_t i = 0; i != rbsize; ++i)
+    {
+        rowBatch_[i]->load(pos);
+    }
+
+    row_->reset_get_counter();
+}
+
 std::string statement_impl::rewrite_for_procedure_call(std::string const & query)
 {
     return backEnd_->rewrite_for_procedure_call(query);
@@ -39,6 +39,7 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <stdexcept>
 #include <string>
 #include <typeinfo>
 
@@ -123,6 +124,12 @@ private:
     int i_;
 };
 
+// user-defined type whose conversion moves the base value into it
+struct MyText
+{
+    std::string text;
+};
+
 namespace soci
 {
 
@@ -146,6 +153,41 @@ template<> struct type_conversion<MyInt>
     }
 };
 
+// type conversion taking the value out of the base value when possible
+template<> struct type_conversion<MyText>
+{
+    typedef std::string base_type;
+
+    // count the calls to check that move_from_base() is used when fetching
+    static int& copies() { static int n = 0; return n; }
+    static int& moves() { static int n = 0; return n; }
+
+    static void from_base(std::string const &s, indicator ind, MyText &mt)
+    {
+        ++copies();
+        mt.text = ind == i_ok ? s : std::string();
+    }
+
+    static void move_from_base(std::string &s, indicator ind, MyText &mt)
+    {
+        ++moves();
+        if (ind == i_ok)
+        {
+            mt.text.swap(s);
+        }
+        else
+        {
+            mt.text.clear();
+        }
+    }
+
+    static void to_base(MyText const &mt, std::string &s, indicator &ind)
+    {
+        s = mt.text;
+        ind = i_ok;
+    }
+};
+
 // basic type conversion on many values (ORM)
 template<> struct type_conversion<PhonebookEntry>
 {
@@ -2237,6 +2279,118 @@ TEST_CASE_METHOD(common_tests, "Dynamic row binding 3", "[core][dynamic]")
     CHECK(count == 3);
 }
 
+TEST_CASE_METHOD(common_tests, "Dynamic row with many columns", "[core][dynamic]")
+{
+    soci::session sql(backEndFactory_, connectString_);
+
+    sql.uppercase_column_names(true);
+
+    // enough columns to grow the row index a few times
+    int const numColumns = 40;
+
+    std::ostringstream query;
+    query << "select ";
+    for (int i = 0; i != numColumns; ++i)
+    {
+        if (i != 0)
+        {
+            query << ", ";
+        }
+        query << i << " as c" << i << ", 'v" << i << "' as s" << i;
+    }
+    query << sql.get_dummy_from_clause();
+
+    row r;
+    sql << query.str(), into(r);
+
+    REQUIRE(r.size() == 2 * numColumns);
+    for (int i = 0; i != numColumns; ++i)
+    {
+        std::ostringstream c;
+        c << "C" << i;
+        std::ostringstream s;
+        s << "S" << i;
+        std::ostringstream v;
+        v << "v" << i;
+
+        // the type of the numeric columns depends on the backend
+        CHECK(r.get_properties(c.str()).get_name() == c.str());
+
+        CHECK(r.get<std::string>(s.str()) == v.str());
+        CHECK(r.get<std::string>(2 * i + 1) == v.str());
+        CHECK(r.get_indicator(s.str()) == i_ok);
+    }
+
+    CHECK_THROWS_AS(r.get<std::string>("C40"), soci_error&);
+    CHECK_THROWS_AS(r.get<int>("S0"), std::bad_cast&);
+}
+
+TEST_CASE_METHOD(common_tests, "Dynamic row description reuse", "[core][dynamic]")
+{
+    soci::session sql(backEndFactory_, connectString_);
+
+    sql.uppercase_column_names(true);
+
+    auto_table_creator tableCreator(tc_.table_creator_1(sql));
+
+    for (int i = 1; i <= 3; ++i)
+    {
+        std::ostringstream os;
+        os << "str" << i;
+        std::string const str = os.str();
+        sql << "insert into soci_test(id, str) values(:id, :str)",
+            use(i), use(str);
+    }
+
+    int id = 0;
+    statement st(sql);
+    st.alloc();
+    st.prepare("select id, str from soci_test where id = :id");
+
+    for (id = 1; id <= 3; ++id)
+    {
+        // use a new row every time, its columns must still be correct
+        row r2;
+        st.exchange(into(r2));
+        st.exchange(use(id));
+        st.define_and_bind();
+
+        REQUIRE(st.execute(true));
+        REQUIRE(r2.size() == 2);
+        CHECK(r2.get_properties(0).get_name() == "ID");
+        CHECK(r2.get_properties(1).get_data_type() == dt_string);
+        CHECK(r2.get<std::string>("STR") == (id == 1 ? "str1" : id == 2 ? "str2" : "str3"));
+
+        st.bind_clean_up();
+    }
+
+    // the same must work for the one-time queries reusing cached statements
+    sql.set_statement_cache_size(4);
+    for (id = 1; id <= 3; ++id)
+    {
+        row r3;
+        sql << "select id, str from soci_test where id = :id", use(id), into(r3);
+        REQUIRE(r3.size() == 2);
+        CHECK(r3.get_properties(1).get_name() == "STR");
+        CHECK(r3.get_indicator("STR") == i_ok);
+    }
+
+    // the same row can be reused for queries with the same columns and then
+    // with different ones
+    row r4;
+    for (id = 1; id <= 3; ++id)
+    {
+        sql << "select id, str from soci_test where id = :id", use(id), into(r4);
+        REQUIRE(r4.size() == 2);
+        CHECK(r4.get<std::string>("STR") == (id == 1 ? "str1" : id == 2 ? "str2" : "str3"));
+    }
+
+    sql << "select str from soci_test where id = 2", into(r4);
+    REQUIRE(r4.size() == 1);
+    CHECK(r4.get_properties(0).get_name() == "STR");
+    CHECK(r4.get<std::string>(0) == "str2");
+}
+
 // This is like the previous test but with a type_conversion instead of a row
 TEST_CASE_METHOD(common_tests, "Dynamic binding with type conversions", "[core][dynamic][type_conversion]")
 {
@@ -2276,6 +2430,47 @@ TEST_CASE_METHOD(common_tests, "Dynamic binding with type conversions", "[core][
             sql << "select id from soci_test", into(i);
             CHECK(i == 123);
         }
+
+        SECTION("moving base values into user type")
+        {
+            std::vector<MyText> in(3);
+            in[0].text = "one";
+            in[1].text = "two";
+            in[2].text = "three";
+            sql << "insert into soci_test(str) values(:str)", use(in);
+
+            // the values being used are not modified
+            CHECK(in[2].text == "three");
+
+            type_conversion<MyText>::copies() = 0;
+            type_conversion<MyText>::moves() = 0;
+
+            std::vector<MyText> out(2);
+            std::vector<std::string> texts;
+            statement st = (sql.prepare <<
+                "select str from soci_test order by str", into(out));
+            st.execute();
+            while (st.fetch())
+            {
+                for (std::size_t n = 0; n != out.size(); ++n)
+                {
+                    texts.push_back(out[n].text);
+                }
+            }
+
+            REQUIRE(texts.size() == 3);
+            CHECK(texts[0] == "one");
+            CHECK(texts[1] == "three");
+            CHECK(texts[2] == "two");
+
+            CHECK(type_conversion<MyText>::copies() == 0);
+            CHECK(type_conversion<MyText>::moves() == 3);
+
+            MyText single;
+            sql << "select str from soci_test where str = 'two'", into(single);
+            CHECK(single.text == "two");
+            CHECK(type_conversion<MyText>::copies() == 0);
+        }
     }
 
     SECTION("ORM conversions")
@@ -2482,6 +2677,82 @@ TEST_CASE_METHOD(common_tests, "Bulk fetch with single use", "[core][bulk]")
     CHECK(names[2] == "julian");
 }
 
+// test for reusing the statements prepared by one-time queries
+TEST_CASE_METHOD(common_tests, "Statement cache", "[core][statement-cache]")
+{
+    soci::session sql(backEndFactory_, connectString_);
+
+    auto_table_creator tableCreator(tc_.table_creator_1(sql));
+
+    CHECK(sql.get_statement_cache_size() == 0);
+    sql.set_statement_cache_size(2);
+    CHECK(sql.get_statement_cache_size() == 2);
+
+    for (int i = 1; i <= 5; ++i)
+    {
+        std::string const str = i % 2 ? "odd" : "even";
+        sql << "insert into soci_test(id, str) values(:id, :str)",
+            use(i), use(str);
+    }
+
+    std::string odd("odd");
+    std::string even("even");
+    std::string const query("select id from soci_test where str = :str order by id");
+
+    // The same query with different elements bound to it every time.
+    int id = 0;
+    sql << query, use(odd), into(id);
+    CHECK(id == 1);
+    CHECK(sql.get_last_query() == query);
+
+    sql << query, use(even), into(id);
+    CHECK(id == 2);
+
+    std::vector<int> ids(10);
+    sql << query, use(odd), into(ids);
+    REQUIRE(ids.size() == 3);
+    CHECK(ids[2] == 5);
+
+    row r;
+    sql << query, use(even), into(r);
+    REQUIRE(r.size() == 1);
+    CHECK(r.get<int>(0) == 2);
+
+    // Binding by name must work after binding by position and vice versa.
+    sql << query, use(odd, "str"), into(id);
+    CHECK(id == 1);
+
+    sql << query, use(even), into(id);
+    CHECK(id == 2);
+
+    // Evict the query from the cache and check it still works.
+    int count = 0;
+    sql << "select count(*) from soci_test", into(count);
+    CHECK(count == 5);
+    sql << "select count(*) from soci_test where id > :id", use(id), into(count);
+    CHECK(count == 3);
+
+    sql << query, use(even), into(id);
+    CHECK(id == 2);
+
+    // A failed statement mustn't break the following ones.
+    CHECK_THROWS_AS((sql << "insert into soci_test(id, str) values(:id, :str)",
+        use(id), use(odd), use(even)), soci_error&);
+
+    sql << "insert into soci_test(id, str) values(:id, :str)",
+        use(count), use(odd);
+    sql << "select count(*) from soci_test where str = :str",
+        use(odd), into(count);
+    CHECK(count == 4);
+
+    sql.set_statement_cache_size(0);
+    CHECK(sql.get_statement_cache_size() == 0);
+
+    ids.resize(10);
+    sql << query, use(odd), into(ids);
+    CHECK(ids.size() == 4);
+}
+
 // test for basic logging support
 TEST_CASE_METHOD(common_tests, "Basic logging support", "[core][logging]")
 {
@@ -2523,6 +2794,35 @@ TEST_CASE_METHOD(common_tests, "Basic logging support", "[core][logging]")
 
 }
 
+// test for composing the query text from fragments of different types
+TEST_CASE_METHOD(common_tests, "Query text composition", "[core][query]")
+{
+    soci::session sql(backEndFactory_, connectString_);
+
+    auto_table_creator tableCreator(tc_.table_creator_1(sql));
+
+    std::string const table("soci_test");
+    char const* const column = "id";
+    sql << "insert into " << table << "(" << column << ") values(" << 17 << ')';
+    CHECK(sql.get_last_query() == "insert into soci_test(id) values(17)");
+
+    int id = 0;
+    sql << "select " << column << " from " << table, into(id);
+    CHECK(id == 17);
+    CHECK(sql.get_last_query() == "select id from soci_test");
+
+    // numbers are formatted directly into the query, as in the "C" locale
+    sql << "select count(*) from soci_test where id = " << 17L
+        << " or id = " << -9223372036854775807LL - 1
+        << " or id = " << 18446744073709551615ULL
+        << " or id = " << static_cast<short>(-3) << " or id = " << 0U
+        << " or id = " << 2.5, into(id);
+    CHECK(id == 1);
+    CHECK(sql.get_last_query() == "select count(*) from soci_test where id = 17"
+        " or id = -9223372036854775808 or id = 18446744073709551615"
+        " or id = -3 or id = 0 or id = 2.5");
+}
+
 // test for rowset creation and copying
 TEST_CASE_METHOD(common_tests, "Rowset creation and copying", "[core][rowset]")
 {
@@ -2836,6 +3136,96 @@ TEST_CASE_METHOD(common_tests, "Reading strings from rowset", "[core][rowset]")
 
 }
 
+// test for reading rowset using iterator with rows fetched in batches
+TEST_CASE_METHOD(common_tests, "Reading rowset with prefetch", "[core][rowset]")
+{
+    soci::session sql(backEndFactory_, connectString_);
+
+    auto_table_creator tableCreator(tc_.table_creator_1(sql));
+    for (int i = 1; i <= 10; ++i)
+    {
+        std::ostringstream oss;
+        oss << "str" << i;
+        std::string const str = oss.str();
+        sql << "insert into soci_test(id, str) values(:id, :str)",
+            use(i), use(str);
+    }
+
+    SECTION("Explicit prefetch size")
+    {
+        // 10 rows in batches of 4, so the last batch is partial
+        rowset<int> rs(sql.prepare
+            << "select id from soci_test order by id asc", 4);
+
+        int expected = 1;
+        for (rowset<int>::const_iterator it = rs.begin(); it != rs.end(); ++it)
+        {
+            CHECK(*it == expected);
+            ++expected;
+        }
+        CHECK(expected == 11);
+    }
+
+    SECTION("Session prefetch size")
+    {
+        sql.set_rowset_prefetch_size(5);
+        CHECK(sql.get_rowset_prefetch_size() == 5);
+
+        rowset<std::string> rs = (sql.prepare
+            << "select str from soci_test where id > 3 order by id asc");
+
+        std::vector<std::string> strs(rs.begin(), rs.end());
+        REQUIRE(strs.size() == 7);
+        CHECK(strs.front() == "str4");
+        CHECK(strs.back() == "str10");
+    }
+
+    SECTION("Null value")
+    {
+        sql << "update soci_test set str = null where id = 7";
+
+        rowset<std::string> rs(sql.prepare
+            << "select str from soci_test order by id asc", 3);
+
+        rowset<std::string>::const_iterator it = rs.begin();
+        std::advance(it, 5);
+        CHECK(*it == "str6");
+        CHECK_THROWS_AS(++it, soci_error&);
+    }
+
+    SECTION("Dynamic rows")
+    {
+        sql << "update soci_test set str = null where id = 7";
+
+        // 10 rows in batches of 4, so the last batch is partial
+        rowset<row> rs(sql.prepare
+            << "select str from soci_test order by id asc", 4);
+
+        int n = 0;
+        for (rowset<row>::const_iterator it = rs.begin(); it != rs.end(); ++it)
+        {
+            ++n;
+
+            row const& r = *it;
+            REQUIRE(r.size() == 1);
+            CHECK(r.get_properties(0).get_data_type() == dt_string);
+
+            if (n == 7)
+            {
+                CHECK(r.get_indicator(0) == i_null);
+            }
+            else
+            {
+                std::ostringstream oss;
+                oss << "str" << n;
+                CHECK(r.get_indicator(0) == i_ok);
+                CHECK(r.get<std::string>(0) == oss.str());
+            }
+        }
+        CHECK(n == 10);
+    }
+}
+
 // test for handling troublemaker
 TEST_CASE_METHOD(common_tests, "Rowset expected exception", "[core][exception][rowset]")
 {
@@ -4460,6 +4850,155 @@ TEST_CASE_METHOD(common_tests, "Logger", "[core][log]")
     sql.set_logger(logger_orig);
 }
 
+TEST_CASE_METHOD(common_tests, "Logger query phases", "[core][log]")
+{
+    // Logger class used for testing: remembers all query phases.
+    class test_log_impl : public soci::logger_impl
+    {
+    public:
+        explicit test_log_impl(std::vector<query_phase_info>& phases,
+                               bool throwOnExecute = false)
+            : m_phases(phases), m_throwOnExecute(throwOnExecute)
+        {
+        }
+
+        virtual void start_query(std::string const &)
+        {
+        }
+
+        virtual bool wants_query_phases() const
+        {
+            return true;
+        }
+
+        virtual void end_query_phase(std::string const &,
+            query_phase_info const & info)
+        {
+            m_phases.push_back(info);
+
+            if (m_throwOnExecute && info.phase_ == qp_execute && !info.failed_)
+            {
+                throw std::runtime_error("logger failure");
+            }
+        }
+
+    private:
+        virtual logger_impl* do_clone() const
+        {
+            return new test_log_impl(m_phases, m_throwOnExecute);
+        }
+
+        std::vector<query_phase_info>& m_phases;
+        bool const m_throwOnExecute;
+    };
+
+    // This vector must outlive the session as the table is dropped, and so
+    // logged, when the latter is destroyed.
+    std::vector<query_phase_info> phases;
+
+    soci::session sql(backEndFactory_, connectString_);
+    auto_table_creator tableCreator(tc_.table_creator_1(sql));
+
+    sql.set_logger(new test_log_impl(phases));
+
+    std::vector<int> ids(3);
+    ids[0] = 1;
+    ids[1] = 2;
+    ids[2] = 3;
+    sql << "insert into soci_test(id) values(:id)", use(ids);
+
+    REQUIRE( phases.size() == 2 );
+    CHECK( phases[0].phase_ == qp_prepare );
+    CHECK( phases[0].duration_ >= 0 );
+    CHECK( phases[1].phase_ == qp_execute );
+    CHECK( phases[1].rows_ == 3 );
+    CHECK_FALSE( phases[1].failed_ );
+
+    phases.clear();
+
+    std::vector<int> fetched(2);
+    statement st = (sql.prepare << "select id from soci_test", into(fetched));
+    st.execute(true);
+    while (st.fetch())
+        ;
+
+    REQUIRE( phases.size() >= 3 );
+    CHECK( phases[0].phase_ == qp_prepare );
+    CHECK( phases[1].phase_ == qp_execute );
+    CHECK( phases[1].rows_ == 2 );
+    CHECK( phases[2].phase_ == qp_fetch );
+    CHECK( phases[2].rows_ == 1 );
+
+    phases.clear();
+
+    CHECK_THROWS_AS( (sql << "select * from soci_no_such_table"), soci_error& );
+
+    REQUIRE( phases.size() >= 1 );
+    CHECK( phases.back().failed_ );
+    CHECK( !phases.back().error_.empty() );
+
+    // An exception thrown by the logger itself is propagated, but doesn't
+    // make the statement fail.
+    sql.set_logger(new test_log_impl(phases, true));
+    phases.clear();
+
+    int count = 0;
+    statement st2 = (sql.prepare << "select count(*) from soci_test",
+                        into(count));
+    CHECK_THROWS_AS( st2.execute(true), std::runtime_error& );
+
+    REQUIRE( phases.size() == 2 );
+    CHECK( phases[1].phase_ == qp_execute );
+    CHECK_FALSE( phases[1].failed_ );
+
+    sql.set_logger(new test_log_impl(phases));
+}
+
+TEST_CASE_METHOD(common_tests, "Query statistics", "[core][log]")
+{
+    CHECK( query_statistics::normalize_query(
+            "  select *\n  from t where id = 17 and name = 'it''s' ")
+        == "select * from t where id = ? and name = ?" );
+    CHECK( query_statistics::normalize_query(
+            "insert into t2(x) values(:x, 1.5e-3)")
+        == "insert into t2(x) values(:x, ?)" );
+
+    // This object must outlive the session, see "Logger query phases" test.
+    query_statistics stats;
+
+    soci::session sql(backEndFactory_, connectString_);
+    auto_table_creator tableCreator(tc_.table_creator_1(sql));
+
+    sql.set_logger(new query_statistics_logger(stats));
+
+    for (int i = 0; i != 3; ++i)
+    {
+        sql << "insert into soci_test(id) values(" << i << ")";
+    }
+
+    std::vector<int> ids(10);
+    sql << "select id from soci_test", into(ids);
+
+    CHECK_THROWS_AS( (sql << "select * from soci_no_such_table"), soci_error& );
+
+    std::vector<query_statistics_entry> const snapshot = stats.get_snapshot();
+    REQUIRE( snapshot.size() == 3 );
+
+    // entries are sorted by the query text
+    CHECK( snapshot[0].query_ == "insert into soci_test(id) values(?)" );
+    CHECK( snapshot[0].calls_ == 3 );
+    CHECK( snapshot[0].rows_ == 3 );
+    CHECK( snapshot[0].errors_ == 0 );
+
+    CHECK( snapshot[1].query_ == "select * from soci_no_such_table" );
+    CHECK( snapshot[1].errors_ == 1 );
+
+    CHECK( snapshot[2].query_ == "select id from soci_test" );
+    CHECK( snapshot[2].calls_ == 1 );
+    CHECK( snapshot[2].rows_ == 3 );
+    CHECK( snapshot[2].maxDuration_ <= snapshot[2].totalDuration_ );
+}
+
 } // namespace test_cases
 
 } // namespace tests
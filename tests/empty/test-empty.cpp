@@ -7,6 +7,7 @@
 
 #include "soci/soci.h"
 #include "soci/empty/soci-empty.h"
+#include "soci/soci-simple.h"
 
 // Normally the tests would include common-tests.h here, but we can't run any
 // of the tests registered there, so instead include CATCH header directly.
@@ -15,9 +16,17 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 #include <cstdlib>
 #include <ctime>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sys/time.h>
+#endif
+
 using namespace soci;
 
 std::string connectString;
@@ -141,6 +150,654 @@ TEST_CASE("Dummy test", "[empty]")
     }
 }
 
+// Rows can also be filled manually, e.g. to test the code consuming them.
+TEST_CASE("Dynamic row filled manually", "[empty][row]")
+{
+    row r;
+
+    column_properties props;
+    props.set_name("ID");
+    props.set_data_type(dt_integer);
+    r.add_properties(props);
+    r.add_holder(new int(17), new indicator(i_ok));
+
+    props.set_name("NAME");
+    props.set_data_type(dt_string);
+    r.add_properties(props);
+    r.add_holder(new std::string("foo"), new indicator(i_ok));
+
+    props.set_name("NOTE");
+    r.add_properties(props);
+    r.add_holder(new std::string(), new indicator(i_null));
+
+    REQUIRE(r.size() == 3);
+    CHECK(r.get<int>(0) == 17);
+    CHECK(r.get<std::string>("NAME") == "foo");
+    CHECK(r.get_indicator("NOTE") == i_null);
+    CHECK(r.get<std::string>("NOTE", "none") == "none");
+    CHECK_THROWS_AS(r.get<double>(0), std::bad_cast&);
+}
+
+// Helpers for the connection pool tests using multiple threads.
+namespace
+{
+
+struct pool_worker
+{
+    connection_pool * pool_;
+
+    // the id of the worker using each pool entry or 0 if it's not used
+    std::vector<int> * owners_;
+
+    int id_;
+    int iterations_;
+    int errors_;
+};
+
+void run_worker(pool_worker & w)
+{
+    try
+    {
+        for (int i = 0; i != w.iterations_; ++i)
+        {
+            std::size_t const pos = w.pool_->lease();
+
+            // check that nobody else uses the same entry while we hold it
+            int volatile & owner = (*w.owners_)[pos];
+            if (owner != 0)
+            {
+                ++w.errors_;
+            }
+
+            owner = w.id_;
+            for (int n = 0; n != 10; ++n)
+            {
+                if (owner != w.id_)
+                {
+                    ++w.errors_;
+                    break;
+                }
+            }
+            owner = 0;
+
+            w.pool_->give_back(pos);
+        }
+    }
+    catch (soci_error const &)
+    {
+        ++w.errors_;
+    }
+}
+
+#ifdef _WIN32
+
+template <typename Worker>
+DWORD WINAPI worker_thread(LPVOID arg)
+{
+    run_worker(*static_cast<Worker *>(arg));
+    return 0;
+}
+
+double get_milliseconds()
+{
+    return static_cast<double>(GetTickCount());
+}
+
+#else
+
+template <typename Worker>
+void * worker_thread(void * arg)
+{
+    run_worker(*static_cast<Worker *>(arg));
+    return NULL;
+}
+
+double get_milliseconds()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+#endif
+
+// Call run_worker() for each of the workers in its own thread and wait until
+// all of them finish.
+template <typename Worker>
+void run_worker_threads(std::vector<Worker> & workers)
+{
+    std::size_t const numThreads = workers.size();
+
+#ifdef _WIN32
+    std::vector<HANDLE> threads(numThreads);
+    for (std::size_t i = 0; i != numThreads; ++i)
+    {
+        threads[i] = CreateThread(NULL, 0, worker_thread<Worker>, &workers[i], 0, NULL);
+        REQUIRE(threads[i] != NULL);
+    }
+
+    for (std::size_t i = 0; i != numThreads; ++i)
+    {
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+    }
+#else
+    std::vector<pthread_t> threads(numThreads);
+    for (std::size_t i = 0; i != numThreads; ++i)
+    {
+        REQUIRE(pthread_create(&threads[i], NULL, worker_thread<Worker>, &workers[i]) == 0);
+    }
+
+    for (std::size_t i = 0; i != numThreads; ++i)
+    {
+        pthread_join(threads[i], NULL);
+    }
+#endif
+}
+
+// Run the given number of threads leasing and giving back the entries of a
+// new pool of the given size, return the total number of errors and fill in
+// the elapsed time in milliseconds.
+int run_pool_workers(std::size_t poolSize, int numThreads, int iterations,
+    double & elapsed)
+{
+    connection_pool pool(poolSize);
+    std::vector<int> owners(poolSize, 0);
+
+    std::vector<pool_worker> workers(numThreads);
+    for (int i = 0; i != numThreads; ++i)
+    {
+        pool_worker & w = workers[i];
+        w.pool_ = &pool;
+        w.owners_ = &owners;
+        w.id_ = i + 1;
+        w.iterations_ = iterations;
+        w.errors_ = 0;
+    }
+
+    double const start = get_milliseconds();
+
+    run_worker_threads(workers);
+
+    elapsed = get_milliseconds() - start;
+
+    int errors = 0;
+    for (int i = 0; i != numThreads; ++i)
+    {
+        errors += workers[i].errors_;
+    }
+
+    return errors;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Connection pool leasing", "[empty][pool]")
+{
+    connection_pool pool(2);
+
+    std::size_t pos1 = pool.lease();
+    std::size_t pos2 = 0;
+    CHECK(pool.try_lease(pos2, 0));
+    CHECK(pos1 != pos2);
+
+    std::size_t pos3 = 0;
+    CHECK_FALSE(pool.try_lease(pos3, 10));
+
+    pool.give_back(pos2);
+    CHECK_THROWS_AS(pool.give_back(pos2), soci_error&);
+    CHECK_THROWS_AS(pool.give_back(2), soci_error&);
+
+    // the most recently returned entry is reused first
+    CHECK(pool.try_lease(pos3, 10));
+    CHECK(pos3 == pos2);
+
+    pool.give_back(pos1);
+    pool.give_back(pos3);
+}
+
+TEST_CASE("Connection pool with multiple threads", "[empty][pool]")
+{
+    double elapsed;
+    CHECK(run_pool_workers(3, 8, 2000, elapsed) == 0);
+    CHECK(run_pool_workers(16, 8, 2000, elapsed) == 0);
+}
+
+TEST_CASE("Connection pool validation", "[empty][pool]")
+{
+    connection_pool pool(1);
+    pool.set_validate_on_lease(true);
+
+    // the session can't be reconnected as it had never been opened
+    std::size_t pos;
+    CHECK_THROWS_AS(pool.try_lease(pos, 0), soci_error&);
+
+    // but the entry must still be available
+    pool.at(0).open(backEnd, connectString);
+    CHECK(pool.try_lease(pos, 0));
+    CHECK(pool.at(pos).is_connected());
+    pool.give_back(pos);
+}
+
+TEST_CASE("Elastic connection pool", "[empty][pool]")
+{
+    connection_parameters parameters(backEnd, connectString);
+
+    CHECK_THROWS_AS(connection_pool(parameters, 3, 2), soci_error&);
+
+    connection_pool pool(parameters, 2, 4);
+    CHECK(pool.get_size() == 2);
+
+    // the sessions opened initially are used first
+    std::vector<std::size_t> leased;
+    leased.push_back(pool.lease());
+    leased.push_back(pool.lease());
+    CHECK(pool.get_size() == 2);
+
+    // and then the new ones are opened when needed
+    leased.push_back(pool.lease());
+    leased.push_back(pool.lease());
+    CHECK(pool.get_size() == 4);
+
+    for (std::size_t i = 0; i != leased.size(); ++i)
+    {
+        CHECK(pool.at(leased[i]).is_connected());
+    }
+
+    // but not more than the maximal number of them
+    std::size_t pos;
+    CHECK_FALSE(pool.try_lease(pos, 10));
+
+    for (std::size_t i = 0; i != leased.size(); ++i)
+    {
+        pool.give_back(leased[i]);
+    }
+
+    {
+        session sql(pool);
+        sql << "Do what I want.";
+    }
+
+    CHECK(pool.get_size() == 4);
+}
+
+TEST_CASE("Elastic connection pool idle timeout", "[empty][pool]")
+{
+    connection_pool pool(connection_parameters(backEnd, connectString), 1, 3);
+
+    // this starts the thread closing the idle sessions, which must be stopped
+    // when the pool is destroyed
+    pool.set_idle_timeout(3600);
+
+    std::size_t const pos1 = pool.lease();
+    std::size_t const pos2 = pool.lease();
+    std::size_t const pos3 = pool.lease();
+    CHECK(pool.get_size() == 3);
+
+    pool.give_back(pos1);
+    pool.give_back(pos2);
+
+    // the sessions in use are never closed
+    CHECK(pool.close_idle_sessions(0) == 2);
+    CHECK(pool.get_size() == 1);
+    CHECK(pool.at(pos3).is_connected());
+
+    // and the minimal number of them is always kept open
+    pool.give_back(pos3);
+    CHECK(pool.close_idle_sessions(0) == 0);
+    CHECK(pool.get_size() == 1);
+
+    // the closed sessions are opened again when needed
+    std::size_t const pos4 = pool.lease();
+    std::size_t const pos5 = pool.lease();
+    CHECK(pool.get_size() == 2);
+    CHECK(pool.at(pos5).is_connected());
+
+    pool.give_back(pos4);
+    pool.give_back(pos5);
+}
+
+TEST_CASE("Elastic connection pool idle timeout set later", "[empty][pool]")
+{
+    connection_pool pool(connection_parameters(backEnd, connectString), 1, 3);
+
+    std::size_t const pos1 = pool.lease();
+    std::size_t const pos2 = pool.lease();
+    std::size_t const pos3 = pool.lease();
+
+    pool.give_back(pos1);
+    pool.give_back(pos2);
+    pool.give_back(pos3);
+
+    // the sessions were used recently, even if the timeout wasn't set yet,
+    // so they're not closed when checking for the idle ones
+    pool.set_idle_timeout(60);
+    CHECK(pool.close_idle_sessions(60) == 0);
+    CHECK(pool.get_size() == 3);
+
+    // only the elastic pools close their sessions
+    connection_pool fixedPool(1);
+    fixedPool.at(0).open(backEnd, connectString);
+    fixedPool.set_idle_timeout(1);
+    CHECK(fixedPool.close_idle_sessions(0) == 0);
+    CHECK(fixedPool.at(0).is_connected());
+}
+
+TEST_CASE("Connection parameters size options", "[empty][options]")
+{
+    connection_parameters parameters(backEnd, connectString);
+
+    std::size_t value = 17;
+    CHECK_FALSE(parameters.get_size_option("size", value));
+    CHECK(value == 17);
+
+    parameters.set_option("size", "4096");
+    CHECK(parameters.get_size_option("size", value));
+    CHECK(value == 4096);
+
+    CHECK_THROWS_AS(parameters.get_size_option("size", value, 1000), soci_error&);
+
+    char const * const invalid[] = { "", "-1", " 1", "1 ", "0x10", "1k",
+                                     "99999999999999999999999" };
+    for (std::size_t i = 0; i != sizeof(invalid)/sizeof(invalid[0]); ++i)
+    {
+        parameters.set_option("size", invalid[i]);
+        CHECK_THROWS_AS(parameters.get_size_option("size", value), soci_error&);
+    }
+}
+
+TEST_CASE("Pipeline mode without backend support", "[empty][pipeline]")
+{
+    soci::session sql(backEnd, connectString);
+
+    // The statements are just executed immediately.
+    sql.begin_pipeline();
+
+    int i = 7;
+    statement st = (sql.prepare << "insert", use(i));
+    st.set_pipelined(true);
+    st.execute(true);
+    sql << "select", into(i);
+
+    CHECK(sql.sync_pipeline() == -1);
+    CHECK(sql.end_pipeline() == -1);
+}
+
+// Helpers for the query statistics test.
+namespace
+{
+
+struct stats_worker
+{
+    connection_pool * pool_;
+    int id_;
+    int iterations_;
+};
+
+void run_worker(stats_worker & w)
+{
+    for (int i = 0; i != w.iterations_; ++i)
+    {
+        session sql(*w.pool_);
+        sql << "select " << w.id_ << " from   dual";
+        sql << "update t set x = 'thread " << w.id_ << "'";
+    }
+}
+
+} // anonymous namespace
+
+TEST_CASE("Query statistics shared by connection pool", "[empty][pool][log]")
+{
+    std::size_t const poolSize = 3;
+    int const numThreads = 4;
+    int const iterations = 100;
+
+    query_statistics stats;
+
+    connection_pool pool(poolSize);
+    for (std::size_t i = 0; i != poolSize; ++i)
+    {
+        pool.at(i).open(backEnd, connectString);
+        pool.at(i).set_logger(new query_statistics_logger(stats));
+    }
+
+    std::vector<stats_worker> workers(numThreads);
+    for (int i = 0; i != numThreads; ++i)
+    {
+        workers[i].pool_ = &pool;
+        workers[i].id_ = i + 1;
+        workers[i].iterations_ = iterations;
+    }
+
+    run_worker_threads(workers);
+
+    // the queries differing only by their literals are accounted together
+    std::vector<query_statistics_entry> const snapshot = stats.get_snapshot();
+    REQUIRE(snapshot.size() == 2);
+    CHECK(snapshot[0].query_ == "select ? from dual");
+    CHECK(snapshot[0].calls_ == numThreads * iterations);
+    CHECK(snapshot[0].errors_ == 0);
+    CHECK(snapshot[0].maxDuration_ <= snapshot[0].totalDuration_);
+    CHECK(snapshot[1].query_ == "update t set x = ?");
+    CHECK(snapshot[1].calls_ == numThreads * iterations);
+
+    stats.reset();
+    CHECK(stats.get_size() == 0);
+}
+
+// This test is not run by default, use "[benchmark]" to run it explicitly.
+TEST_CASE("Connection pool contention benchmark", "[empty][pool][benchmark][.]")
+{
+    int const iterations = 100000;
+
+    std::size_t const poolSizes[] = { 8, 256 };
+    for (std::size_t n = 0; n != sizeof(poolSizes)/sizeof(poolSizes[0]); ++n)
+    {
+        for (int numThreads = 1; numThreads <= 64; numThreads *= 2)
+        {
+            double elapsed;
+            CHECK(run_pool_workers(poolSizes[n], numThreads, iterations, elapsed) == 0);
+
+            std::cout << "pool size " << poolSizes[n]
+                      << ", " << numThreads << " threads: "
+                      << static_cast<long>(numThreads * (iterations / (elapsed + 1.0)))
+                      << " leases/ms\n";
+        }
+    }
+}
+
+// Helpers for the simple interface tests.
+namespace
+{
+
+// Statement of a session using the empty backend, registered under this name
+// as it is linked statically into the tests.
+class simple_statement
+{
+public:
+    simple_statement()
+    {
+        dynamic_backends::register_backend("empty", backEnd);
+
+        session_ = soci_create_session(("empty://" + connectString).c_str());
+        REQUIRE(soci_session_state(session_) == 1);
+
+        st_ = soci_create_statement(session_);
+        REQUIRE(st_ != NULL);
+    }
+
+    ~simple_statement()
+    {
+        soci_destroy_statement(st_);
+        soci_destroy_session(session_);
+    }
+
+    operator statement_handle() const { return st_; }
+
+    bool is_ok() const { return soci_statement_state(st_) == 1; }
+
+    std::string error() const { return soci_statement_error_message(st_); }
+
+private:
+    session_handle session_;
+    statement_handle st_;
+};
+
+} // anonymous namespace
+
+TEST_CASE("Simple interface single elements", "[empty][simple]")
+{
+    simple_statement st;
+
+    CHECK(soci_into_int(st) == 0);
+    CHECK(soci_into_string(st) == 1);
+    CHECK(soci_into_double(st) == 2);
+
+    soci_use_int(st, "id");
+    soci_use_string(st, "name");
+    CHECK(st.is_ok());
+
+    soci_use_int(st, "id");
+    CHECK_FALSE(st.is_ok());
+    CHECK(st.error() == "Name of use element should be unique.");
+
+    soci_set_use_int(st, "id", 17);
+    soci_set_use_string(st, "name", "foo");
+    CHECK(st.is_ok());
+    CHECK(soci_get_use_int(st, "id") == 17);
+    CHECK(soci_get_use_string(st, "name") == std::string("foo"));
+    CHECK(soci_get_use_state(st, "name") == 1);
+
+    // the elements are found by name, but must be of the right type
+    soci_set_use_string(st, "id", "bar");
+    CHECK_FALSE(st.is_ok());
+    CHECK(st.error() == "No use string element with this name.");
+    CHECK(soci_get_use_int(st, "id") == 17);
+
+    soci_set_use_int(st, "nosuch", 1);
+    CHECK_FALSE(st.is_ok());
+    CHECK(st.error() == "No use int element with this name.");
+
+    soci_set_use_state(st, "name", 0);
+    CHECK(st.is_ok());
+    CHECK(soci_get_use_state(st, "name") == 0);
+
+    // vector elements can't be mixed with the single ones
+    soci_into_int_v(st);
+    CHECK_FALSE(st.is_ok());
+    CHECK(st.error() == "Cannot add vector into data items.");
+    soci_use_int_v(st, "ids");
+    CHECK_FALSE(st.is_ok());
+    CHECK(st.error() == "Cannot add vector use data items.");
+
+    soci_prepare(st, "select id, name, value from t where id = :id or name = :name");
+    CHECK(st.is_ok());
+    CHECK(soci_execute(st, 1) == 1);
+    CHECK(st.is_ok());
+
+    // the empty backend doesn't fetch anything, so the values are unchanged
+    CHECK(soci_get_into_state(st, 0) == 1);
+    CHECK(soci_get_into_int(st, 0) == 0);
+    CHECK(soci_get_into_string(st, 1) == std::string());
+    CHECK(st.is_ok());
+
+    soci_get_into_double(st, 0);
+    CHECK_FALSE(st.is_ok());
+    CHECK(st.error() == "No into double element at this position.");
+
+    soci_get_into_int(st, 3);
+    CHECK_FALSE(st.is_ok());
+    CHECK(st.error() == "Invalid position.");
+
+    // no more elements can be added once the statement is prepared
+    soci_into_int(st);
+    CHECK_FALSE(st.is_ok());
+    CHECK(st.error() == "Cannot add more data items.");
+}
+
+TEST_CASE("Simple interface arrays", "[empty][simple]")
+{
+    simple_statement st;
+
+    CHECK(soci_into_int_v(st) == 0);
+    CHECK(soci_into_double_v(st) == 1);
+    CHECK(soci_into_long_long_v(st) == 2);
+    soci_into_resize_v(st, 3);
+    CHECK(st.is_ok());
+    CHECK(soci_into_get_size_v(st) == 3);
+
+    soci_into_int(st);
+    CHECK_FALSE(st.is_ok());
+    CHECK(st.error() == "Cannot add single into data items.");
+
+    soci_use_int_v(st, "ids");
+    soci_use_double_v(st, "values");
+    soci_use_resize_v(st, 3);
+    CHECK(st.is_ok());
+    CHECK(soci_use_get_size_v(st) == 3);
+
+    int const ids[] = { 1, 2, 3 };
+    int const states[] = { 1, 0, 1 };
+    soci_set_use_int_array(st, "ids", ids, states, 3);
+    CHECK(st.is_ok());
+
+    double const values[] = { 0.5, 1.5, 2.5 };
+    soci_set_use_double_array(st, "values", values, NULL, 3);
+    CHECK(st.is_ok());
+
+    // the size must be the same as the size of the use vectors
+    soci_set_use_int_array(st, "ids", ids, NULL, 2);
+    CHECK_FALSE(st.is_ok());
+    CHECK(st.error() == "Invalid size.");
+
+    // and the type must match the element type
+    long long const longs[] = { 1, 2, 3 };
+    soci_set_use_long_long_array(st, "ids", longs, NULL, 3);
+    CHECK_FALSE(st.is_ok());
+    CHECK(st.error() == "No use vector long long element with this name.");
+
+    soci_set_use_int_array(st, "nosuch", ids, NULL, 3);
+    CHECK_FALSE(st.is_ok());
+    CHECK(st.error() == "No use vector int element with this name.");
+
+    soci_prepare(st, "insert into t(id, value) values(:ids, :values)");
+    CHECK(st.is_ok());
+    soci_execute(st, 1);
+    CHECK(st.is_ok());
+
+    // the empty backend returns a single row with unchanged values
+    int const fetched = soci_into_get_size_v(st);
+    REQUIRE(fetched == 1);
+
+    int intos[3] = { -1, -1, -1 };
+    int intoStates[3] = { -1, -1, -1 };
+    CHECK(soci_get_into_int_array(st, 0, intos, intoStates, 3) == fetched);
+    CHECK(st.is_ok());
+    CHECK(intos[0] == 0);
+    CHECK(intoStates[0] == 1);
+    CHECK(intos[1] == -1);
+
+    double doubles[3];
+    CHECK(soci_get_into_double_array(st, 1, doubles, NULL, 3) == fetched);
+    CHECK(st.is_ok());
+
+    // copying stops at the size of the provided array
+    long long intoLongs[1];
+    CHECK(soci_get_into_long_long_array(st, 2, intoLongs, NULL, 0) == 0);
+    CHECK(st.is_ok());
+
+    CHECK(soci_get_into_long_long_array(st, 2, intoLongs, NULL, -1) == -1);
+    CHECK_FALSE(st.is_ok());
+    CHECK(st.error() == "Invalid size.");
+
+    CHECK(soci_get_into_double_array(st, 0, doubles, NULL, 3) == -1);
+    CHECK_FALSE(st.is_ok());
+    CHECK(st.error() == "No into vector double element at this position.");
+
+    CHECK(soci_get_into_int_array(st, 3, intos, NULL, 3) == -1);
+    CHECK_FALSE(st.is_ok());
+    CHECK(st.error() == "Invalid position.");
+}
 
 int main(int argc, char** argv)
 {
@@ -797,6 +797,370 @@ TEST_CASE("MySQL last insert id", "[mysql][last-insert-id]")
     CHECK(id == 42);
 }
 
+struct prepared_statements_table_creator : table_creator_base
+{
+    prepared_statements_table_creator(soci::session & sql)
+        : table_creator_base(sql)
+    {
+        sql << "create table soci_test(id integer, s varchar(100), "
+            "d double, ll bigint unsigned, tm datetime)";
+    }
+};
+
+TEST_CASE("MySQL prepared statements", "[mysql][prepared]")
+{
+    soci::session sql(backEnd, connectString + " prepared_statements=1");
+
+    prepared_statements_table_creator tableCreator(sql);
+
+    int id;
+    std::string s;
+    double d;
+    unsigned long long ll;
+    std::tm tm = std::tm();
+    indicator ind;
+    statement st = (sql.prepare <<
+        "insert into soci_test(id, s, d, ll, tm) values(:id, :s, :d, :ll, :tm)",
+        use(id), use(s, ind), use(d), use(ll), use(tm));
+
+    tm.tm_year = 119;
+    tm.tm_mon = 9;
+    tm.tm_mday = 7;
+    tm.tm_hour = 12;
+    for (id = 1; id <= 10; ++id)
+    {
+        s = std::string(id, 'x');
+        ind = id == 5 ? i_null : i_ok;
+        d = id + 0.5;
+        ll = 18446744073709551615ULL - id;
+        tm.tm_min = id;
+        st.execute(true);
+        CHECK(st.get_affected_rows() == 1);
+    }
+
+    int count;
+    sql << "select count(*) from soci_test where id > :id", use(5), into(count);
+    CHECK(count == 5);
+
+    sql << "select id, s, d, ll, tm from soci_test where id = 7",
+        into(id), into(s), into(d), into(ll), into(tm);
+    CHECK(id == 7);
+    CHECK(s == "xxxxxxx");
+    CHECK(d == 7.5);
+    CHECK(ll == 18446744073709551608ULL);
+    CHECK(tm.tm_year == 119);
+    CHECK(tm.tm_mon == 9);
+    CHECK(tm.tm_mday == 7);
+    CHECK(tm.tm_hour == 12);
+    CHECK(tm.tm_min == 7);
+
+    sql << "select s from soci_test where id = 5", into(s, ind);
+    CHECK(ind == i_null);
+
+    // numbers can be still retrieved as strings
+    sql << "select d from soci_test where id = 3", into(s);
+    CHECK(s == "3.5");
+
+    std::vector<int> ids(4);
+    std::vector<std::string> strs(4);
+    std::vector<indicator> inds(4);
+    statement st2 = (sql.prepare <<
+        "select id, s from soci_test order by id",
+        into(ids), into(strs, inds));
+    st2.execute();
+    int total = 0;
+    while (st2.fetch())
+    {
+        for (std::size_t i = 0; i != ids.size(); ++i)
+        {
+            ++total;
+            CHECK(ids[i] == total);
+            if (total == 5)
+            {
+                CHECK(inds[i] == i_null);
+            }
+            else
+            {
+                CHECK(inds[i] == i_ok);
+                CHECK(strs[i] == std::string(total, 'x'));
+            }
+        }
+    }
+    CHECK(total == 10);
+
+    // bulk insert
+    std::vector<int> v;
+    v.push_back(100);
+    v.push_back(101);
+    v.push_back(102);
+    statement st3 = (sql.prepare <<
+        "insert into soci_test(id) values(:id)", use(v));
+    st3.execute(true);
+    CHECK(st3.get_affected_rows() == 3);
+
+    row r;
+    sql << "select id, s, d, tm from soci_test where id = 2", into(r);
+    CHECK(r.get<int>(0) == 2);
+    CHECK(r.get<std::string>(1) == "xx");
+    CHECK(r.get<double>(2) == 2.5);
+    CHECK(r.get<std::tm>(3).tm_min == 2);
+
+    // statements not supported by the prepared statements protocol
+    // still work
+    sql << "lock tables soci_test write";
+    sql << "unlock tables";
+}
+
+// Returns the number of the currently open server-side prepared statements.
+int get_prepared_stmt_count(soci::session & sql)
+{
+    std::string name, value;
+    sql << "show global status like 'Prepared_stmt_count'",
+        into(name), into(value);
+    return std::atoi(value.c_str());
+}
+
+TEST_CASE("MySQL prepared statements prepared again", "[mysql][prepared]")
+{
+    soci::session sql(backEnd, connectString + " prepared_statements=1");
+    soci::session sqlStatus(backEnd, connectString);
+
+    int const before = get_prepared_stmt_count(sqlStatus);
+
+    statement st(sql);
+    st.alloc();
+    for (int i = 0; i != 10; ++i)
+    {
+        st.prepare("select 1");
+    }
+
+    // only the statement prepared last is still open, the other ones must
+    // have been closed (other clients could use prepared statements too, so
+    // don't check for the exact count)
+    CHECK(get_prepared_stmt_count(sqlStatus) - before < 10);
+}
+
+struct bulk_insert_table_creator : table_creator_base
+{
+    bulk_insert_table_creator(soci::session & sql)
+        : table_creator_base(sql)
+    {
+        sql << "create table soci_test(id integer primary key, "
+            "s varchar(20)) engine=InnoDB";
+    }
+};
+
+void test_bulk_insert(std::string const & connStr)
+{
+    soci::session sql(backEnd, connStr);
+
+    bulk_insert_table_creator tableCreator(sql);
+
+    // Use a big enough number of rows to need several queries.
+    std::vector<int> ids;
+    std::vector<std::string> strs;
+    for (int i = 0; i != 50000; ++i)
+    {
+        ids.push_back(i);
+        strs.push_back(std::string(i % 20, 'x'));
+    }
+
+    statement st = (sql.prepare <<
+        "insert into soci_test(id, s) values (:id, :s)", use(ids), use(strs));
+    st.execute(true);
+    CHECK(st.get_affected_rows() == 50000);
+
+    int count;
+    sql << "select count(*) from soci_test", into(count);
+    CHECK(count == 50000);
+
+    std::string s;
+    sql << "select s from soci_test where id = 12345", into(s);
+    CHECK(s == std::string(5, 'x'));
+
+    // The statement can be reused with different data.
+    ids.resize(3);
+    strs.resize(3);
+    for (int i = 0; i != 3; ++i)
+    {
+        ids[i] = 100000 + i;
+    }
+    st.execute(true);
+    CHECK(st.get_affected_rows() == 3);
+
+    sql << "select count(*) from soci_test", into(count);
+    CHECK(count == 50003);
+
+    // Clauses after the values tuple are preserved.
+    sql << "insert into soci_test(id, s) values(:id, :s) "
+           "on duplicate key update s = 'dup'", use(ids), use(strs);
+    sql << "select count(*) from soci_test where s = 'dup'", into(count);
+    CHECK(count == 3);
+
+    // All rows fit into a single query here, which is atomic with InnoDB,
+    // so a failure in the middle of it doesn't insert anything.
+    ids.clear();
+    strs.clear();
+    for (int i = 0; i != 10; ++i)
+    {
+        ids.push_back(200000 + i);
+        strs.push_back("new");
+    }
+    ids.push_back(0); // duplicate key
+    strs.push_back("dup");
+    statement st2 = (sql.prepare <<
+        "insert into soci_test(id, s) values (:id, :s)", use(ids), use(strs));
+    CHECK_THROWS_AS(st2.execute(true), mysql_soci_error&);
+    sql << "select count(*) from soci_test where s = 'new'", into(count);
+    CHECK(count == 0);
+}
+
+TEST_CASE("MySQL bulk insert", "[mysql][bulk]")
+{
+    SECTION("Text protocol")
+    {
+        test_bulk_insert(connectString);
+    }
+
+    SECTION("Prepared statements")
+    {
+        test_bulk_insert(connectString + " prepared_statements=1");
+    }
+}
+
+struct streamed_table_creator : table_creator_base
+{
+    streamed_table_creator(soci::session & sql)
+        : table_creator_base(sql)
+    {
+        sql << "create table soci_test(id integer, s varchar(20))";
+    }
+};
+
+TEST_CASE("MySQL streamed results", "[mysql][use-result]")
+{
+    soci::session sql(backEnd, connectString + " use_result=1");
+
+    streamed_table_creator tableCreator(sql);
+
+    std::vector<int> ids;
+    std::vector<std::string> strs;
+    std::vector<indicator> inds;
+    for (int i = 1; i <= 10; ++i)
+    {
+        ids.push_back(i);
+        strs.push_back(std::string(i, 'x'));
+        inds.push_back(i % 3 == 0 ? i_null : i_ok);
+    }
+    sql << "insert into soci_test(id, s) values(:id, :s)",
+        use(ids), use(strs, inds);
+
+    int count;
+    sql << "select count(*) from soci_test", into(count);
+    CHECK(count == 10);
+
+    // Single row fetches.
+    int id;
+    std::string str;
+    indicator ind;
+    statement st = (sql.prepare <<
+        "select id, s from soci_test order by id", into(id), into(str, ind));
+    st.execute();
+    int expected = 0;
+    while (st.fetch())
+    {
+        ++expected;
+        CHECK(id == expected);
+        if (expected % 3 == 0)
+        {
+            CHECK(ind == i_null);
+        }
+        else
+        {
+            CHECK(ind == i_ok);
+            CHECK(str == std::string(expected, 'x'));
+        }
+    }
+    CHECK(expected == 10);
+
+    // Batches of rows, with the last one incomplete.
+    std::vector<int> ids2(4);
+    std::vector<std::string> strs2(4);
+    std::vector<indicator> inds2(4);
+    statement st2 = (sql.prepare <<
+        "select id, s from soci_test order by id",
+        into(ids2), into(strs2, inds2));
+    st2.execute();
+    expected = 0;
+    while (st2.fetch())
+    {
+        for (std::size_t i = 0; i != ids2.size(); ++i)
+        {
+            ++expected;
+            CHECK(ids2[i] == expected);
+            if (expected % 3 == 0)
+            {
+                CHECK(inds2[i] == i_null);
+            }
+            else
+            {
+                CHECK(strs2[i] == std::string(expected, 'x'));
+            }
+        }
+    }
+    CHECK(expected == 10);
+
+    // Dynamic rows, with the description done before fetching anything.
+    expected = 0;
+    rowset<row> rs = (sql.prepare << "select id, s from soci_test order by id");
+    for (rowset<row>::const_iterator it = rs.begin(); it != rs.end(); ++it)
+    {
+        ++expected;
+        CHECK(it->get<int>(0) == expected);
+    }
+    CHECK(expected == 10);
+
+    // Unread rows are discarded, allowing to execute other queries.
+    sql << "select id from soci_test order by id", into(id);
+    CHECK(id == 1);
+    sql << "select count(*) from soci_test", into(count);
+    CHECK(count == 10);
+}
+
+TEST_CASE("MySQL streamed results with statement cache",
+          "[mysql][use-result][statement-cache]")
+{
+    soci::session sql(backEnd, connectString + " use_result=1");
+    sql.set_statement_cache_size(4);
+
+    streamed_table_creator tableCreator(sql);
+
+    for (int i = 1; i <= 10; ++i)
+    {
+        sql << "insert into soci_test(id) values(:id)", use(i);
+    }
+
+    // Only read the first of the streamed rows: the rest of them must be
+    // discarded when the statement is put into the cache, otherwise the
+    // next query would fail because of the unread rows.
+    int id = 0;
+    sql << "select id from soci_test order by id", into(id);
+    CHECK(id == 1);
+
+    int count = 0;
+    sql << "select count(*) from soci_test", into(count);
+    CHECK(count == 10);
+
+    // Reusing the cached statement works too.
+    id = 0;
+    sql << "select id from soci_test order by id", into(id);
+    CHECK(id == 1);
+
+    sql << "select count(*) from soci_test where id > :id", use(id),
+        into(count);
+    CHECK(count == 9);
+}
+
 std::string escape_string(soci::session& sql, const std::string& s)
 {
     mysql_session_backend* backend = static_cast<mysql_session_backend*>(
@@ -75,6 +75,90 @@ TEST_CASE("MS SQL long string", "[odbc][mssql][long]")
     );
 }
 
+TEST_CASE("MS SQL long string vector", "[odbc][mssql][long][vector]")
+{
+    struct long_text_table_creator : public table_creator_base
+    {
+        explicit long_text_table_creator(soci::session& sql)
+            : table_creator_base(sql)
+        {
+            sql << "create table soci_test ("
+                        "id integer, "
+                        "long_text nvarchar(max) null"
+                    ")";
+        }
+    };
+
+    // Use a string longer than the default buffer used for long columns.
+    std::ostringstream os;
+    for ( int n = 0; n < 1000; ++n )
+    {
+        os << "Line #" << n << "\n";
+    }
+
+    std::string const str_long = os.str();
+    std::string const str_short = "short";
+
+    SECTION("default options")
+    {
+        soci::session sql(backEnd, connectString);
+        long_text_table_creator tableCreator(sql);
+
+        for ( int i = 0; i < 10; ++i )
+        {
+            sql << "insert into soci_test(id, long_text) values(:id, :str)",
+                   use(i), use(i % 3 ? str_short : str_long);
+        }
+
+        std::vector<std::string> v(10);
+        sql << "select long_text from soci_test order by id", into(v);
+
+        REQUIRE(v.size() == 10);
+        for ( int i = 0; i < 10; ++i )
+        {
+            CHECK(v[i].length() == (i % 3 ? str_short : str_long).length());
+        }
+        CHECK(v[0] == str_long);
+        CHECK(v[1] == str_short);
+    }
+
+    SECTION("fetch buffer limit")
+    {
+        connection_parameters parameters(backEnd, connectString);
+        parameters.set_option(odbc_option_long_column_buffer_size, "100");
+        parameters.set_option(odbc_option_fetch_buffer_limit, "505");
+
+        soci::session sql(parameters);
+        long_text_table_creator tableCreator(sql);
+
+        for ( int i = 0; i < 10; ++i )
+        {
+            sql << "insert into soci_test(id, long_text) values(:id, :str)",
+                   use(i), use(i % 3 ? str_short : str_long);
+        }
+
+        // Only 5 rows fit into the limit, so they must be fetched in 2 batches.
+        std::vector<std::string> v(10);
+        statement st = (sql.prepare <<
+            "select long_text from soci_test order by id", into(v));
+        st.execute();
+
+        int rows = 0;
+        while ( st.fetch() )
+        {
+            CHECK(v.size() == 5);
+            for ( std::size_t i = 0; i < v.size(); ++i, ++rows )
+            {
+                CHECK(v[i] == (rows % 3 ? str_short : str_long));
+            }
+
+            v.resize(10);
+        }
+
+        CHECK(rows == 10);
+    }
+}
+
 // DDL Creation objects for common tests
 struct table_creator_one : public table_creator_base
 {
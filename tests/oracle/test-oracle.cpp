@@ -674,6 +674,97 @@ TEST_CASE("Oracle bulk insert", "[oracle][insert][bulk]")
     }
 }
 
+TEST_CASE("Oracle prefetch", "[oracle][fetch][prefetch]")
+{
+    connection_parameters parameters(backEnd, connectString);
+    parameters.set_option(oracle_option_prefetch_rows, "100");
+    parameters.set_option(oracle_option_prefetch_memory, "65536");
+
+    soci::session sql(parameters);
+
+    basic_table_creator tableCreator(sql);
+
+    std::vector<int> in;
+    for (int i = 1; i <= 10; ++i)
+    {
+        in.push_back(i);
+    }
+
+    sql << "insert into soci_test (id) values(:id)", use(in);
+
+    // rows are prefetched using the session settings
+    {
+        int id;
+        statement st = (sql.prepare << "select id from soci_test order by id",
+            into(id));
+        st.execute();
+
+        int expected = 1;
+        while (st.fetch())
+        {
+            CHECK(id == expected++);
+        }
+        CHECK(expected == 11);
+    }
+
+    // and the settings can be overridden for a particular statement
+    {
+        int id;
+        statement st = (sql.prepare << "select id from soci_test order by id",
+            into(id));
+
+        oracle_statement_backend* const stbe
+            = static_cast<oracle_statement_backend*>(st.get_backend());
+        stbe->set_prefetch_rows(0);
+        stbe->set_prefetch_memory(1024);
+
+        st.execute();
+
+        int expected = 1;
+        while (st.fetch())
+        {
+            CHECK(id == expected++);
+        }
+        CHECK(expected == 11);
+    }
+
+    connection_parameters badParameters(backEnd, connectString);
+    badParameters.set_option(oracle_option_prefetch_rows, "many");
+    CHECK_THROWS_AS(soci::session(badParameters), soci_error&);
+}
+
+TEST_CASE("Oracle LOB prefetch", "[oracle][fetch][prefetch][lob]")
+{
+    connection_parameters parameters(backEnd, connectString);
+    parameters.set_option(oracle_option_lob_prefetch_size, "4096");
+
+    soci::session sql(parameters);
+
+    struct clob_table_creator : public table_creator_base
+    {
+        explicit clob_table_creator(soci::session & sql)
+            : table_creator_base(sql)
+        {
+            sql << "create table soci_test(id number(10), s clob)";
+        }
+    } tableCreator(sql);
+
+    long_string in;
+    in.value = std::string(10000, 'X');
+    sql << "insert into soci_test(id, s) values(1, :s)", use(in);
+
+    long_string out;
+    statement st = (sql.prepare << "select s from soci_test where id = 1",
+        into(out));
+
+    // only a part of the value is prefetched, the rest must still be read
+    static_cast<oracle_statement_backend*>(st.get_backend())
+        ->set_lob_prefetch_size(1000);
+
+    st.execute(true);
+    CHECK(out.value == in.value);
+}
+
 // more tests for bulk fetch
 TEST_CASE("Oracle bulk fetch", "[oracle][fetch][bulk]")
 {
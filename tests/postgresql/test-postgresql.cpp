@@ -14,6 +14,7 @@
 #include <cmath>
 #include <cstring>
 #include <ctime>
+#include <cstdio>
 #include <cstdlib>
 
 using namespace soci;
@@ -225,6 +226,76 @@ TEST_CASE("PostgreSQL blob", "[postgresql][blob]")
     }
 }
 
+TEST_CASE("PostgreSQL blob streaming", "[postgresql][blob]")
+{
+    soci::session sql(backEnd, connectString);
+
+    blob_table_creator tableCreator(sql);
+
+    sql << "insert into soci_test(id, img) values(7, lo_creat(-1))";
+
+    transaction tr(sql);
+
+    std::string const chunk = "0123456789";
+    int const numChunks = 1000;
+
+    {
+        blob b(sql);
+        sql << "select img from soci_test where id = 7", into(b);
+
+        for (int i = 0; i != numChunks; ++i)
+        {
+            b.append(chunk.c_str(), chunk.size());
+        }
+        CHECK(b.get_len() == numChunks * chunk.size());
+
+        // overwriting in the middle must not change the length
+        b.write(5, "abc", 3);
+        CHECK(b.get_len() == numChunks * chunk.size());
+    }
+
+    char const* const filename = "soci_test_blob.dat";
+
+    {
+        // read the entire object at once using a big buffer
+        blob b(sql);
+        sql << "select img from soci_test where id = 7", into(b);
+
+        std::vector<char> buf(numChunks * chunk.size() + 100);
+        REQUIRE(b.read(0, &buf[0], buf.size()) == numChunks * chunk.size());
+        CHECK(std::string(&buf[0], 15) == "01234abc8901234");
+        CHECK(b.get_len() == numChunks * chunk.size());
+
+        // reading past the end of the object doesn't read anything
+        CHECK(b.read(buf.size(), &buf[0], 10) == 0);
+        CHECK(b.get_len() == numChunks * chunk.size());
+
+        postgresql_blob_backend* const bbe
+            = static_cast<postgresql_blob_backend*>(b.get_backend());
+        bbe->export_file(filename);
+    }
+
+    {
+        blob b(sql);
+        postgresql_blob_backend* const bbe
+            = static_cast<postgresql_blob_backend*>(b.get_backend());
+        unsigned long const oid = bbe->import_file(filename);
+        std::remove(filename);
+
+        CHECK(b.get_len() == numChunks * chunk.size());
+
+        char buf[10];
+        REQUIRE(b.read((numChunks - 1) * chunk.size(), buf, 10) == 10);
+        CHECK(std::string(buf, 10) == chunk);
+
+        sql << "select lo_unlink(" << oid << ")";
+    }
+
+    unsigned long oid;
+    sql << "select img from soci_test where id = 7", into(oid);
+    sql << "select lo_unlink(" << oid << ")";
+}
+
 struct longlong_table_creator : table_creator_base
 {
     longlong_table_creator(soci::session & sql)
@@ -458,6 +529,388 @@ TEST_CASE("PostgreSQL datetime", "[postgresql][datetime]")
     CHECK(t3.tm_sec == 3);
 }
 
+TEST_CASE("PostgreSQL binary results", "[postgresql][binary]")
+{
+    soci::session sql(backEnd, connectString + " binaryresults=true");
+
+    short sh = 0;
+    int i = 0;
+    long long ll = 0;
+    unsigned long long ull = 0;
+    double d = 0;
+    std::string s, num, bytes;
+    int b = -1;
+    sql << "select 17::int2, -123456::int4, -9876543210::int8, 42::int4,"
+           " 0.1::float8, 'hello'::text, 12345.678::numeric,"
+           " '\\x00ff41'::bytea, true",
+        into(sh), into(i), into(ll), into(ull), into(d), into(s), into(num),
+        into(bytes), into(b);
+    CHECK(sh == 17);
+    CHECK(i == -123456);
+    CHECK(ll == -9876543210LL);
+    CHECK(ull == 42);
+    CHECK(d == 0.1);
+    CHECK(s == "hello");
+    CHECK(num == "12345.678");
+    CHECK(bytes == std::string("\0\xff" "A", 3));
+    CHECK(b == 1);
+
+    // Conversions between the types still work.
+    sql << "select 2.5::numeric, 123::int8, 1.5::float4",
+        into(d), into(s), into(num);
+    CHECK(d == 2.5);
+    CHECK(s == "123");
+    CHECK(num == "1.5");
+
+    CHECK_THROWS_AS((sql << "select 70000::int4", into(sh)), soci_error&);
+    CHECK_THROWS_AS((sql << "select -1::int4", into(ull)), soci_error&);
+
+    std::tm t1 = std::tm(), t2 = std::tm(), t3 = std::tm();
+    sql << "select '1969-06-17'::date, '22:51:03.123'::time,"
+           " '2009-06-17 22:51:03.123'::timestamp",
+        into(t1), into(t2), into(t3);
+    CHECK(t1.tm_year == 1969 - 1900);
+    CHECK(t1.tm_mon == 6 - 1);
+    CHECK(t1.tm_mday == 17);
+    CHECK(t1.tm_hour == 0);
+    CHECK(t2.tm_year == 0);
+    CHECK(t2.tm_mday == 1);
+    CHECK(t2.tm_hour == 22);
+    CHECK(t2.tm_min == 51);
+    CHECK(t2.tm_sec == 3);
+    CHECK(t3.tm_year == 2009 - 1900);
+    CHECK(t3.tm_mon == 6 - 1);
+    CHECK(t3.tm_mday == 17);
+    CHECK(t3.tm_hour == 22);
+    CHECK(t3.tm_min == 51);
+    CHECK(t3.tm_sec == 3);
+
+    sql << "select '2009-06-17 22:51:03.123'::timestamp::text", into(s);
+    sql << "select '2009-06-17 22:51:03.123'::timestamp", into(num);
+    CHECK(num == s);
+
+    std::vector<int> ids(10);
+    std::vector<double> vals(10);
+    std::vector<indicator> inds(10);
+    sql << "select n, case when n % 2 = 0 then null else n / 4.0 end"
+           " from generate_series(1, 5) as n order by n",
+        into(ids), into(vals, inds);
+    REQUIRE(ids.size() == 5);
+    for (int n = 1; n <= 5; ++n)
+    {
+        CHECK(ids[n - 1] == n);
+        if (n % 2 == 0)
+        {
+            CHECK(inds[n - 1] == i_null);
+        }
+        else
+        {
+            CHECK(inds[n - 1] == i_ok);
+            CHECK(vals[n - 1] == n / 4.0);
+        }
+    }
+
+    row r;
+    sql << "select 7::int4 as i, 1.25::numeric as n, 'x'::varchar as s", into(r);
+    CHECK(r.get<int>(0) == 7);
+    CHECK(r.get<double>(1) == 1.25);
+    CHECK(r.get<std::string>(2) == "x");
+}
+
+struct binary_params_table_creator : table_creator_base
+{
+    binary_params_table_creator(soci::session & sql)
+        : table_creator_base(sql)
+    {
+        sql << "create table soci_test(i int4, ll int8, sh int2, b boolean,"
+               " d float8, f float4, dt date, ts timestamp, bin bytea,"
+               " txt text)";
+    }
+};
+
+TEST_CASE("PostgreSQL binary parameters", "[postgresql][binary]")
+{
+    soci::session sql(backEnd, connectString + " binaryparams=true");
+
+    binary_params_table_creator tableCreator(sql);
+
+    int i = -7;
+    long long ll = 1234567890123LL;
+    int sh = 12;
+    int b = 1;
+    double d = 0.1;
+    double f = 2.5;
+    std::tm t = std::tm();
+    t.tm_year = 1969 - 1900;
+    t.tm_mon = 6 - 1;
+    t.tm_mday = 17;
+    t.tm_hour = 22;
+    t.tm_min = 51;
+    t.tm_sec = 3;
+    std::string bin("\0\x01\\x'", 5);
+    std::string txt("\\x41");
+    statement st = (sql.prepare <<
+        "insert into soci_test(i, ll, sh, b, d, f, dt, ts, bin, txt)"
+        " values(:i, :ll, :sh, :b, :d, :f, :dt, :ts, :bin, :txt)",
+        use(i), use(ll), use(sh), use(b), use(d), use(f), use(t), use(t),
+        use(bin), use(txt));
+    st.execute(true);
+
+    // Check the values using the text format.
+    std::string s;
+    sql << "select i || ' ' || ll || ' ' || sh || ' ' || b || ' ' || d"
+           " || ' ' || f || ' ' || dt || ' ' || ts from soci_test", into(s);
+    CHECK(s == "-7 1234567890123 12 true 0.1 2.5 1969-06-17 1969-06-17 22:51:03");
+
+    // The string is sent as is, without being interpreted as escaped bytea.
+    int len = 0;
+    sql << "select length(bin) from soci_test", into(len);
+    CHECK(len == 5);
+    sql << "select get_byte(bin, 1) from soci_test", into(len);
+    CHECK(len == 1);
+    sql << "select txt from soci_test", into(s);
+    CHECK(s == txt);
+
+    // Values out of range of the parameter type are rejected.
+    sh = 100000;
+    CHECK_THROWS_AS(st.execute(true), soci_error&);
+
+    // Vectors can be used too.
+    sql << "delete from soci_test";
+    std::vector<int> ids;
+    std::vector<std::tm> times;
+    std::vector<indicator> inds;
+    for (int n = 0; n != 5; ++n)
+    {
+        ids.push_back(n);
+        t.tm_mday = n + 1;
+        times.push_back(t);
+        inds.push_back(n == 2 ? i_null : i_ok);
+    }
+    statement st2 = (sql.prepare <<
+        "insert into soci_test(i, ts) values(:i, :ts)",
+        use(ids), use(times, inds));
+    st2.execute(true);
+
+    sql << "select count(*) from soci_test where ts is null", into(len);
+    CHECK(len == 1);
+    sql << "select extract(day from ts) from soci_test where i = 4", into(len);
+    CHECK(len == 5);
+
+    // The same named parameter can be used with different types.
+    std::tm t1 = std::tm(), t2 = std::tm();
+    statement st3 = (sql.prepare << "select :t::date, :t::time",
+        use(t, "t"), into(t1), into(t2));
+    st3.execute(true);
+    CHECK(t1.tm_mday == 5);
+    CHECK(t1.tm_hour == 0);
+    CHECK(t2.tm_hour == 22);
+}
+
+struct bulk_copy_table_creator : table_creator_base
+{
+    bulk_copy_table_creator(soci::session & sql)
+        : table_creator_base(sql)
+    {
+        sql << "create table soci_test(id integer primary key, s text,"
+               " d float8, tm timestamp)";
+    }
+};
+
+TEST_CASE("PostgreSQL bulk copy", "[postgresql][bulk][copy]")
+{
+    soci::session sql(backEnd, connectString + " bulkcopy=true");
+
+    bulk_copy_table_creator tableCreator(sql);
+
+    std::vector<int> ids;
+    std::vector<std::string> strs;
+    std::vector<indicator> inds;
+    std::vector<double> ds;
+    std::vector<std::tm> tms;
+    for (int i = 0; i != 1000; ++i)
+    {
+        ids.push_back(i);
+        strs.push_back(i % 2 ? "tab\there" : "back\\slash\nnew line");
+        inds.push_back(i % 10 == 0 ? i_null : i_ok);
+        ds.push_back(i + 0.25);
+
+        std::tm t = std::tm();
+        t.tm_year = 2000 - 1900;
+        t.tm_mon = 0;
+        t.tm_mday = 1 + i % 28;
+        tms.push_back(t);
+    }
+
+    statement st = (sql.prepare <<
+        "insert into soci_test(id, s, d, tm) values(:id, :s, :d, :tm)",
+        use(ids), use(strs, inds), use(ds), use(tms));
+    st.execute(true);
+    CHECK(st.get_affected_rows() == 1000);
+
+    int count;
+    sql << "select count(*) from soci_test", into(count);
+    CHECK(count == 1000);
+    sql << "select count(*) from soci_test where s is null", into(count);
+    CHECK(count == 100);
+
+    std::string s;
+    sql << "select s from soci_test where id = 1", into(s);
+    CHECK(s == "tab\there");
+    sql << "select s from soci_test where id = 2", into(s);
+    CHECK(s == "back\\slash\nnew line");
+
+    double d;
+    std::tm t;
+    sql << "select d, tm from soci_test where id = 30", into(d), into(t);
+    CHECK(d == 30.25);
+    CHECK(t.tm_mday == 3);
+
+    // COPY is atomic: a duplicate key prevents all the rows from being added.
+    for (std::size_t i = 0; i != ids.size(); ++i)
+    {
+        ids[i] += 999;
+    }
+    CHECK_THROWS_AS(
+        (sql << "insert into soci_test(id, s, d, tm) values(:id, :s, :d, :tm)",
+            use(ids), use(strs, inds), use(ds), use(tms)),
+        postgresql_soci_error&);
+    sql << "select count(*) from soci_test", into(count);
+    CHECK(count == 1000);
+
+    // Statements which can't be converted to COPY still work.
+    ids.resize(3);
+    ids[0] = 2000;
+    ids[1] = 2001;
+    ids[2] = 2002;
+    sql << "insert into soci_test(id, d) values(:id, 1.5)", use(ids);
+    sql << "select count(*) from soci_test where d = 1.5", into(count);
+    CHECK(count == 3);
+}
+
+#ifdef LIBPQ_HAS_PIPELINING
+
+struct pipeline_table_creator : table_creator_base
+{
+    pipeline_table_creator(soci::session & sql)
+        : table_creator_base(sql)
+    {
+        sql << "create table soci_test(id integer primary key, s text)";
+    }
+};
+
+TEST_CASE("PostgreSQL pipeline", "[postgresql][pipeline]")
+{
+    soci::session sql(backEnd, connectString + " pipeline=true");
+
+    pipeline_table_creator tableCreator(sql);
+
+    int count;
+
+    SECTION("Bulk operations")
+    {
+        // Use more rows than can be queued without waiting for the results.
+        std::vector<int> ids;
+        std::vector<std::string> strs;
+        for (int i = 0; i != 1000; ++i)
+        {
+            ids.push_back(i);
+            strs.push_back(i % 2 ? "odd" : "even");
+        }
+
+        statement st = (sql.prepare <<
+            "insert into soci_test(id, s) values(:id, :s)",
+            use(ids), use(strs));
+        st.execute(true);
+        CHECK(st.get_affected_rows() == 1000);
+
+        sql << "select count(*) from soci_test where s = 'odd'", into(count);
+        CHECK(count == 500);
+
+        // All the rows are inserted in the same implicit transaction, so
+        // none of them is if any of them fails.
+        ids.resize(2);
+        ids[0] = 1000;
+        strs.resize(2);
+        CHECK_THROWS_AS(
+            (sql << "insert into soci_test(id, s) values(:id, :s)",
+                use(ids), use(strs)),
+            postgresql_soci_error&);
+
+        sql << "select count(*) from soci_test", into(count);
+        CHECK(count == 1000);
+    }
+
+    SECTION("Explicit pipeline")
+    {
+        sql.begin_pipeline();
+
+        int id = 0;
+        std::string s;
+        statement st = (sql.prepare <<
+            "insert into soci_test(id, s) values(:id, :s)", use(id), use(s));
+        for (; id != 300; ++id)
+        {
+            s = id % 3 ? "x" : "y";
+            st.execute(true);
+        }
+
+        sql << "insert into soci_test(id, s) values(:id, 'z')", use(id);
+
+        // Executing a query with into elements waits for the queued ones.
+        sql << "select count(*) from soci_test", into(count);
+        CHECK(count == 301);
+
+        sql << "update soci_test set s = 'w' where s = 'y'";
+        sql << "delete from soci_test where s = 'z'";
+
+        CHECK(sql.end_pipeline() == 402);
+
+        sql << "select count(*) from soci_test where s = 'w'", into(count);
+        CHECK(count == 100);
+    }
+
+    SECTION("Pipelined statement")
+    {
+        int id = 0;
+        statement st = (sql.prepare <<
+            "insert into soci_test(id, s) values(:id, 'x')", use(id));
+        st.set_pipelined(true);
+        for (; id != 10; ++id)
+        {
+            st.execute(true);
+            CHECK(st.get_affected_rows() == -1);
+        }
+
+        CHECK(sql.sync_pipeline() == 10);
+
+        sql << "select count(*) from soci_test", into(count);
+        CHECK(count == 10);
+    }
+
+    SECTION("Error in explicit pipeline")
+    {
+        sql.begin_pipeline();
+
+        int id = 1;
+        sql << "insert into soci_test(id) values(:id)", use(id);
+        sql << "insert into soci_test(id) values(:id)", use(id);
+
+        CHECK_THROWS_AS(sql.end_pipeline(), postgresql_soci_error&);
+
+        // The pipeline can be used again after an error.
+        sql.begin_pipeline();
+        id = 2;
+        sql << "insert into soci_test(id) values(:id)", use(id);
+        CHECK(sql.end_pipeline() == 1);
+
+        sql << "select count(*) from soci_test", into(count);
+        CHECK(count == 1);
+    }
+}
+
+#endif // LIBPQ_HAS_PIPELINING
+
 // test for number of affected rows
 
 struct table_creator_for_test11 : table_creator_base
@@ -105,6 +105,91 @@ TEST_CASE("SQLite blob", "[sqlite][blob]")
     }
 }
 
+TEST_CASE("SQLite blob chunks", "[sqlite][blob]")
+{
+    soci::session sql(backEnd, connectString);
+
+    blob_table_creator tableCreator(sql);
+
+    char const chunk[] = "0123456789";
+    std::size_t const chunkLen = sizeof(chunk) - 1;
+    int const numChunks = 1000;
+
+    SECTION("appending in memory")
+    {
+        blob b(sql);
+        for (int i = 0; i != numChunks; ++i)
+        {
+            b.append(chunk, chunkLen);
+        }
+        CHECK(b.get_len() == numChunks * chunkLen);
+
+        // writing past the end fills the gap with zeroes
+        b.write(b.get_len() + 2, chunk, 1);
+        CHECK(b.get_len() == numChunks * chunkLen + 3);
+
+        sql << "insert into soci_test(id, img) values(1, ?)", use(b);
+
+        int len = 0;
+        sql << "select length(img) from soci_test where id = 1", into(len);
+        CHECK(len == static_cast<int>(numChunks * chunkLen + 3));
+
+        blob b2(sql);
+        sql << "select img from soci_test where id = 1", into(b2);
+        REQUIRE(b2.get_len() == numChunks * chunkLen + 3);
+
+        char buf[chunkLen];
+        b2.read((numChunks - 1) * chunkLen, buf, chunkLen);
+        CHECK(std::memcmp(buf, chunk, chunkLen) == 0);
+
+        b2.read(numChunks * chunkLen, buf, 3);
+        CHECK(buf[0] == '\0');
+        CHECK(buf[1] == '\0');
+        CHECK(buf[2] == '0');
+    }
+
+    SECTION("incremental I/O")
+    {
+        sql << "insert into soci_test(id, img) values(1, zeroblob("
+            << numChunks * chunkLen << "))";
+
+        long long rowid = 0;
+        sql << "select rowid from soci_test where id = 1", into(rowid);
+
+        blob b(sql);
+        sqlite3_blob_backend* const bbe
+            = static_cast<sqlite3_blob_backend*>(b.get_backend());
+        bbe->open("soci_test", "img", rowid);
+        CHECK(bbe->is_open());
+        CHECK(b.get_len() == numChunks * chunkLen);
+
+        for (int i = 0; i != numChunks; ++i)
+        {
+            b.write(i * chunkLen, chunk, chunkLen);
+        }
+
+        // the size of the value can't be changed using incremental I/O
+        CHECK_THROWS_AS(b.append(chunk, chunkLen), soci_error&);
+        CHECK_THROWS_AS(b.write(numChunks * chunkLen, chunk, 1), soci_error&);
+        CHECK_THROWS_AS(b.trim(0), soci_error&);
+
+        char buf[chunkLen];
+        b.read(17 * chunkLen, buf, chunkLen);
+        CHECK(std::memcmp(buf, chunk, chunkLen) == 0);
+
+        bbe->close();
+        CHECK(!bbe->is_open());
+
+        std::string s;
+        sql << "select substr(img, 1, 20) from soci_test where id = 1", into(s);
+        CHECK(s == "01234567890123456789");
+
+        CHECK_THROWS_AS(bbe->open("soci_test", "no_such_column", rowid),
+                        sqlite3_soci_error&);
+        CHECK(!bbe->is_open());
+    }
+}
+
 // This test was put in to fix a problem that occurs when there are both
 // into and use elements in the same query and one of them (into) binds
 // to a vector object.
@@ -237,6 +322,140 @@ TEST_CASE("SQLite vector long long", "[sqlite][vector][longlong]")
     CHECK(v2[4] == 1000000000000LL);
 }
 
+struct bulk_fetch_table_creator : table_creator_base
+{
+    bulk_fetch_table_creator(soci::session & sql)
+        : table_creator_base(sql)
+    {
+        sql << "create table soci_test(id integer, name varchar, d datetime,"
+               " b blob)";
+    }
+};
+
+TEST_CASE("SQLite bulk fetch of variable length values", "[sqlite][vector]")
+{
+    soci::session sql(backEnd, connectString);
+
+    bulk_fetch_table_creator tableCreator(sql);
+
+    for (int i = 0; i != 25; ++i)
+    {
+        std::ostringstream ss;
+        ss << "name " << i;
+        std::string const name = ss.str();
+        indicator ind = i % 5 ? i_ok : i_null;
+        sql << "insert into soci_test(id, name, d, b)"
+               " values(:id, :name, '2020-01-02 03:04:05', 'blob')",
+            use(i), use(name, ind);
+    }
+
+    std::vector<int> ids(10);
+    std::vector<std::string> names(10);
+    std::vector<indicator> inds(10);
+    std::vector<std::tm> dates(10);
+    std::vector<std::string> blobs(10);
+    std::vector<std::string> idStrs(10);
+
+    statement st = (sql.prepare <<
+        "select id, name, d, b, id from soci_test order by id",
+        into(ids), into(names, inds), into(dates), into(blobs), into(idStrs));
+    REQUIRE(st.execute(true));
+
+    int count = 0;
+    do
+    {
+        for (std::size_t i = 0; i != ids.size(); ++i, ++count)
+        {
+            CHECK(ids[i] == count);
+            if (count % 5)
+            {
+                std::ostringstream ss;
+                ss << "name " << count;
+                CHECK(inds[i] == i_ok);
+                CHECK(names[i] == ss.str());
+            }
+            else
+            {
+                CHECK(inds[i] == i_null);
+            }
+
+            CHECK(dates[i].tm_year == 120);
+            CHECK(dates[i].tm_sec == 5);
+            CHECK(blobs[i] == "blob");
+
+            std::ostringstream ss;
+            ss << count;
+            CHECK(idStrs[i] == ss.str());
+        }
+
+        // Use a smaller batch for the next fetch.
+        ids.resize(7);
+        names.resize(7);
+        inds.resize(7);
+        dates.resize(7);
+        blobs.resize(7);
+        idStrs.resize(7);
+    } while (st.fetch());
+
+    CHECK(count == 25);
+}
+
+TEST_CASE("SQLite bulk insert with varying sizes", "[sqlite][vector]")
+{
+    soci::session sql(backEnd, connectString);
+
+    bulk_fetch_table_creator tableCreator(sql);
+
+    std::vector<int> ids;
+    std::vector<std::string> names;
+    std::vector<std::tm> dates;
+
+    statement st = (sql.prepare <<
+        "insert into soci_test(id, name, d) values(:id, :name, :d)",
+        use(ids), use(names), use(dates));
+
+    // Grow and shrink the vectors between executions to check that the
+    // values of all the columns are preserved when the recordset is resized.
+    int const sizes[] = { 3, 10, 2 };
+    int id = 0;
+    for (std::size_t n = 0; n != sizeof(sizes)/sizeof(sizes[0]); ++n)
+    {
+        ids.clear();
+        names.clear();
+        dates.clear();
+        for (int i = 0; i != sizes[n]; ++i, ++id)
+        {
+            std::ostringstream ss;
+            ss << "name " << id;
+
+            std::tm t = std::tm();
+            t.tm_year = 100 + id;
+            t.tm_mday = 1;
+
+            ids.push_back(id);
+            names.push_back(ss.str());
+            dates.push_back(t);
+        }
+
+        st.execute(true);
+        CHECK(st.get_affected_rows() == sizes[n]);
+    }
+
+    rowset<row> rs = (sql.prepare << "select id, name, d from soci_test order by id");
+    int count = 0;
+    for (rowset<row>::const_iterator it = rs.begin(); it != rs.end(); ++it, ++count)
+    {
+        std::ostringstream ss;
+        ss << "name " << count;
+
+        CHECK(it->get<int>(0) == count);
+        CHECK(it->get<std::string>(1) == ss.str());
+        CHECK(it->get<std::tm>(2).tm_year == 100 + count);
+    }
+
+    CHECK(count == 15);
+}
+
 TEST_CASE("SQLite DDL wrappers", "[sqlite][ddl]")
 {
     soci::session sql(backEnd, connectString);
@@ -272,6 +491,51 @@ TEST_CASE("SQLite last insert id", "[sqlite][last-insert-id]")
     CHECK(id == 42);
 }
 
+TEST_CASE("SQLite dynamic row after schema change", "[sqlite][dynamic]")
+{
+    soci::session sql(backEnd, connectString);
+    sql.set_statement_cache_size(4);
+
+    sql << "create table soci_test(a integer)";
+    sql << "insert into soci_test(a) values(1)";
+
+    row r;
+    sql << "select * from soci_test", into(r);
+    CHECK(r.size() == 1);
+
+    {
+        row r3;
+        statement st = (sql.prepare << "select * from soci_test where a > 0",
+                        into(r3));
+        CHECK(st.execute(true));
+        CHECK(r3.size() == 1);
+
+        sql << "alter table soci_test add column b integer";
+
+        // the cached statement result columns are not the described ones any
+        // more, so executing it fails once, like PostgreSQL prepared statements
+        row r2;
+        CHECK_THROWS_WITH((sql << "select * from soci_test", into(r2)),
+            Catch::Contains("Result columns changed"));
+
+        // but they are described anew when it's executed the next time
+        sql << "select * from soci_test", into(r2);
+        REQUIRE(r2.size() == 2);
+        CHECK(r2.get_properties(1).get_name() == "b");
+        CHECK(r2.get_indicator(1) == i_null);
+        CHECK(r2.get<int>(0) == 1);
+
+        // the same is true for a statement executed again
+        CHECK_THROWS_AS(st.execute(true), soci_error&);
+        CHECK(st.execute(true));
+        REQUIRE(r3.size() == 2);
+        CHECK(r3.get_properties(1).get_name() == "b");
+        CHECK(r3.get<int>(0) == 1);
+    }
+
+    sql << "drop table soci_test";
+}
+
 // DDL Creation objects for common tests
 struct table_creator_one : public table_creator_base
 {